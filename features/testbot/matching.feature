@@ -196,6 +196,29 @@ Feature: Basic Map Matching
             | dcba  | hgfe        |
             | efgh  | abcd        |
 
+    Scenario: Testbot - Map matching transitions follow the network distance
+        Given a grid size of 100 meters
+        Given the node map
+            """
+            a b c d
+                  |
+            h g f e
+            """
+
+        # b and g are 200m apart, but the path between them takes a 600m detour.
+        # The transition stays below the maximal distance delta, so the trace is
+        # not split.
+        And the ways
+            | nodes | oneway |
+            | abcd  | no     |
+            | de    | no     |
+            | efgh  | no     |
+
+        When I match I should get
+            | trace | matchings |
+            | abgh  | abgh      |
+            | hgba  | hgba      |
+
     Scenario: Testbot - request duration annotations
         Given the query options
             | annotations | duration |
@@ -99,6 +99,10 @@ Feature: Multi level routing
             | a    | s  | abcda,dim,ijkl,glr,qrstq,qrstq | 140s |
             | a    | f  | abcda,dim,ijkl,glr,efghe,efghe | 140s |
 
+        When I request a travel time matrix I should get
+            |   | a | b  | d  | l   | p  | o   | t   | s   | f   |
+            | a | 0 | 20 | 20 | 100 | 80 | 100 | 140 | 140 | 140 |
+
 
     Scenario: Testbot - Multi level routing: route over internal cell edge hf
         Given the node map
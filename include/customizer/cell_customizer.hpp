@@ -7,7 +7,9 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <algorithm>
 #include <unordered_set>
+#include <vector>
 
 namespace osrm
 {
@@ -20,6 +22,7 @@ class CellCustomizer
     struct HeapData
     {
         bool from_clique;
+        EdgeWeight duration;
     };
 
   public:
@@ -41,30 +44,36 @@ class CellCustomizer
         {
             std::unordered_set<NodeID> destinations_set(destinations.begin(), destinations.end());
             heap.Clear();
-            heap.Insert(source, 0, {false});
+            heap.Insert(source, 0, {false, 0});
 
             // explore search space
             while (!heap.Empty() && !destinations_set.empty())
             {
                 const NodeID node = heap.DeleteMin();
                 const EdgeWeight weight = heap.GetKey(node);
+                const EdgeWeight duration = heap.GetData(node).duration;
 
                 if (level == 1)
-                    RelaxNode<true>(graph, cells, heap, level, node, weight);
+                    RelaxNode<true>(graph, cells, heap, level, node, weight, duration);
                 else
-                    RelaxNode<false>(graph, cells, heap, level, node, weight);
+                    RelaxNode<false>(graph, cells, heap, level, node, weight, duration);
 
                 destinations_set.erase(node);
             }
 
             // fill a map of destination nodes to placeholder pointers
-            auto destination_iter = destinations.begin();
-            for (auto &weight : cell.GetOutWeight(source))
+            auto weights = cell.GetOutWeight(source);
+            auto durations = cell.GetOutDuration(source);
+            auto weight_iter = weights.begin();
+            auto duration_iter = durations.begin();
+            for (auto destination : destinations)
             {
-                BOOST_ASSERT(destination_iter != destinations.end());
-                const auto destination = *destination_iter++;
-                weight =
-                    heap.WasInserted(destination) ? heap.GetKey(destination) : INVALID_EDGE_WEIGHT;
+                BOOST_ASSERT(weight_iter != weights.end());
+                BOOST_ASSERT(duration_iter != durations.end());
+                const auto inserted = heap.WasInserted(destination);
+                *weight_iter++ = inserted ? heap.GetKey(destination) : INVALID_EDGE_WEIGHT;
+                *duration_iter++ =
+                    inserted ? heap.GetData(destination).duration : MAXIMAL_EDGE_DURATION;
             }
         }
     }
@@ -87,6 +96,39 @@ class CellCustomizer
         }
     }
 
+    // Only customizes the cells that contain one of the updated nodes on some level.
+    // All other cells need to be customized already with the current weights.
+    template <typename GraphT>
+    void Customize(const GraphT &graph,
+                   partition::CellStorage &cells,
+                   const std::vector<NodeID> &updated_nodes)
+    {
+        Heap heap_exemplar(graph.GetNumberOfNodes());
+        HeapPtr heaps(heap_exemplar);
+
+        for (std::size_t level = 1; level < partition.GetNumberOfLevels(); ++level)
+        {
+            std::vector<CellID> updated_cells(updated_nodes.size());
+            std::transform(updated_nodes.begin(),
+                           updated_nodes.end(),
+                           updated_cells.begin(),
+                           [&](const NodeID node) { return partition.GetCell(level, node); });
+            std::sort(updated_cells.begin(), updated_cells.end());
+            updated_cells.erase(std::unique(updated_cells.begin(), updated_cells.end()),
+                                updated_cells.end());
+
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, updated_cells.size()),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  auto &heap = heaps.local();
+                                  for (auto index = range.begin(), end = range.end(); index != end;
+                                       ++index)
+                                  {
+                                      Customize(graph, heap, cells, level, updated_cells[index]);
+                                  }
+                              });
+        }
+    }
+
   private:
     template <bool first_level, typename GraphT>
     void RelaxNode(const GraphT &graph,
@@ -94,7 +136,8 @@ class CellCustomizer
                    Heap &heap,
                    LevelID level,
                    NodeID node,
-                   EdgeWeight weight) const
+                   EdgeWeight weight,
+                   EdgeWeight duration) const
     {
         BOOST_ASSERT(heap.WasInserted(node));
 
@@ -113,24 +156,27 @@ class CellCustomizer
                 auto subcell_id = partition.GetCell(level - 1, node);
                 auto subcell = cells.GetCell(level - 1, subcell_id);
                 auto subcell_destination = subcell.GetDestinationNodes().begin();
+                auto subcell_duration = subcell.GetOutDuration(node).begin();
                 for (auto subcell_weight : subcell.GetOutWeight(node))
                 {
                     if (subcell_weight != INVALID_EDGE_WEIGHT)
                     {
                         const NodeID to = *subcell_destination;
                         const EdgeWeight to_weight = subcell_weight + weight;
+                        const EdgeWeight to_duration = *subcell_duration + duration;
                         if (!heap.WasInserted(to))
                         {
-                            heap.Insert(to, to_weight, {true});
+                            heap.Insert(to, to_weight, {true, to_duration});
                         }
                         else if (to_weight < heap.GetKey(to))
                         {
                             heap.DecreaseKey(to, to_weight);
-                            heap.GetData(to).from_clique = true;
+                            heap.GetData(to) = {true, to_duration};
                         }
                     }
 
                     ++subcell_destination;
+                    ++subcell_duration;
                 }
             }
         }
@@ -145,14 +191,15 @@ class CellCustomizer
                  partition.GetCell(level - 1, node) != partition.GetCell(level - 1, to)))
             {
                 const EdgeWeight to_weight = data.weight + weight;
+                const EdgeWeight to_duration = data.duration + duration;
                 if (!heap.WasInserted(to))
                 {
-                    heap.Insert(to, to_weight, {false});
+                    heap.Insert(to, to_weight, {false, to_duration});
                 }
                 else if (to_weight < heap.GetKey(to))
                 {
                     heap.DecreaseKey(to, to_weight);
-                    heap.GetData(to).from_clique = false;
+                    heap.GetData(to) = {false, to_duration};
                 }
             }
         }
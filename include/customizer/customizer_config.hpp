@@ -15,7 +15,7 @@ namespace customizer
 
 struct CustomizationConfig
 {
-    CustomizationConfig() : requested_num_threads(0) {}
+    CustomizationConfig() : requested_num_threads(0), incremental(false) {}
 
     void UseDefaults()
     {
@@ -49,6 +49,8 @@ struct CustomizationConfig
     boost::filesystem::path mld_graph_path;
 
     unsigned requested_num_threads;
+    // re-customize only cells with updated edges compared to the last .mldgr file
+    bool incremental;
 
     updater::UpdaterConfig updater_config;
 };
@@ -93,12 +93,18 @@ template <> struct HasGetTileTurns<corech::Algorithm> final : std::true_type
 };
 
 // Algorithms supported by Multi-Level Dijkstra
+template <> struct HasAlternativePathSearch<mld::Algorithm> final : std::true_type
+{
+};
 template <> struct HasDirectShortestPathSearch<mld::Algorithm> final : std::true_type
 {
 };
 template <> struct HasShortestPathSearch<mld::Algorithm> final : std::true_type
 {
 };
+template <> struct HasManyToManySearch<mld::Algorithm> final : std::true_type
+{
+};
 template <> struct HasMapMatching<mld::Algorithm> final : std::true_type
 {
 };
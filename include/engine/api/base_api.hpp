@@ -7,9 +7,17 @@
 #include "engine/api/json_factory.hpp"
 #include "engine/hint.hpp"
 
+#include "engine/api/protobuf_tags.hpp"
+
+#include "util/json_writer.hpp"
+
 #include <boost/assert.hpp>
 #include <boost/range/algorithm/transform.hpp>
 
+#include <protozero/pbf_writer.hpp>
+
+#include <cstdint>
+
 #include <vector>
 
 namespace osrm
@@ -44,6 +52,39 @@ class BaseAPI
         return waypoints;
     }
 
+    void WriteWaypoints(util::json::Writer &writer,
+                        const std::vector<PhantomNodes> &segment_end_coordinates) const
+    {
+        BOOST_ASSERT(parameters.coordinates.size() > 0);
+        BOOST_ASSERT(parameters.coordinates.size() == segment_end_coordinates.size() + 1);
+
+        writer.StartArray();
+        WriteWaypoint(writer, segment_end_coordinates.front().source_phantom);
+        for (const auto &phantom_pair : segment_end_coordinates)
+        {
+            WriteWaypoint(writer, phantom_pair.target_phantom);
+        }
+        writer.EndArray();
+    }
+
+    void WriteWaypoints(protozero::pbf_writer &response,
+                        const std::uint32_t tag,
+                        const std::vector<PhantomNodes> &segment_end_coordinates) const
+    {
+        BOOST_ASSERT(parameters.coordinates.size() > 0);
+        BOOST_ASSERT(parameters.coordinates.size() == segment_end_coordinates.size() + 1);
+
+        {
+            protozero::pbf_writer waypoint(response, tag);
+            WriteWaypointMembers(waypoint, segment_end_coordinates.front().source_phantom);
+        }
+        for (const auto &phantom_pair : segment_end_coordinates)
+        {
+            protozero::pbf_writer waypoint(response, tag);
+            WriteWaypointMembers(waypoint, phantom_pair.target_phantom);
+        }
+    }
+
     // FIXME: gcc 4.9 does not like MakeWaypoints to be protected
     // protected:
     util::json::Object MakeWaypoint(const PhantomNode &phantom) const
@@ -61,6 +102,47 @@ class BaseAPI
         }
     }
 
+    // Streaming counterpart of MakeWaypoint, see json::makeWaypoint for the fields
+    void WriteWaypoint(util::json::Writer &writer, const PhantomNode &phantom) const
+    {
+        writer.StartObject();
+        WriteWaypointMembers(writer, phantom);
+        writer.EndObject();
+    }
+
+    // Writes the waypoint keys into an already started object so callers can extend it
+    void WriteWaypointMembers(util::json::Writer &writer, const PhantomNode &phantom) const
+    {
+        if (parameters.generate_hints)
+        {
+            writer.Key("hint");
+            writer.WriteString(Hint{phantom, facade.GetCheckSum()}.ToBase64());
+        }
+        writer.Key("name");
+        writer.WriteString(facade.GetNameForID(phantom.name_id).to_string());
+        writer.Key("location");
+        writer.StartArray();
+        writer.WriteNumber(static_cast<double>(util::toFloating(phantom.location.lon)));
+        writer.WriteNumber(static_cast<double>(util::toFloating(phantom.location.lat)));
+        writer.EndArray();
+    }
+
+    // Protobuf counterpart, see the Waypoint message in docs/osrm.proto
+    void WriteWaypointMembers(protozero::pbf_writer &waypoint, const PhantomNode &phantom) const
+    {
+        waypoint.add_sint32(protobuf::WAYPOINT_LONGITUDE_TAG,
+                            static_cast<std::int32_t>(phantom.location.lon));
+        waypoint.add_sint32(protobuf::WAYPOINT_LATITUDE_TAG,
+                            static_cast<std::int32_t>(phantom.location.lat));
+        waypoint.add_string(protobuf::WAYPOINT_NAME_TAG,
+                            facade.GetNameForID(phantom.name_id).to_string());
+        if (parameters.generate_hints)
+        {
+            waypoint.add_string(protobuf::WAYPOINT_HINT_TAG,
+                                Hint{phantom, facade.GetCheckSum()}.ToBase64());
+        }
+    }
+
     const datafacade::BaseDataFacade &facade;
     const BaseParameters &parameters;
 };
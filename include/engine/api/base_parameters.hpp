@@ -55,6 +55,7 @@ namespace api
  *              optional per coordinate
  *  - bearings: limits the search for segments in the road network to given bearing(s) in degree
  *              towards true north in clockwise direction, optional per coordinate
+ *  - format: encoding of the osrm-routed response, JSON or protobuf (see docs/osrm.proto)
  *
  * \see OSRM, Coordinate, Hint, Bearing, RouteParame, RouteParameters, TableParameters,
  *      NearestParameters, TripParameters, MatchParameters and TileParameters
@@ -66,9 +67,19 @@ struct BaseParameters
     std::vector<boost::optional<double>> radiuses;
     std::vector<boost::optional<Bearing>> bearings;
 
+    enum class OutputFormatType
+    {
+        JSON,
+        PROTOBUF
+    };
+
     // Adds hints to response which can be included in subsequent requests, see `hints` above.
     bool generate_hints = true;
 
+    // Only used by osrm-routed to pick the response encoding, the library is called with a
+    // json::Object or a std::string result depending on the wanted output instead.
+    OutputFormatType format = OutputFormatType::JSON;
+
     BaseParameters(const std::vector<util::Coordinate> coordinates_ = {},
                    const std::vector<boost::optional<Hint>> hints_ = {},
                    std::vector<boost::optional<double>> radiuses_ = {},
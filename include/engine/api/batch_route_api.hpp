@@ -0,0 +1,161 @@
+#ifndef ENGINE_API_BATCH_ROUTE_HPP
+#define ENGINE_API_BATCH_ROUTE_HPP
+
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/api/route_api.hpp"
+
+#include "engine/datafacade/datafacade_base.hpp"
+
+#include "engine/guidance/assemble_overview.hpp"
+#include "engine/guidance/assemble_route.hpp"
+
+#include "engine/internal_route_result.hpp"
+
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/optional.hpp>
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+
+class BatchRouteAPI final : public RouteAPI
+{
+  public:
+    // What is kept of a route, the geometry is only set if an overview was requested
+    struct RouteSummary
+    {
+        double duration;
+        double distance;
+        boost::optional<util::json::Value> geometry;
+    };
+    // One entry per origin/destination pair, empty if there is no route for the pair
+    using RouteSummaries = std::vector<boost::optional<RouteSummary>>;
+
+    BatchRouteAPI(const datafacade::BaseDataFacade &facade_,
+                  const BatchRouteParameters &parameters_)
+        : RouteAPI(facade_, parameters_)
+    {
+    }
+
+    RouteSummary MakeSummary(const InternalRouteResult &raw_route) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        std::tie(legs, leg_geometries) = AssembleLegs(raw_route.segment_end_coordinates,
+                                                      raw_route.unpacked_path_segments,
+                                                      raw_route.source_traversed_in_reverse,
+                                                      raw_route.target_traversed_in_reverse);
+
+        const auto route = guidance::assembleRoute(legs);
+        RouteSummary summary{route.duration, route.distance, boost::none};
+        if (parameters.overview != RouteParameters::OverviewType::False)
+        {
+            const auto use_simplification =
+                parameters.overview == RouteParameters::OverviewType::Simplified;
+            const auto overview = guidance::assembleOverview(leg_geometries, use_simplification);
+            summary.geometry = MakeGeometry(overview.begin(), overview.end());
+        }
+        return summary;
+    }
+
+    void MakeResponse(const RouteSummaries &summaries, util::json::Object &response) const
+    {
+        util::json::Array durations;
+        util::json::Array distances;
+        util::json::Array geometries;
+        durations.values.reserve(summaries.size());
+        distances.values.reserve(summaries.size());
+
+        const bool has_geometries = parameters.overview != RouteParameters::OverviewType::False;
+        if (has_geometries)
+        {
+            geometries.values.reserve(summaries.size());
+        }
+
+        for (const auto &summary : summaries)
+        {
+            if (!summary)
+            {
+                durations.values.push_back(util::json::Null());
+                distances.values.push_back(util::json::Null());
+                if (has_geometries)
+                    geometries.values.push_back(util::json::Null());
+                continue;
+            }
+
+            durations.values.push_back(util::json::Number(summary->duration));
+            distances.values.push_back(util::json::Number(summary->distance));
+            if (has_geometries)
+                geometries.values.push_back(*summary->geometry);
+        }
+
+        response.values["durations"] = std::move(durations);
+        response.values["distances"] = std::move(distances);
+        if (has_geometries)
+        {
+            response.values["geometries"] = std::move(geometries);
+        }
+        response.values["code"] = "Ok";
+    }
+
+    // Streams the same response as above
+    void MakeResponse(const RouteSummaries &summaries, util::json::Writer &writer) const
+    {
+        writer.StartObject();
+        writer.Key("code");
+        writer.WriteString("Ok");
+
+        writer.Key("durations");
+        writer.StartArray();
+        for (const auto &summary : summaries)
+        {
+            if (summary)
+                writer.WriteNumber(summary->duration);
+            else
+                writer.WriteNull();
+        }
+        writer.EndArray();
+
+        writer.Key("distances");
+        writer.StartArray();
+        for (const auto &summary : summaries)
+        {
+            if (summary)
+                writer.WriteNumber(summary->distance);
+            else
+                writer.WriteNull();
+        }
+        writer.EndArray();
+
+        if (parameters.overview != RouteParameters::OverviewType::False)
+        {
+            writer.Key("geometries");
+            writer.StartArray();
+            for (const auto &summary : summaries)
+            {
+                if (summary)
+                    writer.WriteValue(*summary->geometry);
+                else
+                    writer.WriteNull();
+            }
+            writer.EndArray();
+        }
+
+        writer.EndObject();
+    }
+};
+
+} // ns api
+} // ns engine
+} // ns osrm
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/match_parameters_tidy.hpp"
+#include "engine/api/protobuf_tags.hpp"
 #include "engine/api/route_api.hpp"
 
 #include "engine/datafacade/datafacade_base.hpp"
@@ -11,6 +12,12 @@
 #include "engine/map_matching/sub_matching.hpp"
 
 #include "util/integer_range.hpp"
+#include "util/json_writer.hpp"
+
+#include <protozero/pbf_writer.hpp>
+
+#include <limits>
+#include <vector>
 
 namespace osrm
 {
@@ -51,34 +58,97 @@ class MatchAPI final : public RouteAPI
         response.values["code"] = "Ok";
     }
 
-  protected:
-    // FIXME this logic is a little backwards. We should change the output format of the
-    // map_matching
-    // routing algorithm to be easier to consume here.
-    util::json::Array
-    MakeTracepoints(const std::vector<map_matching::SubMatching> &sub_matchings) const
+    // Streams the same response as above, only the route objects are still built as json::Object
+    void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      util::json::Writer &writer) const
     {
-        util::json::Array waypoints;
-        waypoints.values.reserve(parameters.coordinates.size());
+        BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
+        writer.StartObject();
+        writer.Key("code");
+        writer.WriteString("Ok");
+        writer.Key("tracepoints");
+        WriteTracepoints(writer, sub_matchings);
+        writer.Key("matchings");
+        writer.StartArray();
+        for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            auto route = MakeRoute(sub_routes[index].segment_end_coordinates,
+                                   sub_routes[index].unpacked_path_segments,
+                                   sub_routes[index].source_traversed_in_reverse,
+                                   sub_routes[index].target_traversed_in_reverse);
+            route.values["confidence"] = sub_matchings[index].confidence;
+            writer.WriteValue(route);
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
 
-        struct MatchingIndex
+    // Encodes the Response message of docs/osrm.proto, the tracepoints are the waypoints
+    void MakeResponse(const std::vector<map_matching::SubMatching> &sub_matchings,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      protozero::pbf_writer &response) const
+    {
+        BOOST_ASSERT(sub_matchings.size() == sub_routes.size());
+        response.add_string(protobuf::RESPONSE_CODE_TAG, "Ok");
+
+        for (const auto &matching_index : GetMatchingIndices(sub_matchings))
         {
-            MatchingIndex() = default;
-            MatchingIndex(unsigned sub_matching_index_, unsigned point_index_)
-                : sub_matching_index(sub_matching_index_), point_index(point_index_)
+            if (matching_index.NotMatched())
             {
+                // empty submessages are dropped by the writer, add it explicitly
+                response.add_message(protobuf::RESPONSE_WAYPOINTS_TAG, "", 0);
+                continue;
             }
+            const auto &phantom =
+                sub_matchings[matching_index.sub_matching_index].nodes[matching_index.point_index];
+            protozero::pbf_writer waypoint(response, protobuf::RESPONSE_WAYPOINTS_TAG);
+            BaseAPI::WriteWaypointMembers(waypoint, phantom);
+            waypoint.add_uint32(protobuf::WAYPOINT_ROUTE_INDEX_TAG,
+                                matching_index.sub_matching_index);
+            waypoint.add_uint32(protobuf::WAYPOINT_WAYPOINT_INDEX_TAG, matching_index.point_index);
+            waypoint.add_uint32(protobuf::WAYPOINT_ALTERNATIVES_COUNT_TAG,
+                                sub_matchings[matching_index.sub_matching_index]
+                                    .alternatives_count[matching_index.point_index]);
+        }
 
-            unsigned sub_matching_index = std::numeric_limits<unsigned>::max();
-            unsigned point_index = std::numeric_limits<unsigned>::max();
+        for (auto index : util::irange<std::size_t>(0UL, sub_matchings.size()))
+        {
+            protozero::pbf_writer route(response, protobuf::RESPONSE_ROUTES_TAG);
+            WriteRoute(route,
+                       sub_routes[index].segment_end_coordinates,
+                       sub_routes[index].unpacked_path_segments,
+                       sub_routes[index].source_traversed_in_reverse,
+                       sub_routes[index].target_traversed_in_reverse);
+            route.add_double(protobuf::ROUTE_CONFIDENCE_TAG, sub_matchings[index].confidence);
+        }
+    }
 
-            bool NotMatched()
-            {
-                return sub_matching_index == std::numeric_limits<unsigned>::max() &&
-                       point_index == std::numeric_limits<unsigned>::max();
-            }
-        };
+  protected:
+    struct MatchingIndex
+    {
+        MatchingIndex() = default;
+        MatchingIndex(unsigned sub_matching_index_, unsigned point_index_)
+            : sub_matching_index(sub_matching_index_), point_index(point_index_)
+        {
+        }
 
+        unsigned sub_matching_index = std::numeric_limits<unsigned>::max();
+        unsigned point_index = std::numeric_limits<unsigned>::max();
+
+        bool NotMatched() const
+        {
+            return sub_matching_index == std::numeric_limits<unsigned>::max() &&
+                   point_index == std::numeric_limits<unsigned>::max();
+        }
+    };
+
+    // FIXME this logic is a little backwards. We should change the output format of the
+    // map_matching
+    // routing algorithm to be easier to consume here.
+    std::vector<MatchingIndex>
+    GetMatchingIndices(const std::vector<map_matching::SubMatching> &sub_matchings) const
+    {
         std::vector<MatchingIndex> trace_idx_to_matching_idx(parameters.coordinates.size());
         for (auto sub_matching_index :
              util::irange(0u, static_cast<unsigned>(sub_matchings.size())))
@@ -93,14 +163,26 @@ class MatchAPI final : public RouteAPI
             }
         }
 
+        // removed coordinates are reported as unmatched
         for (auto trace_index : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
             if (tidy_result.can_be_removed[trace_index])
             {
-                waypoints.values.push_back(util::json::Null());
-                continue;
+                trace_idx_to_matching_idx[trace_index] = MatchingIndex{};
             }
-            auto matching_index = trace_idx_to_matching_idx[trace_index];
+        }
+
+        return trace_idx_to_matching_idx;
+    }
+
+    util::json::Array
+    MakeTracepoints(const std::vector<map_matching::SubMatching> &sub_matchings) const
+    {
+        util::json::Array waypoints;
+        waypoints.values.reserve(parameters.coordinates.size());
+
+        for (const auto &matching_index : GetMatchingIndices(sub_matchings))
+        {
             if (matching_index.NotMatched())
             {
                 waypoints.values.push_back(util::json::Null());
@@ -120,6 +202,33 @@ class MatchAPI final : public RouteAPI
         return waypoints;
     }
 
+    void WriteTracepoints(util::json::Writer &writer,
+                          const std::vector<map_matching::SubMatching> &sub_matchings) const
+    {
+        writer.StartArray();
+        for (const auto &matching_index : GetMatchingIndices(sub_matchings))
+        {
+            if (matching_index.NotMatched())
+            {
+                writer.WriteNull();
+                continue;
+            }
+            const auto &phantom =
+                sub_matchings[matching_index.sub_matching_index].nodes[matching_index.point_index];
+            writer.StartObject();
+            BaseAPI::WriteWaypointMembers(writer, phantom);
+            writer.Key("matchings_index");
+            writer.WriteNumber(matching_index.sub_matching_index);
+            writer.Key("waypoint_index");
+            writer.WriteNumber(matching_index.point_index);
+            writer.Key("alternatives_count");
+            writer.WriteNumber(sub_matchings[matching_index.sub_matching_index]
+                                   .alternatives_count[matching_index.point_index]);
+            writer.EndObject();
+        }
+        writer.EndArray();
+    }
+
     const MatchParameters &parameters;
     const tidy::Result &tidy_result;
 };
@@ -3,12 +3,15 @@
 
 #include "engine/api/base_api.hpp"
 #include "engine/api/nearest_parameters.hpp"
+#include "engine/api/protobuf_tags.hpp"
 
 #include "engine/api/json_factory.hpp"
 #include "engine/phantom_node.hpp"
 
 #include <boost/assert.hpp>
 
+#include <protozero/pbf_writer.hpp>
+
 #include <vector>
 
 namespace osrm
@@ -47,6 +50,22 @@ class NearestAPI final : public BaseAPI
         response.values["waypoints"] = std::move(waypoints);
     }
 
+    // Encodes the Response message of docs/osrm.proto
+    void MakeResponse(const std::vector<std::vector<PhantomNodeWithDistance>> &phantom_nodes,
+                      protozero::pbf_writer &response) const
+    {
+        BOOST_ASSERT(phantom_nodes.size() == 1);
+        BOOST_ASSERT(parameters.coordinates.size() == 1);
+
+        response.add_string(protobuf::RESPONSE_CODE_TAG, "Ok");
+        for (const auto &phantom_with_distance : phantom_nodes.front())
+        {
+            protozero::pbf_writer waypoint(response, protobuf::RESPONSE_WAYPOINTS_TAG);
+            WriteWaypointMembers(waypoint, phantom_with_distance.phantom_node);
+            waypoint.add_double(protobuf::WAYPOINT_DISTANCE_TAG, phantom_with_distance.distance);
+        }
+    }
+
     const NearestParameters &parameters;
 };
 
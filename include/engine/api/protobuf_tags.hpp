@@ -0,0 +1,63 @@
+#ifndef ENGINE_API_PROTOBUF_TAGS_HPP
+#define ENGINE_API_PROTOBUF_TAGS_HPP
+
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+namespace api
+{
+// Field numbers of the protobuf responses, keep in sync with docs/osrm.proto
+namespace protobuf
+{
+
+const constexpr std::uint32_t RESPONSE_CODE_TAG = 1;
+const constexpr std::uint32_t RESPONSE_MESSAGE_TAG = 2;
+const constexpr std::uint32_t RESPONSE_WAYPOINTS_TAG = 3;
+const constexpr std::uint32_t RESPONSE_ROUTES_TAG = 4;
+const constexpr std::uint32_t RESPONSE_SOURCES_TAG = 5;
+const constexpr std::uint32_t RESPONSE_DESTINATIONS_TAG = 6;
+const constexpr std::uint32_t RESPONSE_TABLE_TAG = 7;
+
+const constexpr std::uint32_t WAYPOINT_LONGITUDE_TAG = 1;
+const constexpr std::uint32_t WAYPOINT_LATITUDE_TAG = 2;
+const constexpr std::uint32_t WAYPOINT_NAME_TAG = 3;
+const constexpr std::uint32_t WAYPOINT_HINT_TAG = 4;
+const constexpr std::uint32_t WAYPOINT_DISTANCE_TAG = 5;
+const constexpr std::uint32_t WAYPOINT_ROUTE_INDEX_TAG = 6;
+const constexpr std::uint32_t WAYPOINT_WAYPOINT_INDEX_TAG = 7;
+const constexpr std::uint32_t WAYPOINT_ALTERNATIVES_COUNT_TAG = 8;
+
+const constexpr std::uint32_t ANNOTATION_DURATION_TAG = 1;
+const constexpr std::uint32_t ANNOTATION_DISTANCE_TAG = 2;
+const constexpr std::uint32_t ANNOTATION_WEIGHT_TAG = 3;
+const constexpr std::uint32_t ANNOTATION_SPEED_TAG = 4;
+const constexpr std::uint32_t ANNOTATION_DATASOURCES_TAG = 5;
+const constexpr std::uint32_t ANNOTATION_NODES_TAG = 6;
+
+const constexpr std::uint32_t LEG_DISTANCE_TAG = 1;
+const constexpr std::uint32_t LEG_DURATION_TAG = 2;
+const constexpr std::uint32_t LEG_WEIGHT_TAG = 3;
+const constexpr std::uint32_t LEG_SUMMARY_TAG = 4;
+const constexpr std::uint32_t LEG_ANNOTATION_TAG = 5;
+
+const constexpr std::uint32_t ROUTE_DISTANCE_TAG = 1;
+const constexpr std::uint32_t ROUTE_DURATION_TAG = 2;
+const constexpr std::uint32_t ROUTE_WEIGHT_TAG = 3;
+const constexpr std::uint32_t ROUTE_WEIGHT_NAME_TAG = 4;
+const constexpr std::uint32_t ROUTE_GEOMETRY_TAG = 5;
+const constexpr std::uint32_t ROUTE_LEGS_TAG = 6;
+const constexpr std::uint32_t ROUTE_CONFIDENCE_TAG = 7;
+
+const constexpr std::uint32_t TABLE_ROWS_TAG = 1;
+const constexpr std::uint32_t TABLE_COLUMNS_TAG = 2;
+const constexpr std::uint32_t TABLE_DURATIONS_TAG = 3;
+const constexpr std::uint32_t TABLE_DISTANCES_TAG = 4;
+}
+}
+}
+}
+
+#endif
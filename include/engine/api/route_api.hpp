@@ -3,6 +3,7 @@
 
 #include "engine/api/base_api.hpp"
 #include "engine/api/json_factory.hpp"
+#include "engine/api/protobuf_tags.hpp"
 #include "engine/api/route_parameters.hpp"
 
 #include "engine/datafacade/datafacade_base.hpp"
@@ -22,8 +23,15 @@
 #include "util/coordinate.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_util.hpp"
+#include "util/json_writer.hpp"
 
+#include <protozero/pbf_writer.hpp>
+
+#include <cmath>
+#include <cstdint>
 #include <iterator>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -64,6 +72,60 @@ class RouteAPI : public BaseAPI
         response.values["code"] = "Ok";
     }
 
+    // Streams the same response as above, only the route objects are still built as json::Object
+    void MakeResponse(const InternalRouteResult &raw_route, util::json::Writer &writer) const
+    {
+        writer.StartObject();
+        writer.Key("code");
+        writer.WriteString("Ok");
+        writer.Key("waypoints");
+        BaseAPI::WriteWaypoints(writer, raw_route.segment_end_coordinates);
+        writer.Key("routes");
+        writer.StartArray();
+        writer.WriteValue(MakeRoute(raw_route.segment_end_coordinates,
+                                    raw_route.unpacked_path_segments,
+                                    raw_route.source_traversed_in_reverse,
+                                    raw_route.target_traversed_in_reverse));
+        if (raw_route.has_alternative())
+        {
+            std::vector<std::vector<PathData>> wrapped_leg(1);
+            wrapped_leg.front() = raw_route.unpacked_alternative;
+            writer.WriteValue(MakeRoute(raw_route.segment_end_coordinates,
+                                        wrapped_leg,
+                                        raw_route.alt_source_traversed_in_reverse,
+                                        raw_route.alt_target_traversed_in_reverse));
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
+
+    // Encodes the Response message of docs/osrm.proto
+    void MakeResponse(const InternalRouteResult &raw_route, protozero::pbf_writer &response) const
+    {
+        response.add_string(protobuf::RESPONSE_CODE_TAG, "Ok");
+        BaseAPI::WriteWaypoints(
+            response, protobuf::RESPONSE_WAYPOINTS_TAG, raw_route.segment_end_coordinates);
+        {
+            protozero::pbf_writer route(response, protobuf::RESPONSE_ROUTES_TAG);
+            WriteRoute(route,
+                       raw_route.segment_end_coordinates,
+                       raw_route.unpacked_path_segments,
+                       raw_route.source_traversed_in_reverse,
+                       raw_route.target_traversed_in_reverse);
+        }
+        if (raw_route.has_alternative())
+        {
+            std::vector<std::vector<PathData>> wrapped_leg(1);
+            wrapped_leg.front() = raw_route.unpacked_alternative;
+            protozero::pbf_writer route(response, protobuf::RESPONSE_ROUTES_TAG);
+            WriteRoute(route,
+                       raw_route.segment_end_coordinates,
+                       wrapped_leg,
+                       raw_route.alt_source_traversed_in_reverse,
+                       raw_route.alt_target_traversed_in_reverse);
+        }
+    }
+
   protected:
     template <typename ForwardIter>
     util::json::Value MakeGeometry(ForwardIter begin, ForwardIter end) const
@@ -95,10 +157,12 @@ class RouteAPI : public BaseAPI
         return annotations_store;
     }
 
-    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
-                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
-                                 const std::vector<bool> &source_traversed_in_reverse,
-                                 const std::vector<bool> &target_traversed_in_reverse) const
+    // Assembles the legs and their geometries that the JSON and protobuf routes are built from
+    std::pair<std::vector<guidance::RouteLeg>, std::vector<guidance::LegGeometry>>
+    AssembleLegs(const std::vector<PhantomNodes> &segment_end_coordinates,
+                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                 const std::vector<bool> &source_traversed_in_reverse,
+                 const std::vector<bool> &target_traversed_in_reverse) const
     {
         std::vector<guidance::RouteLeg> legs;
         std::vector<guidance::LegGeometry> leg_geometries;
@@ -184,6 +248,33 @@ class RouteAPI : public BaseAPI
             legs.push_back(std::move(leg));
         }
 
+        return std::make_pair(std::move(legs), std::move(leg_geometries));
+    }
+
+    // To maintain support for uses of the old default constructors, we check
+    // if annotations property was set manually after default construction
+    RouteParameters::AnnotationsType GetRequestedAnnotations() const
+    {
+        if ((parameters.annotations == true) &&
+            (parameters.annotations_type == RouteParameters::AnnotationsType::None))
+        {
+            return RouteParameters::AnnotationsType::All;
+        }
+        return parameters.annotations_type;
+    }
+
+    util::json::Object MakeRoute(const std::vector<PhantomNodes> &segment_end_coordinates,
+                                 const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                                 const std::vector<bool> &source_traversed_in_reverse,
+                                 const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        std::tie(legs, leg_geometries) = AssembleLegs(segment_end_coordinates,
+                                                      unpacked_path_segments,
+                                                      source_traversed_in_reverse,
+                                                      target_traversed_in_reverse);
+
         auto route = guidance::assembleRoute(legs);
         boost::optional<util::json::Value> json_overview;
         if (parameters.overview != RouteParameters::OverviewType::False)
@@ -232,14 +323,7 @@ class RouteAPI : public BaseAPI
 
         std::vector<util::json::Object> annotations;
 
-        // To maintain support for uses of the old default constructors, we check
-        // if annotations property was set manually after default construction
-        auto requested_annotations = parameters.annotations_type;
-        if ((parameters.annotations == true) &&
-            (parameters.annotations_type == RouteParameters::AnnotationsType::None))
-        {
-            requested_annotations = RouteParameters::AnnotationsType::All;
-        }
+        const auto requested_annotations = GetRequestedAnnotations();
 
         if (requested_annotations != RouteParameters::AnnotationsType::None)
         {
@@ -311,6 +395,118 @@ class RouteAPI : public BaseAPI
         return result;
     }
 
+    // Encodes a Route message of docs/osrm.proto, steps are not part of the binary format
+    void WriteRoute(protozero::pbf_writer &route_writer,
+                    const std::vector<PhantomNodes> &segment_end_coordinates,
+                    const std::vector<std::vector<PathData>> &unpacked_path_segments,
+                    const std::vector<bool> &source_traversed_in_reverse,
+                    const std::vector<bool> &target_traversed_in_reverse) const
+    {
+        std::vector<guidance::RouteLeg> legs;
+        std::vector<guidance::LegGeometry> leg_geometries;
+        std::tie(legs, leg_geometries) = AssembleLegs(segment_end_coordinates,
+                                                      unpacked_path_segments,
+                                                      source_traversed_in_reverse,
+                                                      target_traversed_in_reverse);
+
+        const auto route = guidance::assembleRoute(legs);
+        route_writer.add_double(protobuf::ROUTE_DISTANCE_TAG, route.distance);
+        route_writer.add_double(protobuf::ROUTE_DURATION_TAG, route.duration);
+        route_writer.add_double(protobuf::ROUTE_WEIGHT_TAG, route.weight);
+        route_writer.add_string(protobuf::ROUTE_WEIGHT_NAME_TAG, facade.GetWeightName());
+
+        if (parameters.overview != RouteParameters::OverviewType::False)
+        {
+            const auto use_simplification =
+                parameters.overview == RouteParameters::OverviewType::Simplified;
+            const auto overview = guidance::assembleOverview(leg_geometries, use_simplification);
+
+            // delta encoded like the vector tile geometries, the first pair is absolute
+            protozero::packed_field_sint32 geometry(route_writer, protobuf::ROUTE_GEOMETRY_TAG);
+            std::int32_t previous_lon = 0;
+            std::int32_t previous_lat = 0;
+            for (const auto &coordinate : overview)
+            {
+                const auto lon = static_cast<std::int32_t>(coordinate.lon);
+                const auto lat = static_cast<std::int32_t>(coordinate.lat);
+                geometry.add_element(lon - previous_lon);
+                geometry.add_element(lat - previous_lat);
+                previous_lon = lon;
+                previous_lat = lat;
+            }
+        }
+
+        const auto requested_annotations = GetRequestedAnnotations();
+        for (const auto idx : util::irange<std::size_t>(0UL, legs.size()))
+        {
+            const auto &leg = legs[idx];
+            protozero::pbf_writer leg_writer(route_writer, protobuf::ROUTE_LEGS_TAG);
+            leg_writer.add_double(protobuf::LEG_DISTANCE_TAG, leg.distance);
+            leg_writer.add_double(protobuf::LEG_DURATION_TAG, leg.duration);
+            leg_writer.add_double(protobuf::LEG_WEIGHT_TAG, leg.weight);
+            leg_writer.add_string(protobuf::LEG_SUMMARY_TAG, leg.summary);
+
+            if (requested_annotations != RouteParameters::AnnotationsType::None)
+            {
+                protozero::pbf_writer annotation(leg_writer, protobuf::LEG_ANNOTATION_TAG);
+                WriteAnnotation(annotation, leg_geometries[idx], requested_annotations);
+            }
+        }
+    }
+
+    void WriteAnnotation(protozero::pbf_writer &annotation,
+                         const guidance::LegGeometry &leg_geometry,
+                         const RouteParameters::AnnotationsType requested_annotations) const
+    {
+        using Annotation = guidance::LegGeometry::Annotation;
+        const auto write_doubles = [&](const std::uint32_t tag, auto get) {
+            protozero::packed_field_double field(annotation, tag);
+            for (const Annotation &anno : leg_geometry.annotations)
+            {
+                field.add_element(get(anno));
+            }
+        };
+
+        if (requested_annotations & RouteParameters::AnnotationsType::Duration)
+        {
+            write_doubles(protobuf::ANNOTATION_DURATION_TAG,
+                          [](const Annotation &anno) { return anno.duration; });
+        }
+        if (requested_annotations & RouteParameters::AnnotationsType::Distance)
+        {
+            write_doubles(protobuf::ANNOTATION_DISTANCE_TAG,
+                          [](const Annotation &anno) { return anno.distance; });
+        }
+        if (requested_annotations & RouteParameters::AnnotationsType::Weight)
+        {
+            write_doubles(protobuf::ANNOTATION_WEIGHT_TAG,
+                          [](const Annotation &anno) { return anno.weight; });
+        }
+        if (requested_annotations & RouteParameters::AnnotationsType::Speed)
+        {
+            write_doubles(protobuf::ANNOTATION_SPEED_TAG, [](const Annotation &anno) {
+                return util::json::clamp_float(
+                    std::round(anno.distance / anno.duration * 10.) / 10.);
+            });
+        }
+        if (requested_annotations & RouteParameters::AnnotationsType::Datasources)
+        {
+            protozero::packed_field_uint32 field(annotation, protobuf::ANNOTATION_DATASOURCES_TAG);
+            for (const auto &anno : leg_geometry.annotations)
+            {
+                field.add_element(anno.datasource);
+            }
+        }
+        if (requested_annotations & RouteParameters::AnnotationsType::Nodes)
+        {
+            protozero::packed_field_uint64 field(annotation, protobuf::ANNOTATION_NODES_TAG);
+            for (const auto node_id : leg_geometry.osm_node_ids)
+            {
+                field.add_element(static_cast<std::uint64_t>(node_id));
+            }
+        }
+    }
+
     const RouteParameters &parameters;
 };
 
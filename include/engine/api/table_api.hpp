@@ -3,6 +3,7 @@
 
 #include "engine/api/base_api.hpp"
 #include "engine/api/json_factory.hpp"
+#include "engine/api/protobuf_tags.hpp"
 #include "engine/api/table_parameters.hpp"
 
 #include "engine/datafacade/datafacade_base.hpp"
@@ -16,9 +17,14 @@
 #include "engine/internal_route_result.hpp"
 
 #include "util/integer_range.hpp"
+#include "util/json_writer.hpp"
 
 #include <boost/range/algorithm/transform.hpp>
 
+#include <protozero/pbf_writer.hpp>
+
+#include <cmath>
+#include <cstdint>
 #include <iterator>
 
 namespace osrm
@@ -37,12 +43,12 @@ class TableAPI final : public BaseAPI
     }
 
     virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<EdgeDistance> &distances,
                               const std::vector<PhantomNode> &phantoms,
                               util::json::Object &response) const
     {
         auto number_of_sources = parameters.sources.size();
         auto number_of_destinations = parameters.destinations.size();
-        ;
 
         // symmetric case
         if (parameters.sources.empty())
@@ -65,11 +71,126 @@ class TableAPI final : public BaseAPI
             response.values["destinations"] = MakeWaypoints(phantoms, parameters.destinations);
         }
 
-        response.values["durations"] =
-            MakeTable(durations, number_of_sources, number_of_destinations);
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            response.values["durations"] =
+                MakeTable(durations, number_of_sources, number_of_destinations);
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            response.values["distances"] =
+                MakeDistanceTable(distances, number_of_sources, number_of_destinations);
+        }
+
         response.values["code"] = "Ok";
     }
 
+    // Streams the same response as above without building the intermediate json::Object
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<EdgeDistance> &distances,
+                              const std::vector<PhantomNode> &phantoms,
+                              util::json::Writer &writer) const
+    {
+        const auto number_of_sources =
+            parameters.sources.empty() ? phantoms.size() : parameters.sources.size();
+        const auto number_of_destinations =
+            parameters.destinations.empty() ? phantoms.size() : parameters.destinations.size();
+
+        // most table entries render to less than 8 bytes including the separator
+        const auto number_of_tables = (durations.empty() ? 0 : 1) + (distances.empty() ? 0 : 1);
+        writer.Reserve(number_of_tables * number_of_sources * number_of_destinations * 8);
+
+        writer.StartObject();
+        writer.Key("code");
+        writer.WriteString("Ok");
+
+        writer.Key("sources");
+        if (parameters.sources.empty())
+        {
+            WriteWaypoints(writer, phantoms);
+        }
+        else
+        {
+            WriteWaypoints(writer, phantoms, parameters.sources);
+        }
+
+        writer.Key("destinations");
+        if (parameters.destinations.empty())
+        {
+            WriteWaypoints(writer, phantoms);
+        }
+        else
+        {
+            WriteWaypoints(writer, phantoms, parameters.destinations);
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            writer.Key("durations");
+            WriteTable(writer, durations, number_of_sources, number_of_destinations);
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            writer.Key("distances");
+            WriteDistanceTable(writer, distances, number_of_sources, number_of_destinations);
+        }
+
+        writer.EndObject();
+    }
+
+    // Encodes the Response message of docs/osrm.proto, the matrices are copied as they are
+    virtual void MakeResponse(const std::vector<EdgeWeight> &durations,
+                              const std::vector<EdgeDistance> &distances,
+                              const std::vector<PhantomNode> &phantoms,
+                              protozero::pbf_writer &response) const
+    {
+        const auto number_of_sources =
+            parameters.sources.empty() ? phantoms.size() : parameters.sources.size();
+        const auto number_of_destinations =
+            parameters.destinations.empty() ? phantoms.size() : parameters.destinations.size();
+
+        response.add_string(protobuf::RESPONSE_CODE_TAG, "Ok");
+
+        if (parameters.sources.empty())
+        {
+            WriteWaypoints(response, protobuf::RESPONSE_SOURCES_TAG, phantoms);
+        }
+        else
+        {
+            WriteWaypoints(response, protobuf::RESPONSE_SOURCES_TAG, phantoms, parameters.sources);
+        }
+
+        if (parameters.destinations.empty())
+        {
+            WriteWaypoints(response, protobuf::RESPONSE_DESTINATIONS_TAG, phantoms);
+        }
+        else
+        {
+            WriteWaypoints(
+                response, protobuf::RESPONSE_DESTINATIONS_TAG, phantoms, parameters.destinations);
+        }
+
+        protozero::pbf_writer table(response, protobuf::RESPONSE_TABLE_TAG);
+        table.add_uint32(protobuf::TABLE_ROWS_TAG, number_of_sources);
+        table.add_uint32(protobuf::TABLE_COLUMNS_TAG, number_of_destinations);
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Duration)
+        {
+            BOOST_ASSERT(durations.size() == number_of_sources * number_of_destinations);
+            table.add_packed_sfixed32(
+                protobuf::TABLE_DURATIONS_TAG, durations.begin(), durations.end());
+        }
+
+        if (parameters.annotations & TableParameters::AnnotationsType::Distance)
+        {
+            BOOST_ASSERT(distances.size() == number_of_sources * number_of_destinations);
+            table.add_packed_float(
+                protobuf::TABLE_DISTANCES_TAG, distances.begin(), distances.end());
+        }
+    }
+
   protected:
     virtual util::json::Array MakeWaypoints(const std::vector<PhantomNode> &phantoms) const
     {
@@ -124,6 +245,136 @@ class TableAPI final : public BaseAPI
         return json_table;
     }
 
+    virtual util::json::Array MakeDistanceTable(const std::vector<EdgeDistance> &values,
+                                                std::size_t number_of_rows,
+                                                std::size_t number_of_columns) const
+    {
+        util::json::Array json_table;
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            util::json::Array json_row;
+            auto row_begin_iterator = values.begin() + (row * number_of_columns);
+            auto row_end_iterator = values.begin() + ((row + 1) * number_of_columns);
+            json_row.values.resize(number_of_columns);
+            std::transform(row_begin_iterator,
+                           row_end_iterator,
+                           json_row.values.begin(),
+                           [](const EdgeDistance distance) {
+                               if (distance == INVALID_EDGE_DISTANCE)
+                               {
+                                   return util::json::Value(util::json::Null());
+                               }
+                               // rounded to decimeters like the route distances
+                               return util::json::Value(
+                                   util::json::Number(std::round(distance * 10.) / 10.));
+                           });
+            json_table.values.push_back(std::move(json_row));
+        }
+        return json_table;
+    }
+
+    virtual void WriteWaypoints(util::json::Writer &writer,
+                                const std::vector<PhantomNode> &phantoms) const
+    {
+        BOOST_ASSERT(phantoms.size() == parameters.coordinates.size());
+        writer.StartArray();
+        for (const auto &phantom : phantoms)
+        {
+            BaseAPI::WriteWaypoint(writer, phantom);
+        }
+        writer.EndArray();
+    }
+
+    virtual void WriteWaypoints(util::json::Writer &writer,
+                                const std::vector<PhantomNode> &phantoms,
+                                const std::vector<std::size_t> &indices) const
+    {
+        writer.StartArray();
+        for (const auto idx : indices)
+        {
+            BOOST_ASSERT(idx < phantoms.size());
+            BaseAPI::WriteWaypoint(writer, phantoms[idx]);
+        }
+        writer.EndArray();
+    }
+
+    virtual void WriteWaypoints(protozero::pbf_writer &response,
+                                const std::uint32_t tag,
+                                const std::vector<PhantomNode> &phantoms) const
+    {
+        BOOST_ASSERT(phantoms.size() == parameters.coordinates.size());
+        for (const auto &phantom : phantoms)
+        {
+            protozero::pbf_writer waypoint(response, tag);
+            BaseAPI::WriteWaypointMembers(waypoint, phantom);
+        }
+    }
+
+    virtual void WriteWaypoints(protozero::pbf_writer &response,
+                                const std::uint32_t tag,
+                                const std::vector<PhantomNode> &phantoms,
+                                const std::vector<std::size_t> &indices) const
+    {
+        for (const auto idx : indices)
+        {
+            BOOST_ASSERT(idx < phantoms.size());
+            protozero::pbf_writer waypoint(response, tag);
+            BaseAPI::WriteWaypointMembers(waypoint, phantoms[idx]);
+        }
+    }
+
+    virtual void WriteTable(util::json::Writer &writer,
+                            const std::vector<EdgeWeight> &values,
+                            std::size_t number_of_rows,
+                            std::size_t number_of_columns) const
+    {
+        writer.StartArray();
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            writer.StartArray();
+            for (const auto column : util::irange<std::size_t>(0UL, number_of_columns))
+            {
+                const auto duration = values[row * number_of_columns + column];
+                if (duration == MAXIMAL_EDGE_DURATION)
+                {
+                    writer.WriteNull();
+                }
+                else
+                {
+                    writer.WriteNumber(duration / 10.);
+                }
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+    }
+
+    virtual void WriteDistanceTable(util::json::Writer &writer,
+                                    const std::vector<EdgeDistance> &values,
+                                    std::size_t number_of_rows,
+                                    std::size_t number_of_columns) const
+    {
+        writer.StartArray();
+        for (const auto row : util::irange<std::size_t>(0UL, number_of_rows))
+        {
+            writer.StartArray();
+            for (const auto column : util::irange<std::size_t>(0UL, number_of_columns))
+            {
+                const auto distance = values[row * number_of_columns + column];
+                if (distance == INVALID_EDGE_DISTANCE)
+                {
+                    writer.WriteNull();
+                }
+                else
+                {
+                    writer.WriteNumber(std::round(distance * 10.) / 10.);
+                }
+            }
+            writer.EndArray();
+        }
+        writer.EndArray();
+    }
+
     const TableParameters &parameters;
 };
 
@@ -1,6 +1,7 @@
 #ifndef ENGINE_API_TRIP_HPP
 #define ENGINE_API_TRIP_HPP
 
+#include "engine/api/protobuf_tags.hpp"
 #include "engine/api/route_api.hpp"
 #include "engine/api/trip_parameters.hpp"
 
@@ -10,6 +11,11 @@
 
 #include "util/integer_range.hpp"
 
+#include <protozero/pbf_writer.hpp>
+
+#include <limits>
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -47,33 +53,61 @@ class TripAPI final : public RouteAPI
         response.values["code"] = "Ok";
     }
 
-  protected:
-    // FIXME this logic is a little backwards. We should change the output format of the
-    // trip plugin routing algorithm to be easier to consume here.
-    util::json::Array MakeWaypoints(const std::vector<std::vector<NodeID>> &sub_trips,
-                                    const std::vector<PhantomNode> &phantoms) const
+    // Encodes the Response message of docs/osrm.proto, the trips are the routes
+    void MakeResponse(const std::vector<std::vector<NodeID>> &sub_trips,
+                      const std::vector<InternalRouteResult> &sub_routes,
+                      const std::vector<PhantomNode> &phantoms,
+                      protozero::pbf_writer &response) const
     {
-        util::json::Array waypoints;
-        waypoints.values.reserve(parameters.coordinates.size());
+        BOOST_ASSERT(sub_trips.size() == sub_routes.size());
+        response.add_string(protobuf::RESPONSE_CODE_TAG, "Ok");
 
-        struct TripIndex
+        const auto trip_indices = GetTripIndices(sub_trips);
+        for (auto input_index : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            TripIndex() = default;
-            TripIndex(unsigned sub_trip_index_, unsigned point_index_)
-                : sub_trip_index(sub_trip_index_), point_index(point_index_)
-            {
-            }
+            const auto &trip_index = trip_indices[input_index];
+            BOOST_ASSERT(!trip_index.NotUsed());
 
-            unsigned sub_trip_index = std::numeric_limits<unsigned>::max();
-            unsigned point_index = std::numeric_limits<unsigned>::max();
+            protozero::pbf_writer waypoint(response, protobuf::RESPONSE_WAYPOINTS_TAG);
+            BaseAPI::WriteWaypointMembers(waypoint, phantoms[input_index]);
+            waypoint.add_uint32(protobuf::WAYPOINT_ROUTE_INDEX_TAG, trip_index.sub_trip_index);
+            waypoint.add_uint32(protobuf::WAYPOINT_WAYPOINT_INDEX_TAG, trip_index.point_index);
+        }
 
-            bool NotUsed()
-            {
-                return sub_trip_index == std::numeric_limits<unsigned>::max() &&
-                       point_index == std::numeric_limits<unsigned>::max();
-            }
-        };
+        for (auto index : util::irange<std::size_t>(0UL, sub_trips.size()))
+        {
+            protozero::pbf_writer route(response, protobuf::RESPONSE_ROUTES_TAG);
+            WriteRoute(route,
+                       sub_routes[index].segment_end_coordinates,
+                       sub_routes[index].unpacked_path_segments,
+                       sub_routes[index].source_traversed_in_reverse,
+                       sub_routes[index].target_traversed_in_reverse);
+        }
+    }
+
+  protected:
+    struct TripIndex
+    {
+        TripIndex() = default;
+        TripIndex(unsigned sub_trip_index_, unsigned point_index_)
+            : sub_trip_index(sub_trip_index_), point_index(point_index_)
+        {
+        }
+
+        unsigned sub_trip_index = std::numeric_limits<unsigned>::max();
+        unsigned point_index = std::numeric_limits<unsigned>::max();
+
+        bool NotUsed() const
+        {
+            return sub_trip_index == std::numeric_limits<unsigned>::max() &&
+                   point_index == std::numeric_limits<unsigned>::max();
+        }
+    };
 
+    // FIXME this logic is a little backwards. We should change the output format of the
+    // trip plugin routing algorithm to be easier to consume here.
+    std::vector<TripIndex> GetTripIndices(const std::vector<std::vector<NodeID>> &sub_trips) const
+    {
         std::vector<TripIndex> input_idx_to_trip_idx(parameters.coordinates.size());
         for (auto sub_trip_index : util::irange<unsigned>(0u, sub_trips.size()))
         {
@@ -83,7 +117,16 @@ class TripAPI final : public RouteAPI
                     TripIndex{sub_trip_index, point_index};
             }
         }
+        return input_idx_to_trip_idx;
+    }
+
+    util::json::Array MakeWaypoints(const std::vector<std::vector<NodeID>> &sub_trips,
+                                    const std::vector<PhantomNode> &phantoms) const
+    {
+        util::json::Array waypoints;
+        waypoints.values.reserve(parameters.coordinates.size());
 
+        const auto input_idx_to_trip_idx = GetTripIndices(sub_trips);
         for (auto input_index : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
             auto trip_index = input_idx_to_trip_idx[input_index];
@@ -37,7 +37,8 @@ template <typename AlgorithmT> class DataWatchdog final
             boost::interprocess::scoped_lock<mutex_type> current_region_lock(barrier.get_mutex());
 
             facade = std::make_shared<const FacadeT>(
-                std::make_unique<datafacade::SharedMemoryAllocator>(barrier.data().region));
+                std::make_unique<datafacade::SharedMemoryAllocator>(
+                    barrier.data().region, barrier.data().updatable_region));
             timestamp = barrier.data().timestamp;
         }
 
@@ -68,11 +69,12 @@ template <typename AlgorithmT> class DataWatchdog final
             if (timestamp != barrier.data().timestamp)
             {
                 auto region = barrier.data().region;
+                auto updatable_region = barrier.data().updatable_region;
                 facade = std::make_shared<const FacadeT>(
-                    std::make_unique<datafacade::SharedMemoryAllocator>(region));
+                    std::make_unique<datafacade::SharedMemoryAllocator>(region, updatable_region));
                 timestamp = barrier.data().timestamp;
-                util::Log() << "updated facade to region " << region << " with timestamp "
-                            << timestamp;
+                util::Log() << "updated facade to region " << region << " and updatable region "
+                            << updatable_region << " with timestamp " << timestamp;
             }
         }
 
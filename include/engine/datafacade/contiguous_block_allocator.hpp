@@ -18,6 +18,11 @@ class ContiguousBlockAllocator
     // interface to give access to the datafacades
     virtual storage::DataLayout &GetLayout() = 0;
     virtual char *GetMemory() = 0;
+
+    // Blocks for which storage::isUpdatableBlock is true can be stored in a separate memory
+    // block with its own layout. By default all blocks are in the same memory block.
+    virtual storage::DataLayout &GetUpdatableLayout() { return GetLayout(); }
+    virtual char *GetUpdatableMemory() { return GetMemory(); }
 };
 
 } // namespace datafacade
@@ -90,9 +90,11 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CH> : public datafacade::Algor
         std::shared_ptr<ContiguousBlockAllocator> allocator_)
         : allocator(std::move(allocator_))
     {
-        InitializeInternalPointers(allocator->GetLayout(), allocator->GetMemory());
+        InitializeInternalPointers(allocator->GetUpdatableLayout(),
+                                   allocator->GetUpdatableMemory());
     }
 
+    // the CH graph is updatable
     void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
     {
         InitializeGraphPointer(data_layout, memory_block);
@@ -173,9 +175,11 @@ class ContiguousInternalMemoryAlgorithmDataFacade<CoreCH>
         std::shared_ptr<ContiguousBlockAllocator> allocator_)
         : allocator(std::move(allocator_))
     {
-        InitializeInternalPointers(allocator->GetLayout(), allocator->GetMemory());
+        InitializeInternalPointers(allocator->GetUpdatableLayout(),
+                                   allocator->GetUpdatableMemory());
     }
 
+    // the core markers are updatable
     void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
     {
         InitializeCoreInformationPointer(data_layout, memory_block);
@@ -424,7 +428,10 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             data_layout.num_entries[storage::DataLayout::TURN_DURATION_PENALTIES]);
     }
 
-    void InitializeGeometryPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeGeometryPointers(storage::DataLayout &data_layout,
+                                    char *memory_block,
+                                    storage::DataLayout &updatable_layout,
+                                    char *updatable_memory)
     {
         auto geometries_index_ptr =
             data_layout.GetBlockPtr<unsigned>(memory_block, storage::DataLayout::GEOMETRIES_INDEX);
@@ -437,34 +444,35 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             geometries_node_list_ptr,
             data_layout.num_entries[storage::DataLayout::GEOMETRIES_NODE_LIST]);
 
-        auto geometries_fwd_weight_list_ptr = data_layout.GetBlockPtr<EdgeWeight>(
-            memory_block, storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
+        auto geometries_fwd_weight_list_ptr = updatable_layout.GetBlockPtr<EdgeWeight>(
+            updatable_memory, storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
         util::vector_view<EdgeWeight> geometry_fwd_weight_list(
             geometries_fwd_weight_list_ptr,
-            data_layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]);
+            updatable_layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST]);
 
-        auto geometries_rev_weight_list_ptr = data_layout.GetBlockPtr<EdgeWeight>(
-            memory_block, storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
+        auto geometries_rev_weight_list_ptr = updatable_layout.GetBlockPtr<EdgeWeight>(
+            updatable_memory, storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST);
         util::vector_view<EdgeWeight> geometry_rev_weight_list(
             geometries_rev_weight_list_ptr,
-            data_layout.num_entries[storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
+            updatable_layout.num_entries[storage::DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
 
-        auto geometries_fwd_duration_list_ptr = data_layout.GetBlockPtr<EdgeWeight>(
-            memory_block, storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST);
+        auto geometries_fwd_duration_list_ptr = updatable_layout.GetBlockPtr<EdgeWeight>(
+            updatable_memory, storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST);
         util::vector_view<EdgeWeight> geometry_fwd_duration_list(
             geometries_fwd_duration_list_ptr,
-            data_layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST]);
+            updatable_layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_DURATION_LIST]);
 
-        auto geometries_rev_duration_list_ptr = data_layout.GetBlockPtr<EdgeWeight>(
-            memory_block, storage::DataLayout::GEOMETRIES_REV_DURATION_LIST);
+        auto geometries_rev_duration_list_ptr = updatable_layout.GetBlockPtr<EdgeWeight>(
+            updatable_memory, storage::DataLayout::GEOMETRIES_REV_DURATION_LIST);
         util::vector_view<EdgeWeight> geometry_rev_duration_list(
             geometries_rev_duration_list_ptr,
-            data_layout.num_entries[storage::DataLayout::GEOMETRIES_REV_DURATION_LIST]);
+            updatable_layout.num_entries[storage::DataLayout::GEOMETRIES_REV_DURATION_LIST]);
 
-        auto datasources_list_ptr = data_layout.GetBlockPtr<DatasourceID>(
-            memory_block, storage::DataLayout::DATASOURCES_LIST);
+        auto datasources_list_ptr = updatable_layout.GetBlockPtr<DatasourceID>(
+            updatable_memory, storage::DataLayout::DATASOURCES_LIST);
         util::vector_view<DatasourceID> datasources_list(
-            datasources_list_ptr, data_layout.num_entries[storage::DataLayout::DATASOURCES_LIST]);
+            datasources_list_ptr,
+            updatable_layout.num_entries[storage::DataLayout::DATASOURCES_LIST]);
 
         segment_data = extractor::SegmentDataView{std::move(geometry_begin_indices),
                                                   std::move(geometry_node_list),
@@ -474,8 +482,8 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
                                                   std::move(geometry_rev_duration_list),
                                                   std::move(datasources_list)};
 
-        m_datasources = data_layout.GetBlockPtr<extractor::Datasources>(
-            memory_block, storage::DataLayout::DATASOURCES_NAMES);
+        m_datasources = updatable_layout.GetBlockPtr<extractor::Datasources>(
+            updatable_memory, storage::DataLayout::DATASOURCES_NAMES);
     }
 
     void InitializeIntersectionClassPointers(storage::DataLayout &data_layout, char *memory_block)
@@ -511,12 +519,15 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         m_entry_class_table = std::move(entry_class_table);
     }
 
-    void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeInternalPointers(storage::DataLayout &data_layout,
+                                    char *memory_block,
+                                    storage::DataLayout &updatable_layout,
+                                    char *updatable_memory)
     {
-        InitializeChecksumPointer(data_layout, memory_block);
+        InitializeChecksumPointer(updatable_layout, updatable_memory);
         InitializeNodeAndEdgeInformationPointers(data_layout, memory_block);
-        InitializeTurnPenalties(data_layout, memory_block);
-        InitializeGeometryPointers(data_layout, memory_block);
+        InitializeTurnPenalties(updatable_layout, updatable_memory);
+        InitializeGeometryPointers(data_layout, memory_block, updatable_layout, updatable_memory);
         InitializeTimestampPointer(data_layout, memory_block);
         InitializeViaNodeListPointer(data_layout, memory_block);
         InitializeNamePointers(data_layout, memory_block);
@@ -532,7 +543,10 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     ContiguousInternalMemoryDataFacadeBase(std::shared_ptr<ContiguousBlockAllocator> allocator_)
         : allocator(std::move(allocator_))
     {
-        InitializeInternalPointers(allocator->GetLayout(), allocator->GetMemory());
+        InitializeInternalPointers(allocator->GetLayout(),
+                                   allocator->GetMemory(),
+                                   allocator->GetUpdatableLayout(),
+                                   allocator->GetUpdatableMemory());
     }
 
     // node and edge information access
@@ -906,13 +920,19 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
 
     QueryGraph query_graph;
 
-    void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeInternalPointers(storage::DataLayout &data_layout,
+                                    char *memory_block,
+                                    storage::DataLayout &updatable_layout,
+                                    char *updatable_memory)
     {
-        InitializeMLDDataPointers(data_layout, memory_block);
-        InitializeGraphPointer(data_layout, memory_block);
+        InitializeMLDDataPointers(data_layout, memory_block, updatable_layout, updatable_memory);
+        InitializeGraphPointer(updatable_layout, updatable_memory);
     }
 
-    void InitializeMLDDataPointers(storage::DataLayout &data_layout, char *memory_block)
+    void InitializeMLDDataPointers(storage::DataLayout &data_layout,
+                                   char *memory_block,
+                                   storage::DataLayout &updatable_layout,
+                                   char *updatable_memory)
     {
         if (data_layout.GetBlockSize(storage::DataLayout::MLD_PARTITION) > 0)
         {
@@ -939,13 +959,15 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
                 partition::MultiLevelPartitionView{level_data, partition, cell_to_children};
         }
 
-        if (data_layout.GetBlockSize(storage::DataLayout::MLD_CELL_WEIGHTS) > 0)
+        if (updatable_layout.GetBlockSize(storage::DataLayout::MLD_CELL_WEIGHTS) > 0)
         {
             BOOST_ASSERT(data_layout.GetBlockSize(storage::DataLayout::MLD_CELLS) > 0);
             BOOST_ASSERT(data_layout.GetBlockSize(storage::DataLayout::MLD_CELL_LEVEL_OFFSETS) > 0);
 
-            auto mld_cell_weights_ptr = data_layout.GetBlockPtr<EdgeWeight>(
-                memory_block, storage::DataLayout::MLD_CELL_WEIGHTS);
+            auto mld_cell_weights_ptr = updatable_layout.GetBlockPtr<EdgeWeight>(
+                updatable_memory, storage::DataLayout::MLD_CELL_WEIGHTS);
+            auto mld_cell_durations_ptr = updatable_layout.GetBlockPtr<EdgeWeight>(
+                updatable_memory, storage::DataLayout::MLD_CELL_DURATIONS);
             auto mld_source_boundary_ptr = data_layout.GetBlockPtr<NodeID>(
                 memory_block, storage::DataLayout::MLD_CELL_SOURCE_BOUNDARY);
             auto mld_destination_boundary_ptr = data_layout.GetBlockPtr<NodeID>(
@@ -956,7 +978,9 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
                 memory_block, storage::DataLayout::MLD_CELL_LEVEL_OFFSETS);
 
             auto weight_entries_count =
-                data_layout.GetBlockEntries(storage::DataLayout::MLD_CELL_WEIGHTS);
+                updatable_layout.GetBlockEntries(storage::DataLayout::MLD_CELL_WEIGHTS);
+            auto duration_entries_count =
+                updatable_layout.GetBlockEntries(storage::DataLayout::MLD_CELL_DURATIONS);
             auto source_boundary_entries_count =
                 data_layout.GetBlockEntries(storage::DataLayout::MLD_CELL_SOURCE_BOUNDARY);
             auto destination_boundary_entries_count =
@@ -966,6 +990,7 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
                 data_layout.GetBlockEntries(storage::DataLayout::MLD_CELL_LEVEL_OFFSETS);
 
             util::vector_view<EdgeWeight> weights(mld_cell_weights_ptr, weight_entries_count);
+            util::vector_view<EdgeWeight> durations(mld_cell_durations_ptr, duration_entries_count);
             util::vector_view<NodeID> source_boundary(mld_source_boundary_ptr,
                                                       source_boundary_entries_count);
             util::vector_view<NodeID> destination_boundary(mld_destination_boundary_ptr,
@@ -976,6 +1001,7 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
                                                            cell_level_offsets_entries_count);
 
             mld_cell_storage = partition::CellStorageView{std::move(weights),
+                                                          std::move(durations),
                                                           std::move(source_boundary),
                                                           std::move(destination_boundary),
                                                           std::move(cells),
@@ -1013,7 +1039,10 @@ template <> class ContiguousInternalMemoryAlgorithmDataFacade<MLD> : public Algo
         std::shared_ptr<ContiguousBlockAllocator> allocator_)
         : allocator(std::move(allocator_))
     {
-        InitializeInternalPointers(allocator->GetLayout(), allocator->GetMemory());
+        InitializeInternalPointers(allocator->GetLayout(),
+                                   allocator->GetMemory(),
+                                   allocator->GetUpdatableLayout(),
+                                   allocator->GetUpdatableMemory());
     }
 
     const partition::MultiLevelPartitionView &GetMultiLevelPartition() const override
@@ -0,0 +1,42 @@
+#ifndef OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
+#define OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
+
+#include "storage/shared_datatype.hpp"
+#include "storage/storage_config.hpp"
+#include "engine/datafacade/contiguous_block_allocator.hpp"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+/**
+ * This allocator maps the dataset image written by osrm-datastore --image read-only.
+ * The blocks are used in place, so there is nothing to load at startup and all
+ * processes mapping the same image share its pages in the page cache.
+ */
+class MMapMemoryAllocator : public ContiguousBlockAllocator
+{
+  public:
+    explicit MMapMemoryAllocator(const storage::StorageConfig &config);
+    ~MMapMemoryAllocator() override final;
+
+    // interface to give access to the datafacades
+    storage::DataLayout &GetLayout() override final;
+    char *GetMemory() override final;
+
+  private:
+    boost::iostreams::mapped_file_source mapped_image;
+    storage::DataLayout layout;
+    char *memory;
+};
+
+} // namespace datafacade
+} // namespace engine
+} // namespace osrm
+
+#endif // OSRM_ENGINE_DATAFACADE_MMAP_MEMORY_ALLOCATOR_HPP_
@@ -3,6 +3,7 @@
 
 #include "storage/storage_config.hpp"
 #include "engine/datafacade/contiguous_block_allocator.hpp"
+#include "util/memory_placement.hpp"
 
 #include <memory>
 
@@ -19,11 +20,14 @@ namespace datafacade
  * shared memory.
  * This class holds a unique_ptr to the memory block, so it
  * is auto-freed upon destruction.
+ * The block is placed on the NUMA node of the constructing thread and
+ * can optionally be backed by huge pages, see util::AllocatePlacedMemory.
  */
 class ProcessMemoryAllocator : public ContiguousBlockAllocator
 {
   public:
-    explicit ProcessMemoryAllocator(const storage::StorageConfig &config);
+    explicit ProcessMemoryAllocator(const storage::StorageConfig &config,
+                                    const bool use_huge_pages = false);
     ~ProcessMemoryAllocator() override final;
 
     // interface to give access to the datafacades
@@ -31,7 +35,7 @@ class ProcessMemoryAllocator : public ContiguousBlockAllocator
     char *GetMemory() override final;
 
   private:
-    std::unique_ptr<char[]> internal_memory;
+    util::PlacedMemoryPtr internal_memory;
     std::unique_ptr<storage::DataLayout> internal_layout;
 };
 
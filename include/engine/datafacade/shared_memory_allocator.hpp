@@ -19,19 +19,24 @@ namespace datafacade
 * This allocator uses an IPC shared memory block as the data location.
 * Many SharedMemoryDataFacade objects can be created that point to the same shared
 * memory block.
+* After a metric update the updatable blocks are read from a second shared memory block.
 */
 class SharedMemoryAllocator : public ContiguousBlockAllocator
 {
   public:
-    explicit SharedMemoryAllocator(storage::SharedDataType data_region);
+    explicit SharedMemoryAllocator(storage::SharedDataType data_region,
+                                   storage::SharedDataType updatable_region = storage::REGION_NONE);
     ~SharedMemoryAllocator() override final;
 
     // interface to give access to the datafacades
     storage::DataLayout &GetLayout() override final;
     char *GetMemory() override final;
+    storage::DataLayout &GetUpdatableLayout() override final;
+    char *GetUpdatableMemory() override final;
 
   private:
     std::unique_ptr<storage::SharedMemory> m_large_memory;
+    std::unique_ptr<storage::SharedMemory> m_updatable_memory;
 };
 
 } // namespace datafacade
@@ -2,9 +2,21 @@
 #define OSRM_ENGINE_DATAFACADE_PROVIDER_HPP
 
 #include "engine/data_watchdog.hpp"
+#include "engine/datafacade/contiguous_block_allocator.hpp"
 #include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
 #include "engine/datafacade/process_memory_allocator.hpp"
 
+#include "util/log.hpp"
+#include "util/memory_placement.hpp"
+#include "util/timing_util.hpp"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace osrm
 {
 namespace engine
@@ -18,6 +30,9 @@ template <typename AlgorithmT> class DataFacadeProvider
     virtual ~DataFacadeProvider() = default;
 
     virtual std::shared_ptr<const FacadeT> Get() const = 0;
+
+    // Starts loading a new dataset, returns false if the provider can not reload
+    virtual bool Reload() { return false; }
 };
 
 template <typename AlgorithmT> class ImmutableProvider final : public DataFacadeProvider<AlgorithmT>
@@ -26,8 +41,12 @@ template <typename AlgorithmT> class ImmutableProvider final : public DataFacade
 
   public:
     ImmutableProvider(const storage::StorageConfig &config)
-        : immutable_data_facade(std::make_shared<FacadeT>(
-              std::make_shared<datafacade::ProcessMemoryAllocator>(config)))
+        : ImmutableProvider(std::make_shared<datafacade::ProcessMemoryAllocator>(config))
+    {
+    }
+
+    ImmutableProvider(std::shared_ptr<datafacade::ContiguousBlockAllocator> allocator)
+        : immutable_data_facade(std::make_shared<FacadeT>(std::move(allocator)))
     {
     }
 
@@ -37,6 +56,143 @@ template <typename AlgorithmT> class ImmutableProvider final : public DataFacade
     std::shared_ptr<const FacadeT> immutable_data_facade;
 };
 
+// Holds the dataset in process memory like ImmutableProvider, but Reload replaces it at runtime.
+// The new dataset is loaded on a background thread and swapped in atomically: requests that
+// already hold the previous facade finish on the old data, which is freed with the last reference.
+template <typename AlgorithmT> class ReloadingProvider final : public DataFacadeProvider<AlgorithmT>
+{
+    using FacadeT = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
+    using AllocatorPtr = std::shared_ptr<datafacade::ContiguousBlockAllocator>;
+
+  public:
+    ReloadingProvider(std::function<AllocatorPtr()> make_allocator_)
+        : make_allocator(std::move(make_allocator_)), reloading(false)
+    {
+        auto allocator = make_allocator();
+        dataset_size = allocator->GetLayout().GetSizeOfLayout();
+        facade = std::make_shared<const FacadeT>(std::move(allocator));
+    }
+
+    ~ReloadingProvider()
+    {
+        if (loader.joinable())
+            loader.join();
+    }
+
+    std::shared_ptr<const FacadeT> Get() const override final { return std::atomic_load(&facade); }
+
+    bool Reload() override final
+    {
+        bool expected = false;
+        if (!reloading.compare_exchange_strong(expected, true))
+        {
+            util::Log(logWARNING) << "Dataset reload already in progress";
+            return false;
+        }
+
+        if (loader.joinable())
+            loader.join();
+        loader = std::thread(&ReloadingProvider::Load, this);
+        return true;
+    }
+
+  private:
+    void Load()
+    {
+        try
+        {
+            TIMER_START(reload);
+            auto allocator = make_allocator();
+            const auto new_dataset_size = allocator->GetLayout().GetSizeOfLayout();
+            std::shared_ptr<const FacadeT> new_facade =
+                std::make_shared<const FacadeT>(std::move(allocator));
+            std::atomic_store(&facade, std::move(new_facade));
+            TIMER_STOP(reload);
+
+            // both datasets are resident until the last request on the old one finished
+            util::Log() << "Reloaded dataset in " << TIMER_MSEC(reload)
+                        << "ms, peak dataset memory " << (dataset_size + new_dataset_size)
+                        << " bytes (" << dataset_size << " old + " << new_dataset_size << " new)";
+            dataset_size = new_dataset_size;
+        }
+        catch (const std::exception &e)
+        {
+            util::Log(logERROR) << "Reloading the dataset failed, keeping the current one: "
+                                << e.what();
+        }
+
+        reloading = false;
+    }
+
+    std::function<AllocatorPtr()> make_allocator;
+    std::shared_ptr<const FacadeT> facade;
+    std::size_t dataset_size;
+    std::thread loader;
+    std::atomic<bool> reloading;
+};
+
+// Keeps one reloadable copy of the dataset per NUMA node. Every copy is allocated and loaded by a
+// thread bound to its node, so first touch places its pages there, and queries read the copy of
+// the node their thread currently runs on.
+template <typename AlgorithmT>
+class NumaReplicatedProvider final : public DataFacadeProvider<AlgorithmT>
+{
+    using FacadeT = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
+    using AllocatorPtr = std::shared_ptr<datafacade::ContiguousBlockAllocator>;
+
+  public:
+    NumaReplicatedProvider(std::function<AllocatorPtr()> make_allocator)
+    {
+        const auto number_of_nodes = util::numa::GetNumberOfNodes();
+        util::Log() << "Loading " << number_of_nodes << " NUMA replicas of the dataset";
+
+        for (unsigned node = 0; node < number_of_nodes; ++node)
+        {
+            replicas.push_back(std::make_unique<ReloadingProvider<AlgorithmT>>(
+                [make_allocator, node] { return MakeOnNode(make_allocator, node); }));
+        }
+    }
+
+    std::shared_ptr<const FacadeT> Get() const override final
+    {
+        return replicas[util::numa::GetCurrentNode() % replicas.size()]->Get();
+    }
+
+    bool Reload() override final
+    {
+        bool started = false;
+        for (auto &replica : replicas)
+            started = replica->Reload() || started;
+        return started;
+    }
+
+  private:
+    static AllocatorPtr MakeOnNode(const std::function<AllocatorPtr()> &make_allocator,
+                                   const unsigned node)
+    {
+        AllocatorPtr allocator;
+        std::exception_ptr error;
+        std::thread([&] {
+            if (!util::numa::BindCurrentThreadToNode(node))
+                util::Log(logWARNING) << "Could not bind the loader to NUMA node " << node;
+            try
+            {
+                allocator = make_allocator();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }).join();
+
+        if (error)
+            std::rethrow_exception(error);
+        return allocator;
+    }
+
+    std::vector<std::unique_ptr<ReloadingProvider<AlgorithmT>>> replicas;
+};
+
 template <typename AlgorithmT> class WatchingProvider final : public DataFacadeProvider<AlgorithmT>
 {
     using FacadeT = datafacade::ContiguousInternalMemoryDataFacade<AlgorithmT>;
@@ -1,6 +1,7 @@
 #ifndef ENGINE_HPP
 #define ENGINE_HPP
 
+#include "engine/api/batch_route_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -9,9 +10,11 @@
 #include "engine/api/trip_parameters.hpp"
 #include "engine/data_watchdog.hpp"
 #include "engine/datafacade/contiguous_block_allocator.hpp"
+#include "engine/datafacade/mmap_memory_allocator.hpp"
 #include "engine/datafacade_provider.hpp"
 #include "engine/engine_config.hpp"
 #include "engine/engine_config.hpp"
+#include "engine/plugins/batch_route.hpp"
 #include "engine/plugins/match.hpp"
 #include "engine/plugins/nearest.hpp"
 #include "engine/plugins/table.hpp"
@@ -23,6 +26,9 @@
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <protozero/pbf_writer.hpp>
 
 #include <memory>
 #include <string>
@@ -38,27 +44,44 @@ class EngineInterface
     virtual ~EngineInterface() = default;
     virtual Status Route(const api::RouteParameters &parameters,
                          util::json::Object &result) const = 0;
+    virtual Status Route(const api::RouteParameters &parameters, std::string &result) const = 0;
+    virtual Status Route(const api::RouteParameters &parameters,
+                         util::json::Writer &result) const = 0;
     virtual Status Table(const api::TableParameters &parameters,
                          util::json::Object &result) const = 0;
+    virtual Status Table(const api::TableParameters &parameters, std::string &result) const = 0;
+    virtual Status Table(const api::TableParameters &parameters,
+                         util::json::Writer &result) const = 0;
     virtual Status Nearest(const api::NearestParameters &parameters,
                            util::json::Object &result) const = 0;
+    virtual Status Nearest(const api::NearestParameters &parameters, std::string &result) const = 0;
     virtual Status Trip(const api::TripParameters &parameters,
                         util::json::Object &result) const = 0;
+    virtual Status Trip(const api::TripParameters &parameters, std::string &result) const = 0;
     virtual Status Match(const api::MatchParameters &parameters,
                          util::json::Object &result) const = 0;
+    virtual Status Match(const api::MatchParameters &parameters, std::string &result) const = 0;
+    virtual Status Match(const api::MatchParameters &parameters,
+                         util::json::Writer &result) const = 0;
     virtual Status Tile(const api::TileParameters &parameters, std::string &result) const = 0;
+    virtual Status BatchRoute(const api::BatchRouteParameters &parameters,
+                              util::json::Object &result) const = 0;
+    virtual Status BatchRoute(const api::BatchRouteParameters &parameters,
+                              util::json::Writer &result) const = 0;
+    virtual bool Reload() = 0;
 };
 
 template <typename Algorithm> class Engine final : public EngineInterface
 {
   public:
     explicit Engine(const EngineConfig &config)
-        : route_plugin(config.max_locations_viaroute),       //
-          table_plugin(config.max_locations_distance_table), //
-          nearest_plugin(config.max_results_nearest),        //
-          trip_plugin(config.max_locations_trip),            //
-          match_plugin(config.max_locations_map_matching),   //
-          tile_plugin()                                      //
+        : route_plugin(config.max_locations_viaroute),                                 //
+          table_plugin(config.max_locations_distance_table, config.max_table_threads), //
+          nearest_plugin(config.max_results_nearest),                                  //
+          trip_plugin(config.max_locations_trip),                                      //
+          match_plugin(config.max_locations_map_matching),                             //
+          tile_plugin(),                                                               //
+          batch_route_plugin(config.max_routes_batch, config.max_batch_threads)        //
 
     {
         if (config.use_shared_memory)
@@ -67,11 +90,34 @@ template <typename Algorithm> class Engine final : public EngineInterface
                                 << routing_algorithms::name<Algorithm>();
             facade_provider = std::make_unique<WatchingProvider<Algorithm>>();
         }
+        else if (config.use_mmap)
+        {
+            util::Log(logDEBUG) << "Using mapped dataset image with algorithm "
+                                << routing_algorithms::name<Algorithm>();
+            const auto storage_config = config.storage_config;
+            facade_provider = std::make_unique<ReloadingProvider<Algorithm>>([storage_config] {
+                return std::make_shared<datafacade::MMapMemoryAllocator>(storage_config);
+            });
+        }
         else
         {
             util::Log(logDEBUG) << "Using internal memory with algorithm "
                                 << routing_algorithms::name<Algorithm>();
-            facade_provider = std::make_unique<ImmutableProvider<Algorithm>>(config.storage_config);
+            const auto storage_config = config.storage_config;
+            const auto use_huge_pages = config.use_huge_pages;
+            const auto make_allocator = [storage_config, use_huge_pages] {
+                return std::make_shared<datafacade::ProcessMemoryAllocator>(storage_config,
+                                                                            use_huge_pages);
+            };
+            if (config.use_numa_replicas)
+            {
+                facade_provider =
+                    std::make_unique<NumaReplicatedProvider<Algorithm>>(make_allocator);
+            }
+            else
+            {
+                facade_provider = std::make_unique<ReloadingProvider<Algorithm>>(make_allocator);
+            }
         }
     }
 
@@ -90,6 +136,22 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return route_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status Route(const api::RouteParameters &params, std::string &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        protozero::pbf_writer writer(result);
+        return route_plugin.HandleRequest(*facade, algorithms, params, writer);
+    }
+
+    Status Route(const api::RouteParameters &params,
+                 util::json::Writer &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return route_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
     Status Table(const api::TableParameters &params,
                  util::json::Object &result) const override final
     {
@@ -98,6 +160,22 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return table_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status Table(const api::TableParameters &params, std::string &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        protozero::pbf_writer writer(result);
+        return table_plugin.HandleRequest(*facade, algorithms, params, writer);
+    }
+
+    Status Table(const api::TableParameters &params,
+                 util::json::Writer &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return table_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
     Status Nearest(const api::NearestParameters &params,
                    util::json::Object &result) const override final
     {
@@ -106,6 +184,14 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return nearest_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status Nearest(const api::NearestParameters &params, std::string &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        protozero::pbf_writer writer(result);
+        return nearest_plugin.HandleRequest(*facade, algorithms, params, writer);
+    }
+
     Status Trip(const api::TripParameters &params, util::json::Object &result) const override final
     {
         auto facade = facade_provider->Get();
@@ -113,6 +199,14 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return trip_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status Trip(const api::TripParameters &params, std::string &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        protozero::pbf_writer writer(result);
+        return trip_plugin.HandleRequest(*facade, algorithms, params, writer);
+    }
+
     Status Match(const api::MatchParameters &params,
                  util::json::Object &result) const override final
     {
@@ -121,6 +215,22 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return match_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status Match(const api::MatchParameters &params, std::string &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        protozero::pbf_writer writer(result);
+        return match_plugin.HandleRequest(*facade, algorithms, params, writer);
+    }
+
+    Status Match(const api::MatchParameters &params,
+                 util::json::Writer &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return match_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
     Status Tile(const api::TileParameters &params, std::string &result) const override final
     {
         auto facade = facade_provider->Get();
@@ -128,6 +238,24 @@ template <typename Algorithm> class Engine final : public EngineInterface
         return tile_plugin.HandleRequest(*facade, algorithms, params, result);
     }
 
+    Status BatchRoute(const api::BatchRouteParameters &params,
+                      util::json::Object &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return batch_route_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
+    Status BatchRoute(const api::BatchRouteParameters &params,
+                      util::json::Writer &result) const override final
+    {
+        auto facade = facade_provider->Get();
+        auto algorithms = RoutingAlgorithms<Algorithm>{heaps, *facade};
+        return batch_route_plugin.HandleRequest(*facade, algorithms, params, result);
+    }
+
+    bool Reload() override final { return facade_provider->Reload(); }
+
     static bool CheckCompability(const EngineConfig &config);
 
   private:
@@ -140,6 +268,7 @@ template <typename Algorithm> class Engine final : public EngineInterface
     const plugins::TripPlugin trip_plugin;
     const plugins::MatchPlugin match_plugin;
     const plugins::TilePlugin tile_plugin;
+    const plugins::BatchRoutePlugin batch_route_plugin;
 };
 
 template <>
@@ -151,7 +280,11 @@ bool Engine<routing_algorithms::ch::Algorithm>::CheckCompability(const EngineCon
         using mutex_type = typename decltype(barrier)::mutex_type;
         boost::interprocess::scoped_lock<mutex_type> current_region_lock(barrier.get_mutex());
 
-        auto mem = storage::makeSharedMemory(barrier.data().region);
+        // the CH graph is in the updatable region after a metric update
+        const auto region = barrier.data().updatable_region != storage::REGION_NONE
+                                ? barrier.data().updatable_region
+                                : barrier.data().region;
+        auto mem = storage::makeSharedMemory(region);
         auto layout = reinterpret_cast<storage::DataLayout *>(mem->Ptr());
         return layout->GetBlockSize(storage::DataLayout::CH_GRAPH_NODE_LIST) > 4 &&
                layout->GetBlockSize(storage::DataLayout::CH_GRAPH_EDGE_LIST) > 4;
@@ -182,7 +315,10 @@ bool Engine<routing_algorithms::corech::Algorithm>::CheckCompability(const Engin
         using mutex_type = typename decltype(barrier)::mutex_type;
         boost::interprocess::scoped_lock<mutex_type> current_region_lock(barrier.get_mutex());
 
-        auto mem = storage::makeSharedMemory(barrier.data().region);
+        const auto region = barrier.data().updatable_region != storage::REGION_NONE
+                                ? barrier.data().updatable_region
+                                : barrier.data().region;
+        auto mem = storage::makeSharedMemory(region);
         auto layout = reinterpret_cast<storage::DataLayout *>(mem->Ptr());
         return layout->GetBlockSize(storage::DataLayout::CH_CORE_MARKER) > 4;
     }
@@ -52,8 +52,19 @@ namespace engine
  *  - Table
  *  - Match
  *  - Nearest
+ * and the maximum number of origin/destination pairs for the Batch Route service.
  *
- * In addition, shared memory can be used for datasets loaded with osrm-datastore.
+ * The number of threads used for a single table or batch route query is limited by
+ * max_table_threads and max_batch_threads, by default these queries run on the calling thread
+ * only.
+ *
+ * In addition, shared memory can be used for datasets loaded with osrm-datastore. Without
+ * shared memory use_mmap maps the dataset image written by osrm-datastore --image instead of
+ * loading all files into process memory.
+ *
+ * A dataset loaded into process memory can be backed by huge pages with use_huge_pages to reduce
+ * TLB misses on random accesses. With use_numa_replicas a copy of it is loaded on every NUMA
+ * node and each query reads the copy local to the CPU it runs on.
  *
  * You can chose between three algorithms:
  *  - Algorithm::CH
@@ -87,7 +98,13 @@ struct EngineConfig final
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     int max_results_nearest = -1;
+    int max_table_threads = 1;
+    int max_routes_batch = -1;
+    int max_batch_threads = 1;
     bool use_shared_memory = true;
+    bool use_mmap = false;
+    bool use_huge_pages = false;
+    bool use_numa_replicas = false;
     Algorithm algorithm = Algorithm::CH;
 };
 }
@@ -0,0 +1,40 @@
+#ifndef BATCH_ROUTE_HPP
+#define BATCH_ROUTE_HPP
+
+#include "engine/plugins/plugin_base.hpp"
+
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/datafacade/datafacade_base.hpp"
+#include "engine/routing_algorithms.hpp"
+#include "util/json_container.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+// Routes independent origin/destination pairs, spreading them over up to max_batch_threads
+// threads. Every thread searches with its own thread local heaps.
+class BatchRoutePlugin final : public BasePlugin
+{
+  public:
+    BatchRoutePlugin(const int max_routes_batch, const int max_batch_threads);
+
+    // Instantiated for util::json::Object and util::json::Writer
+    template <typename ResultT>
+    Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                         const RoutingAlgorithmsInterface &algorithms,
+                         const api::BatchRouteParameters &params,
+                         ResultT &result) const;
+
+  private:
+    const int max_routes_batch;
+    const int max_batch_threads;
+};
+}
+}
+}
+
+#endif // BATCH_ROUTE_HPP
@@ -32,10 +32,12 @@ class MatchPlugin : public BasePlugin
     {
     }
 
+    // Instantiated for util::json::Object, util::json::Writer and protozero::pbf_writer
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::MatchParameters &parameters,
-                         util::json::Object &json_result) const;
+                         ResultT &json_result) const;
 
   private:
     const int max_locations_map_matching;
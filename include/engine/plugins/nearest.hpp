@@ -19,10 +19,12 @@ class NearestPlugin final : public BasePlugin
   public:
     explicit NearestPlugin(const int max_results);
 
+    // Instantiated for util::json::Object and protozero::pbf_writer
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::NearestParameters &params,
-                         util::json::Object &result) const;
+                         ResultT &result) const;
 
   private:
     const int max_results;
@@ -2,6 +2,7 @@
 #define BASE_PLUGIN_HPP
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/protobuf_tags.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/status.hpp"
@@ -10,6 +11,9 @@
 #include "util/coordinate_calculation.hpp"
 #include "util/integer_range.hpp"
 #include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <protozero/pbf_writer.hpp>
 
 #include <algorithm>
 #include <iterator>
@@ -43,6 +47,28 @@ class BasePlugin
         return Status::Error;
     }
 
+    Status Error(const std::string &code,
+                 const std::string &message,
+                 util::json::Writer &writer) const
+    {
+        writer.StartObject();
+        writer.Key("code");
+        writer.WriteString(code);
+        writer.Key("message");
+        writer.WriteString(message);
+        writer.EndObject();
+        return Status::Error;
+    }
+
+    Status Error(const std::string &code,
+                 const std::string &message,
+                 protozero::pbf_writer &response) const
+    {
+        response.add_string(api::protobuf::RESPONSE_CODE_TAG, code);
+        response.add_string(api::protobuf::RESPONSE_MESSAGE_TAG, message);
+        return Status::Error;
+    }
+
     // Decides whether to use the phantom node from a big or small component if both are found.
     // Returns true if all phantom nodes are in the same component after snapping.
     std::vector<PhantomNode>
@@ -216,62 +242,57 @@ class BasePlugin
         return phantom_nodes;
     }
 
-    std::vector<PhantomNodePair> GetPhantomNodes(const datafacade::BaseDataFacade &facade,
-                                                 const api::BaseParameters &parameters) const
+    // Snaps the coordinate at index, the first phantom node is invalid if nothing was found
+    PhantomNodePair GetPhantomNodePair(const datafacade::BaseDataFacade &facade,
+                                       const api::BaseParameters &parameters,
+                                       const std::size_t index) const
     {
-        std::vector<PhantomNodePair> phantom_node_pairs(parameters.coordinates.size());
-
+        const auto &coordinate = parameters.coordinates[index];
         const bool use_hints = !parameters.hints.empty();
         const bool use_bearings = !parameters.bearings.empty();
         const bool use_radiuses = !parameters.radiuses.empty();
 
-        BOOST_ASSERT(parameters.IsValid());
-        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        if (use_hints && parameters.hints[index] &&
+            parameters.hints[index]->IsValid(coordinate, facade))
         {
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
-            {
-                phantom_node_pairs[i].first = parameters.hints[i]->phantom;
-                // we don't set the second one - it will be marked as invalid
-                continue;
-            }
+            // we don't set the second one - it will be marked as invalid
+            return PhantomNodePair{parameters.hints[index]->phantom, PhantomNode{}};
+        }
 
-            if (use_bearings && parameters.bearings[i])
-            {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i],
-                            *parameters.radiuses[i],
-                            parameters.bearings[i]->bearing,
-                            parameters.bearings[i]->range);
-                }
-                else
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i],
-                            parameters.bearings[i]->bearing,
-                            parameters.bearings[i]->range);
-                }
-            }
-            else
+        if (use_bearings && parameters.bearings[index])
+        {
+            if (use_radiuses && parameters.radiuses[index])
             {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i], *parameters.radiuses[i]);
-                }
-                else
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i]);
-                }
+                return facade.NearestPhantomNodeWithAlternativeFromBigComponent(
+                    coordinate,
+                    *parameters.radiuses[index],
+                    parameters.bearings[index]->bearing,
+                    parameters.bearings[index]->range);
             }
 
+            return facade.NearestPhantomNodeWithAlternativeFromBigComponent(
+                coordinate, parameters.bearings[index]->bearing, parameters.bearings[index]->range);
+        }
+
+        if (use_radiuses && parameters.radiuses[index])
+        {
+            return facade.NearestPhantomNodeWithAlternativeFromBigComponent(
+                coordinate, *parameters.radiuses[index]);
+        }
+
+        return facade.NearestPhantomNodeWithAlternativeFromBigComponent(coordinate);
+    }
+
+    std::vector<PhantomNodePair> GetPhantomNodes(const datafacade::BaseDataFacade &facade,
+                                                 const api::BaseParameters &parameters) const
+    {
+        std::vector<PhantomNodePair> phantom_node_pairs(parameters.coordinates.size());
+
+        BOOST_ASSERT(parameters.IsValid());
+        for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+        {
+            phantom_node_pairs[i] = GetPhantomNodePair(facade, parameters, i);
+
             // we didn't find a fitting node, return error
             if (!phantom_node_pairs[i].first.IsValid())
             {
@@ -280,8 +301,6 @@ class BasePlugin
                 phantom_node_pairs.pop_back();
                 break;
             }
-            BOOST_ASSERT(phantom_node_pairs[i].first.IsValid());
-            BOOST_ASSERT(phantom_node_pairs[i].second.IsValid());
         }
         return phantom_node_pairs;
     }
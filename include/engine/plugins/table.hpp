@@ -19,15 +19,18 @@ namespace plugins
 class TablePlugin final : public BasePlugin
 {
   public:
-    explicit TablePlugin(const int max_locations_distance_table);
+    TablePlugin(const int max_locations_distance_table, const int max_table_threads);
 
+    // Instantiated for util::json::Object, util::json::Writer and protozero::pbf_writer
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::TableParameters &params,
-                         util::json::Object &result) const;
+                         ResultT &result) const;
 
   private:
     const int max_locations_distance_table;
+    const int max_table_threads;
 };
 }
 }
@@ -38,10 +38,12 @@ class TripPlugin final : public BasePlugin
   public:
     explicit TripPlugin(const int max_locations_trip_) : max_locations_trip(max_locations_trip_) {}
 
+    // Instantiated for util::json::Object and protozero::pbf_writer
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::TripParameters &parameters,
-                         util::json::Object &json_result) const;
+                         ResultT &json_result) const;
 };
 }
 }
@@ -31,10 +31,12 @@ class ViaRoutePlugin final : public BasePlugin
   public:
     explicit ViaRoutePlugin(int max_locations_viaroute);
 
+    // Instantiated for util::json::Object, util::json::Writer and protozero::pbf_writer
+    template <typename ResultT>
     Status HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                          const RoutingAlgorithmsInterface &algorithms,
                          const api::RouteParameters &route_parameters,
-                         util::json::Object &json_result) const;
+                         ResultT &json_result) const;
 };
 }
 }
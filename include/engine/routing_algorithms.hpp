@@ -29,10 +29,12 @@ class RoutingAlgorithmsInterface
     virtual InternalRouteResult
     DirectShortestPathSearch(const PhantomNodes &phantom_node_pair) const = 0;
 
-    virtual std::vector<EdgeWeight>
+    virtual std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
     ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                      const std::vector<std::size_t> &source_indices,
-                     const std::vector<std::size_t> &target_indices) const = 0;
+                     const std::vector<std::size_t> &target_indices,
+                     const unsigned max_threads,
+                     const bool calculate_distance) const = 0;
 
     virtual routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
@@ -75,10 +77,12 @@ template <typename Algorithm> class RoutingAlgorithms final : public RoutingAlgo
     InternalRouteResult
     DirectShortestPathSearch(const PhantomNodes &phantom_nodes) const final override;
 
-    std::vector<EdgeWeight>
+    std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
     ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                      const std::vector<std::size_t> &source_indices,
-                     const std::vector<std::size_t> &target_indices) const final override;
+                     const std::vector<std::size_t> &target_indices,
+                     const unsigned max_threads,
+                     const bool calculate_distance) const final override;
 
     routing_algorithms::SubMatchingList
     MapMatching(const routing_algorithms::CandidateLists &candidates_list,
@@ -151,13 +155,20 @@ RoutingAlgorithms<Algorithm>::DirectShortestPathSearch(const PhantomNodes &phant
 }
 
 template <typename Algorithm>
-std::vector<EdgeWeight>
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
 RoutingAlgorithms<Algorithm>::ManyToManySearch(const std::vector<PhantomNode> &phantom_nodes,
                                                const std::vector<std::size_t> &source_indices,
-                                               const std::vector<std::size_t> &target_indices) const
+                                               const std::vector<std::size_t> &target_indices,
+                                               const unsigned max_threads,
+                                               const bool calculate_distance) const
 {
-    return routing_algorithms::ch::manyToManySearch(
-        heaps, facade, phantom_nodes, source_indices, target_indices);
+    return routing_algorithms::ch::manyToManySearch(heaps,
+                                                    facade,
+                                                    phantom_nodes,
+                                                    source_indices,
+                                                    target_indices,
+                                                    max_threads,
+                                                    calculate_distance);
 }
 
 template <typename Algorithm>
@@ -194,33 +205,46 @@ InternalRouteResult inline RoutingAlgorithms<
 }
 
 template <>
-inline std::vector<EdgeWeight>
+inline std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
 RoutingAlgorithms<routing_algorithms::corech::Algorithm>::ManyToManySearch(
     const std::vector<PhantomNode> &,
     const std::vector<std::size_t> &,
-    const std::vector<std::size_t> &) const
+    const std::vector<std::size_t> &,
+    const unsigned,
+    const bool) const
 {
     throw util::exception("ManyToManySearch is disabled due to performance reasons");
 }
 
-// MLD overrides for not implemented
+// MLD overrides
 template <>
-InternalRouteResult inline RoutingAlgorithms<
-    routing_algorithms::mld::Algorithm>::AlternativePathSearch(const PhantomNodes &) const
+inline InternalRouteResult
+RoutingAlgorithms<routing_algorithms::mld::Algorithm>::AlternativePathSearch(
+    const PhantomNodes &phantom_node_pair) const
 {
-    throw util::exception("AlternativePathSearch is not implemented");
+    return routing_algorithms::mld::alternativePathSearch(heaps, facade, phantom_node_pair);
 }
 
 template <>
-inline std::vector<EdgeWeight>
+inline std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
 RoutingAlgorithms<routing_algorithms::mld::Algorithm>::ManyToManySearch(
-    const std::vector<PhantomNode> &,
-    const std::vector<std::size_t> &,
-    const std::vector<std::size_t> &) const
+    const std::vector<PhantomNode> &phantom_nodes,
+    const std::vector<std::size_t> &source_indices,
+    const std::vector<std::size_t> &target_indices,
+    const unsigned max_threads,
+    const bool calculate_distance) const
 {
-    throw util::exception("ManyToManySearch is not implemented");
+    return routing_algorithms::mld::manyToManySearch(heaps,
+                                                     facade,
+                                                     phantom_nodes,
+                                                     source_indices,
+                                                     target_indices,
+                                                     max_threads,
+                                                     calculate_distance);
 }
 
+// MLD overrides for not implemented
+
 template <>
 inline std::vector<routing_algorithms::TurnData>
 RoutingAlgorithms<routing_algorithms::mld::Algorithm>::GetTileTurns(
@@ -22,6 +22,14 @@ alternativePathSearch(SearchEngineData<Algorithm> &search_engine_data,
                       const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
                       const PhantomNodes &phantom_node_pair);
 } // namespace ch
+
+namespace mld
+{
+InternalRouteResult
+alternativePathSearch(SearchEngineData<Algorithm> &search_engine_data,
+                      const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                      const PhantomNodes &phantom_node_pair);
+} // namespace mld
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -7,6 +7,7 @@
 
 #include "util/typedefs.hpp"
 
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -16,16 +17,44 @@ namespace engine
 namespace routing_algorithms
 {
 
+// The backward and forward searches run on up to max_threads threads of the tbb pool.
+// Returns the durations and, if calculate_distance is set, the distances of all entries.
+
 namespace ch
 {
-std::vector<EdgeWeight>
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
 manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                  const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
                  const std::vector<PhantomNode> &phantom_nodes,
                  const std::vector<std::size_t> &source_indices,
-                 const std::vector<std::size_t> &target_indices);
+                 const std::vector<std::size_t> &target_indices,
+                 const unsigned max_threads,
+                 const bool calculate_distance);
+
+// Network distances from all source to all target phantom nodes in row-major order, computed by
+// one bucket based search per phantom node. Like getNetworkDistance the paths are unpacked and
+// measured with getPathDistance. Entries without a path with a weight below weight_upper_bound
+// are std::numeric_limits<double>::max().
+std::vector<double>
+getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                    const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                    const std::vector<PhantomNode> &source_phantoms,
+                    const std::vector<PhantomNode> &target_phantoms,
+                    const EdgeWeight weight_upper_bound);
 } // namespace ch
 
+namespace mld
+{
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices,
+                 const unsigned max_threads,
+                 const bool calculate_distance);
+} // namespace mld
+
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -0,0 +1,51 @@
+#ifndef OSRM_ENGINE_ROUTING_ALGORITHMS_PARALLEL_SEARCHES_HPP
+#define OSRM_ENGINE_ROUTING_ALGORITHMS_PARALLEL_SEARCHES_HPP
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace osrm
+{
+namespace engine
+{
+namespace routing_algorithms
+{
+
+// Calls search(index) for every index in [0, number_of_searches) on up to max_threads threads.
+// Each search has to use the thread local heaps of the thread it is running on.
+template <typename SearchT>
+void runSearches(const std::size_t number_of_searches,
+                 const unsigned max_threads,
+                 const SearchT &search)
+{
+    if (max_threads <= 1 || number_of_searches <= 1)
+    {
+        for (std::size_t index = 0; index < number_of_searches; ++index)
+        {
+            search(index);
+        }
+        return;
+    }
+
+    // Limits the number of cores one request can occupy in the global tbb thread pool
+    tbb::task_arena arena(static_cast<int>(std::min<std::size_t>(max_threads, number_of_searches)));
+    arena.execute([&] {
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, number_of_searches),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                              {
+                                  search(index);
+                              }
+                          });
+    });
+}
+
+} // namespace routing_algorithms
+} // namespace engine
+} // namespace osrm
+
+#endif
@@ -84,6 +84,29 @@ void insertNodesInHeap(SearchEngineData<ch::Algorithm>::ManyToManyQueryHeap &hea
     }
 }
 
+template <bool DIRECTION>
+void insertNodesInHeap(SearchEngineData<mld::Algorithm>::ManyToManyQueryHeap &heap,
+                       const PhantomNode &phantom_node)
+{
+    BOOST_ASSERT(phantom_node.IsValid());
+
+    const auto weight_sign = DIRECTION == FORWARD_DIRECTION ? -1 : 1;
+    if (phantom_node.forward_segment_id.enabled)
+    {
+        heap.Insert(
+            phantom_node.forward_segment_id.id,
+            weight_sign * phantom_node.GetForwardWeightPlusOffset(),
+            {phantom_node.forward_segment_id.id, weight_sign * phantom_node.GetForwardDuration()});
+    }
+    if (phantom_node.reverse_segment_id.enabled)
+    {
+        heap.Insert(
+            phantom_node.reverse_segment_id.id,
+            weight_sign * phantom_node.GetReverseWeightPlusOffset(),
+            {phantom_node.reverse_segment_id.id, weight_sign * phantom_node.GetReverseDuration()});
+    }
+}
+
 template <typename Heap>
 void insertNodesInHeaps(Heap &forward_heap, Heap &reverse_heap, const PhantomNodes &nodes)
 {
@@ -179,6 +179,49 @@ void routingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm>
     }
 }
 
+// Packed path as edges {from node ID, to node ID, from clique arc}
+using PackedEdge = std::tuple<NodeID, NodeID, bool>;
+using PackedPath = std::vector<PackedEdge>;
+
+// Retrieves the packed path source -> middle -> target from the parents stored in the heaps
+inline PackedPath
+retrievePackedPathFromHeap(const SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                           const SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                           const NodeID middle)
+{
+    PackedPath packed_path;
+    NodeID current_node = middle, parent_node = forward_heap.GetData(middle).parent;
+    while (parent_node != current_node)
+    {
+        const auto &data = forward_heap.GetData(current_node);
+        packed_path.push_back(std::make_tuple(parent_node, current_node, data.from_clique_arc));
+        current_node = parent_node;
+        parent_node = forward_heap.GetData(parent_node).parent;
+    }
+    std::reverse(std::begin(packed_path), std::end(packed_path));
+
+    current_node = middle, parent_node = reverse_heap.GetData(middle).parent;
+    while (parent_node != current_node)
+    {
+        const auto &data = reverse_heap.GetData(current_node);
+        packed_path.push_back(std::make_tuple(current_node, parent_node, data.from_clique_arc));
+        current_node = parent_node;
+        parent_node = reverse_heap.GetData(parent_node).parent;
+    }
+
+    return packed_path;
+}
+
+template <typename... Args>
+std::vector<EdgeID>
+unpackPackedPath(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                 SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                 const PackedPath &packed_path,
+                 const bool force_loop_forward,
+                 const bool force_loop_reverse,
+                 Args... args);
+
 template <typename... Args>
 std::tuple<EdgeWeight, NodeID, NodeID, std::vector<EdgeID>>
 search(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
@@ -188,9 +231,6 @@ search(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
        const bool force_loop_reverse,
        Args... args)
 {
-
-    const auto &partition = facade.GetMultiLevelPartition();
-
     BOOST_ASSERT(!forward_heap.Empty() && forward_heap.MinKey() < INVALID_EDGE_WEIGHT);
     BOOST_ASSERT(!reverse_heap.Empty() && reverse_heap.MinKey() < INVALID_EDGE_WEIGHT);
 
@@ -237,30 +277,35 @@ search(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
             INVALID_EDGE_WEIGHT, SPECIAL_NODEID, SPECIAL_NODEID, std::vector<EdgeID>());
     }
 
-    // Get packed path as edges {from node ID, to node ID, edge ID}
-    std::vector<std::tuple<NodeID, NodeID, bool>> packed_path;
-    NodeID current_node = middle, parent_node = forward_heap.GetData(middle).parent;
-    while (parent_node != current_node)
-    {
-        const auto &data = forward_heap.GetData(current_node);
-        packed_path.push_back(std::make_tuple(parent_node, current_node, data.from_clique_arc));
-        current_node = parent_node;
-        parent_node = forward_heap.GetData(parent_node).parent;
-    }
-    std::reverse(std::begin(packed_path), std::end(packed_path));
-    const NodeID source_node = current_node;
+    const auto packed_path = retrievePackedPathFromHeap(forward_heap, reverse_heap, middle);
+    const NodeID source_node = packed_path.empty() ? middle : std::get<0>(packed_path.front());
+    const NodeID target_node = packed_path.empty() ? middle : std::get<1>(packed_path.back());
 
-    current_node = middle, parent_node = reverse_heap.GetData(middle).parent;
-    while (parent_node != current_node)
-    {
-        const auto &data = reverse_heap.GetData(current_node);
-        packed_path.push_back(std::make_tuple(current_node, parent_node, data.from_clique_arc));
-        current_node = parent_node;
-        parent_node = reverse_heap.GetData(parent_node).parent;
-    }
-    const NodeID target_node = current_node;
+    // Here heaps can be reused, the unpacking clears them
+    auto unpacked_path = unpackPackedPath(facade,
+                                          forward_heap,
+                                          reverse_heap,
+                                          packed_path,
+                                          force_loop_forward,
+                                          force_loop_reverse,
+                                          args...);
+
+    return std::make_tuple(weight, source_node, target_node, std::move(unpacked_path));
+}
+
+// Unpacks overlay edges of a packed path by restricted searches in the cells of the sub-levels
+template <typename... Args>
+std::vector<EdgeID>
+unpackPackedPath(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 SearchEngineData<Algorithm>::QueryHeap &forward_heap,
+                 SearchEngineData<Algorithm>::QueryHeap &reverse_heap,
+                 const PackedPath &packed_path,
+                 const bool force_loop_forward,
+                 const bool force_loop_reverse,
+                 Args... args)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
 
-    // Unpack path
     std::vector<EdgeID> unpacked_path;
     unpacked_path.reserve(packed_path.size());
     for (auto const &packed_edge : packed_path)
@@ -306,7 +351,7 @@ search(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
         }
     }
 
-    return std::make_tuple(weight, source_node, target_node, std::move(unpacked_path));
+    return unpacked_path;
 }
 
 // Alias to be compatible with the overload for CoreCH that needs 4 heaps for shortest path search
@@ -24,17 +24,22 @@ struct ManyToManyHeapData : HeapData
     ManyToManyHeapData(NodeID p, EdgeWeight duration) : HeapData(p), duration(duration) {}
 };
 
+// Query heaps index their nodes with a hash map by default. Builds with
+// -DENABLE_QUERY_HEAP_ARRAY=ON use an array with generation stamps for O(1) lookups instead,
+// which costs 6 bytes per graph node for every heap of every thread (see docs/routed.md).
+#ifdef OSRM_QUERY_HEAP_ARRAY
+using QueryHeapStorage = util::GenerationArrayStorage<NodeID, int>;
+#else
+using QueryHeapStorage = util::UnorderedMapStorage<NodeID, int>;
+#endif
+
 template <typename Algorithm> struct SearchEngineData
 {
-    using QueryHeap = util::
-        BinaryHeap<NodeID, NodeID, EdgeWeight, HeapData, util::UnorderedMapStorage<NodeID, int>>;
+    using QueryHeap = util::BinaryHeap<NodeID, NodeID, EdgeWeight, HeapData, QueryHeapStorage>;
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
 
-    using ManyToManyQueryHeap = util::BinaryHeap<NodeID,
-                                                 NodeID,
-                                                 EdgeWeight,
-                                                 ManyToManyHeapData,
-                                                 util::UnorderedMapStorage<NodeID, int>>;
+    using ManyToManyQueryHeap =
+        util::BinaryHeap<NodeID, NodeID, EdgeWeight, ManyToManyHeapData, QueryHeapStorage>;
 
     using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
 
@@ -63,24 +68,45 @@ struct MultiLayerDijkstraHeapData
     MultiLayerDijkstraHeapData(NodeID p, bool from) : parent(p), from_clique_arc(from) {}
 };
 
+struct ManyToManyMultiLayerDijkstraHeapData : MultiLayerDijkstraHeapData
+{
+    EdgeWeight duration;
+    ManyToManyMultiLayerDijkstraHeapData(NodeID p, EdgeWeight duration)
+        : MultiLayerDijkstraHeapData(p), duration(duration)
+    {
+    }
+    ManyToManyMultiLayerDijkstraHeapData(NodeID p, bool from, EdgeWeight duration)
+        : MultiLayerDijkstraHeapData(p, from), duration(duration)
+    {
+    }
+};
+
 template <> struct SearchEngineData<routing_algorithms::mld::Algorithm>
 {
-    using QueryHeap = util::BinaryHeap<NodeID,
-                                       NodeID,
-                                       EdgeWeight,
-                                       MultiLayerDijkstraHeapData,
-                                       util::UnorderedMapStorage<NodeID, int>>;
+    using QueryHeap =
+        util::BinaryHeap<NodeID, NodeID, EdgeWeight, MultiLayerDijkstraHeapData, QueryHeapStorage>;
 
     using SearchEngineHeapPtr = boost::thread_specific_ptr<QueryHeap>;
 
+    using ManyToManyQueryHeap = util::BinaryHeap<NodeID,
+                                                 NodeID,
+                                                 EdgeWeight,
+                                                 ManyToManyMultiLayerDijkstraHeapData,
+                                                 QueryHeapStorage>;
+
+    using ManyToManyHeapPtr = boost::thread_specific_ptr<ManyToManyQueryHeap>;
+
     static SearchEngineHeapPtr forward_heap_1;
     static SearchEngineHeapPtr reverse_heap_1;
     static SearchEngineHeapPtr forward_heap_2;
     static SearchEngineHeapPtr reverse_heap_2;
+    static ManyToManyHeapPtr many_to_many_heap;
 
     void InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes);
 
     void InitializeOrClearSecondThreadLocalStorage(unsigned number_of_nodes);
+
+    void InitializeOrClearManyToManyThreadLocalStorage(unsigned number_of_nodes);
 };
 }
 }
@@ -43,6 +43,9 @@ class CompressedEdgeContainer
                              const EdgeWeight weight,
                              const EdgeWeight duration);
 
+    // Stores the complete geometry of an edge that replaces a chain of segments at once
+    void AddCompressedEdge(const EdgeID edge_id, OnewayEdgeBucket geometry);
+
     void InitializeBothwayVector();
     unsigned ZipEdges(const unsigned f_edge_pos, const unsigned r_edge_pos);
 
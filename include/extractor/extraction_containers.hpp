@@ -10,9 +10,13 @@
 
 #include "storage/io.hpp"
 
+#include <boost/assert.hpp>
+
 #include <cstdint>
+#include <memory>
 #include <stxxl/vector>
 #include <unordered_map>
+#include <vector>
 
 namespace osrm
 {
@@ -20,56 +24,139 @@ namespace extractor
 {
 
 /**
- * Uses external memory containers from stxxl to store all the data that
- * is collected by the extractor callbacks.
+ * Vector that keeps its elements in RAM until they are moved into stxxl's external memory,
+ * because all the collected data would not fit into the memory budget.
+ */
+template <typename T> class ExtractionVector
+{
+  public:
+    using value_type = T;
+    using InternalVector = std::vector<T>;
+    using ExternalVector = stxxl::vector<T>;
+
+    void push_back(const T &value)
+    {
+        if (external)
+            external->push_back(value);
+        else
+            internal.push_back(value);
+    }
+
+    std::uint64_t size() const { return external ? external->size() : internal.size(); }
+    bool empty() const { return size() == 0; }
+
+    std::uint64_t GetSizeInBytes() const
+    {
+        return external ? external->size() * sizeof(T) : internal.capacity() * sizeof(T);
+    }
+
+    bool IsExternal() const { return static_cast<bool>(external); }
+
+    void MoveToExternalMemory()
+    {
+        BOOST_ASSERT(!external);
+        external = std::make_unique<ExternalVector>();
+        external->reserve(internal.size());
+        for (const auto &value : internal)
+            external->push_back(value);
+        InternalVector().swap(internal);
+    }
+
+    void flush()
+    {
+        if (external)
+            external->flush();
+    }
+
+    InternalVector &Internal()
+    {
+        BOOST_ASSERT(!external);
+        return internal;
+    }
+    const InternalVector &Internal() const
+    {
+        BOOST_ASSERT(!external);
+        return internal;
+    }
+
+    ExternalVector &External()
+    {
+        BOOST_ASSERT(external);
+        return *external;
+    }
+    const ExternalVector &External() const
+    {
+        BOOST_ASSERT(external);
+        return *external;
+    }
+
+  private:
+    InternalVector internal;
+    std::unique_ptr<ExternalVector> external;
+};
+
+/**
+ * Stores all the data that is collected by the extractor callbacks, in RAM as long as it fits
+ * into the memory budget and in external memory containers from stxxl otherwise.
  *
  * The data is the filtered, aggregated and finally written to disk.
  */
 class ExtractionContainers
 {
-#ifndef _MSC_VER
-    constexpr static unsigned stxxl_memory =
-        ((sizeof(std::size_t) == 4) ? std::numeric_limits<int>::max()
-                                    : std::numeric_limits<unsigned>::max());
-#else
-    const static unsigned stxxl_memory = ((sizeof(std::size_t) == 4) ? INT_MAX : UINT_MAX);
-#endif
     void FlushVectors();
-    void PrepareNodes();
-    void PrepareRestrictions();
-    void PrepareEdges(ScriptingEnvironment &scripting_environment);
+    std::uint64_t EstimateMemoryUsage() const;
+    void MoveToExternalMemory();
 
-    void WriteNodes(storage::io::FileWriter &file_out) const;
+    template <typename Storage> void PrepareNodes();
+    template <typename Storage> void PrepareRestrictions();
+    template <typename Storage> void PrepareEdges(ScriptingEnvironment &scripting_environment);
+
+    template <typename Storage> void WriteNodes(storage::io::FileWriter &file_out) const;
+    template <typename Storage>
     void WriteRestrictions(const std::string &restrictions_file_name) const;
-    void WriteEdges(storage::io::FileWriter &file_out) const;
-    void WriteCharData(const std::string &file_name);
+    template <typename Storage> void WriteEdges(storage::io::FileWriter &file_out) const;
+    template <typename Storage> void WriteCharData(const std::string &file_name);
+
+    template <typename Storage>
+    void PrepareAndWriteData(ScriptingEnvironment &scripting_environment,
+                             const std::string &output_file_name,
+                             const std::string &restrictions_file_name,
+                             const std::string &names_file_name);
 
   public:
-    using STXXLNodeIDVector = stxxl::vector<OSMNodeID>;
-    using STXXLNodeVector = stxxl::vector<ExternalMemoryNode>;
-    using STXXLEdgeVector = stxxl::vector<InternalExtractorEdge>;
-    using STXXLRestrictionsVector = stxxl::vector<InputRestrictionContainer>;
-    using STXXLWayIDStartEndVector = stxxl::vector<FirstAndLastSegmentOfWay>;
-    using STXXLNameCharData = stxxl::vector<unsigned char>;
-    using STXXLNameOffsets = stxxl::vector<unsigned>;
-
-    STXXLNodeIDVector used_node_id_list;
-    STXXLNodeVector all_nodes_list;
-    STXXLEdgeVector all_edges_list;
-    STXXLNameCharData name_char_data;
-    STXXLNameOffsets name_offsets;
+    using NodeIDVector = ExtractionVector<OSMNodeID>;
+    using NodeVector = ExtractionVector<ExternalMemoryNode>;
+    using EdgeVector = ExtractionVector<InternalExtractorEdge>;
+    using RestrictionsVector = ExtractionVector<InputRestrictionContainer>;
+    using WayIDStartEndVector = ExtractionVector<FirstAndLastSegmentOfWay>;
+    using NameCharData = ExtractionVector<unsigned char>;
+    using NameOffsets = ExtractionVector<unsigned>;
+
+    NodeIDVector used_node_id_list;
+    NodeVector all_nodes_list;
+    EdgeVector all_edges_list;
+    NameCharData name_char_data;
+    NameOffsets name_offsets;
     // an adjacency array containing all turn lane masks
-    STXXLRestrictionsVector restrictions_list;
-    STXXLWayIDStartEndVector way_start_end_id_list;
+    RestrictionsVector restrictions_list;
+    WayIDStartEndVector way_start_end_id_list;
     std::unordered_map<OSMNodeID, NodeID> external_to_internal_node_id_map;
     unsigned max_internal_node_id;
 
-    ExtractionContainers();
+    // With a memory budget of 0 bytes all data goes to external memory right away
+    explicit ExtractionContainers(std::uint64_t memory_budget = 0);
+
+    // Moves all data to external memory once it would need more RAM than the budget allows
+    void CheckMemoryBudget();
+    bool IsInMemory() const { return !all_edges_list.IsExternal(); }
 
     void PrepareData(ScriptingEnvironment &scripting_environment,
                      const std::string &output_file_name,
                      const std::string &restrictions_file_name,
                      const std::string &names_file_name);
+
+  private:
+    std::uint64_t memory_budget;
 };
 }
 }
@@ -40,7 +40,10 @@ namespace extractor
 
 struct ExtractorConfig
 {
-    ExtractorConfig() noexcept : requested_num_threads(0) {}
+    ExtractorConfig() noexcept
+        : requested_num_threads(0), memory_budget(0), use_parallel_compression(false)
+    {
+    }
     void UseDefaultOutputNames()
     {
         std::string basepath = input_path.string();
@@ -105,11 +108,14 @@ struct ExtractorConfig
 
     unsigned requested_num_threads;
     unsigned small_component_size;
+    // GiB of RAM the extracted data may use before it is moved to stxxl's external memory
+    unsigned memory_budget;
 
     bool generate_edge_lookup;
     std::string turn_penalties_index_path;
 
     bool use_metadata;
+    bool use_parallel_compression;
 };
 }
 }
@@ -27,7 +27,21 @@ class GraphCompressor
                   util::NodeBasedDynamicGraph &graph,
                   CompressedEdgeContainer &geometry_compressor);
 
+    // Compresses all chains of degree 2 nodes independently of each other in parallel and
+    // applies them to the graph in a fixed order, so the result does not depend on the number
+    // of threads. Chains that would end up parallel to an existing edge are shortened by a node
+    // instead of being compressed up to the first of them as Compress does.
+    void CompressParallel(const std::unordered_set<NodeID> &barrier_nodes,
+                          const std::unordered_set<NodeID> &traffic_lights,
+                          RestrictionMap &restriction_map,
+                          util::NodeBasedDynamicGraph &graph,
+                          CompressedEdgeContainer &geometry_compressor);
+
   private:
+    void AddUncompressedEdges(unsigned original_number_of_nodes,
+                              const util::NodeBasedDynamicGraph &graph,
+                              CompressedEdgeContainer &geometry_compressor) const;
+
     void PrintStatistics(unsigned original_number_of_nodes,
                          unsigned original_number_of_edges,
                          const util::NodeBasedDynamicGraph &graph) const;
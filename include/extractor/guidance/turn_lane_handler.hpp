@@ -68,18 +68,23 @@ class TurnLaneHandler
   public:
     typedef std::vector<TurnLaneData> LaneDataVector;
 
+    // Lane descriptions combined for sliproads that are not in lane_description_map are added to
+    // added_lane_descriptions, numbered after the ones in lane_description_map. The latter is
+    // only read, so several handlers can share it.
     TurnLaneHandler(const util::NodeBasedDynamicGraph &node_based_graph,
                     std::vector<std::uint32_t> &turn_lane_offsets,
                     std::vector<TurnLaneType::Mask> &turn_lane_masks,
-                    LaneDescriptionMap &lane_description_map,
+                    const LaneDescriptionMap &lane_description_map,
+                    LaneDescriptionMap &added_lane_descriptions,
                     const TurnAnalysis &turn_analysis,
                     util::guidance::LaneDataIdMap &id_map);
 
-    ~TurnLaneHandler();
-
     OSRM_ATTR_WARN_UNUSED
     Intersection assignTurnLanes(const NodeID at, const EdgeID via_edge, Intersection intersection);
 
+    std::size_t GetNumberOfHandledLanes() const { return count_handled; }
+    std::size_t GetNumberOfCalledLanes() const { return count_called; }
+
   private:
     mutable std::atomic<std::size_t> count_handled;
     mutable std::atomic<std::size_t> count_called;
@@ -88,7 +93,8 @@ class TurnLaneHandler
     const util::NodeBasedDynamicGraph &node_based_graph;
     std::vector<std::uint32_t> &turn_lane_offsets;
     std::vector<TurnLaneType::Mask> &turn_lane_masks;
-    LaneDescriptionMap &lane_description_map;
+    const LaneDescriptionMap &lane_description_map;
+    LaneDescriptionMap &added_lane_descriptions;
     const TurnAnalysis &turn_analysis;
     util::guidance::LaneDataIdMap &id_map;
 
@@ -0,0 +1,491 @@
+#ifndef PARALLEL_SCC_HPP
+#define PARALLEL_SCC_HPP
+
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace extractor
+{
+
+/**
+ * Computes the strongly connected components of a graph on all threads. Drop-in replacement for
+ * TarjanSCC for graphs that can be read concurrently and return integer ranges from
+ * GetAdjacentEdgeRange, e.g. util::StaticGraph.
+ *
+ * Nodes without incoming or outgoing edges are trimmed first, they are components of their own.
+ * Large sets of the remaining nodes are split with a forward and a backward search from a pivot:
+ * the nodes reached by both are a component, the nodes reached by only one or none of them form
+ * three independent sets that are split in parallel. Small sets, and sets that keep splitting off
+ * small components only, are finished with a sequential Tarjan restricted to the set.
+ *
+ * Components are numbered in the order of their smallest node id, so the result does not depend
+ * on the number of threads. It is the same partition TarjanSCC finds, only the ids differ.
+ */
+template <typename GraphT> class ParallelSCC
+{
+    // colors of nodes that belong to a component already, every other color is a node set
+    static constexpr std::uint32_t DONE_COLOR = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t INITIAL_COLOR = 0;
+    // frontiers of at least this size are expanded on all threads
+    static constexpr std::size_t PARALLEL_FRONTIER_SIZE = 1024;
+    // splitting a set that only yields small components this many times in a row gives up
+    static constexpr unsigned MAX_SMALL_SPLITS = 4;
+
+    using EdgeIterator =
+        decltype(std::declval<const GraphT &>().GetAdjacentEdgeRange(NodeID{}).begin());
+
+    struct TarjanFrame
+    {
+        NodeID node;
+        EdgeIterator current;
+        EdgeIterator end;
+    };
+
+    std::vector<unsigned> components_index;
+    std::vector<NodeID> component_size_vector;
+    const GraphT &m_graph;
+    const std::size_t minimal_split_size;
+    std::size_t size_one_counter;
+
+    // reverse adjacency array of m_graph
+    std::vector<EdgeID> reverse_offsets;
+    std::vector<NodeID> reverse_sources;
+
+    std::vector<std::atomic<std::uint32_t>> colors;
+    std::atomic<std::uint32_t> next_color;
+    // only used by the sequential Tarjan, every node is visited by at most one of them
+    std::vector<unsigned> tarjan_index;
+    std::vector<unsigned> tarjan_low_link;
+
+  public:
+    // sets of fewer than minimal_split_size nodes are not split but run through Tarjan
+    ParallelSCC(const GraphT &graph, const std::size_t minimal_split_size = 64 * 1024)
+        : components_index(graph.GetNumberOfNodes(), SPECIAL_NODEID), m_graph(graph),
+          minimal_split_size(std::max<std::size_t>(1, minimal_split_size)), size_one_counter(0)
+    {
+        BOOST_ASSERT(m_graph.GetNumberOfNodes() > 0);
+    }
+
+    void Run()
+    {
+        TIMER_START(SCC_RUN);
+        const NodeID max_node_id = m_graph.GetNumberOfNodes();
+
+        BuildReverseGraph();
+
+        colors = std::vector<std::atomic<std::uint32_t>>(max_node_id);
+        next_color = INITIAL_COLOR + 1;
+
+        const auto trimmed = Trim();
+        util::Log() << "Trimmed " << trimmed << " nodes without incoming or outgoing edges";
+
+        std::vector<NodeID> remaining;
+        remaining.reserve(max_node_id - trimmed);
+        for (const auto node : util::irange(0u, max_node_id))
+        {
+            if (colors[node].load(std::memory_order_relaxed) == INITIAL_COLOR)
+                remaining.push_back(node);
+        }
+
+        tarjan_index.resize(max_node_id, SPECIAL_NODEID);
+        tarjan_low_link.resize(max_node_id, SPECIAL_NODEID);
+
+        Split(remaining, INITIAL_COLOR, 0);
+
+        tarjan_index = std::vector<unsigned>();
+        tarjan_low_link = std::vector<unsigned>();
+        colors = std::vector<std::atomic<std::uint32_t>>();
+        reverse_offsets = std::vector<EdgeID>();
+        reverse_sources = std::vector<NodeID>();
+
+        NumberComponents();
+
+        TIMER_STOP(SCC_RUN);
+        util::Log() << "SCC run took: " << TIMER_MSEC(SCC_RUN) / 1000. << "s";
+
+        size_one_counter = std::count_if(component_size_vector.begin(),
+                                         component_size_vector.end(),
+                                         [](unsigned value) { return 1 == value; });
+    }
+
+    std::size_t GetNumberOfComponents() const { return component_size_vector.size(); }
+
+    std::size_t GetSizeOneCount() const { return size_one_counter; }
+
+    unsigned GetComponentSize(const unsigned component_id) const
+    {
+        return component_size_vector[component_id];
+    }
+
+    unsigned GetComponentID(const NodeID node) const { return components_index[node]; }
+
+  private:
+    std::uint32_t GetColor(const NodeID node) const
+    {
+        return colors[node].load(std::memory_order_relaxed);
+    }
+
+    bool Recolor(const NodeID node, std::uint32_t from, const std::uint32_t to)
+    {
+        return colors[node].compare_exchange_strong(from, to, std::memory_order_relaxed);
+    }
+
+    void BuildReverseGraph()
+    {
+        const NodeID max_node_id = m_graph.GetNumberOfNodes();
+        const tbb::blocked_range<NodeID> all_nodes(0, max_node_id);
+
+        std::vector<std::atomic<EdgeID>> positions(max_node_id);
+        tbb::parallel_for(all_nodes, [&](const tbb::blocked_range<NodeID> &range) {
+            for (auto node = range.begin(); node != range.end(); ++node)
+                for (const auto edge : m_graph.GetAdjacentEdgeRange(node))
+                    positions[m_graph.GetTarget(edge)].fetch_add(1, std::memory_order_relaxed);
+        });
+
+        reverse_offsets.resize(max_node_id + 1);
+        reverse_offsets[0] = 0;
+        for (const auto node : util::irange(0u, max_node_id))
+        {
+            const auto in_degree = positions[node].load(std::memory_order_relaxed);
+            reverse_offsets[node + 1] = reverse_offsets[node] + in_degree;
+            positions[node].store(reverse_offsets[node], std::memory_order_relaxed);
+        }
+
+        reverse_sources.resize(reverse_offsets.back());
+        tbb::parallel_for(all_nodes, [&](const tbb::blocked_range<NodeID> &range) {
+            for (auto node = range.begin(); node != range.end(); ++node)
+                for (const auto edge : m_graph.GetAdjacentEdgeRange(node))
+                {
+                    const auto target = m_graph.GetTarget(edge);
+                    const auto position =
+                        positions[target].fetch_add(1, std::memory_order_relaxed);
+                    reverse_sources[position] = node;
+                }
+        });
+    }
+
+    util::range<EdgeID> GetReverseEdgeRange(const NodeID node) const
+    {
+        return util::irange(reverse_offsets[node], reverse_offsets[node + 1]);
+    }
+
+    // Expands the frontier until it is empty, visit(node, next_frontier) adds the newly reached
+    // nodes. Large frontiers are expanded on all threads.
+    template <typename VisitorT>
+    static void ExpandFrontier(std::vector<NodeID> frontier, const VisitorT &visit)
+    {
+        std::vector<NodeID> next_frontier;
+        while (!frontier.empty())
+        {
+            if (frontier.size() < PARALLEL_FRONTIER_SIZE)
+            {
+                for (const auto node : frontier)
+                    visit(node, next_frontier);
+            }
+            else
+            {
+                tbb::enumerable_thread_specific<std::vector<NodeID>> local_frontiers;
+                tbb::parallel_for(tbb::blocked_range<std::size_t>(0, frontier.size()),
+                                  [&](const tbb::blocked_range<std::size_t> &range) {
+                                      auto &local_frontier = local_frontiers.local();
+                                      for (auto index = range.begin(); index != range.end();
+                                           ++index)
+                                          visit(frontier[index], local_frontier);
+                                  });
+                for (const auto &local_frontier : local_frontiers)
+                    next_frontier.insert(
+                        next_frontier.end(), local_frontier.begin(), local_frontier.end());
+            }
+            frontier.swap(next_frontier);
+            next_frontier.clear();
+        }
+    }
+
+    // Removes nodes that have no incoming or no outgoing edges from other remaining nodes, which
+    // cascades along dead ends and one-way chains. Returns the number of trimmed nodes.
+    std::size_t Trim()
+    {
+        const NodeID max_node_id = m_graph.GetNumberOfNodes();
+
+        std::vector<std::atomic<EdgeID>> in_degree(max_node_id);
+        std::vector<std::atomic<EdgeID>> out_degree(max_node_id);
+        tbb::enumerable_thread_specific<std::vector<NodeID>> local_dead_ends;
+        tbb::parallel_for(tbb::blocked_range<NodeID>(0, max_node_id),
+                          [&](const tbb::blocked_range<NodeID> &range) {
+                              auto &dead_ends = local_dead_ends.local();
+                              for (auto node = range.begin(); node != range.end(); ++node)
+                              {
+                                  const EdgeID in = GetReverseEdgeRange(node).size();
+                                  const EdgeID out = m_graph.GetAdjacentEdgeRange(node).size();
+                                  in_degree[node].store(in, std::memory_order_relaxed);
+                                  out_degree[node].store(out, std::memory_order_relaxed);
+                                  if (in == 0 || out == 0)
+                                  {
+                                      colors[node].store(DONE_COLOR, std::memory_order_relaxed);
+                                      dead_ends.push_back(node);
+                                  }
+                              }
+                          });
+
+        std::vector<NodeID> trimmed;
+        for (const auto &dead_ends : local_dead_ends)
+            trimmed.insert(trimmed.end(), dead_ends.begin(), dead_ends.end());
+
+        const auto trim = [&](const NodeID node, std::vector<NodeID> &next_trimmed) {
+            components_index[node] = node;
+            for (const auto edge : m_graph.GetAdjacentEdgeRange(node))
+            {
+                const auto target = m_graph.GetTarget(edge);
+                if (in_degree[target].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    Recolor(target, INITIAL_COLOR, DONE_COLOR))
+                {
+                    next_trimmed.push_back(target);
+                }
+            }
+            for (const auto edge : GetReverseEdgeRange(node))
+            {
+                const auto source = reverse_sources[edge];
+                if (out_degree[source].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    Recolor(source, INITIAL_COLOR, DONE_COLOR))
+                {
+                    next_trimmed.push_back(source);
+                }
+            }
+        };
+        ExpandFrontier(std::move(trimmed), trim);
+
+        return std::count_if(components_index.begin(), components_index.end(), [](unsigned id) {
+            return id != SPECIAL_NODEID;
+        });
+    }
+
+    // Finds the components of the nodes with the given color. The nodes are released on return.
+    void Split(std::vector<NodeID> &nodes, const std::uint32_t color, const unsigned small_splits)
+    {
+        if (nodes.empty())
+            return;
+
+        if (nodes.size() < minimal_split_size || small_splits >= MAX_SMALL_SPLITS)
+        {
+            RunTarjan(nodes, color);
+            std::vector<NodeID>().swap(nodes);
+            return;
+        }
+
+        const auto forward_color = next_color.fetch_add(2, std::memory_order_relaxed);
+        const auto backward_color = forward_color + 1;
+        BOOST_ASSERT_MSG(backward_color < DONE_COLOR, "Ran out of colors");
+
+        const auto pivot = nodes[nodes.size() / 2];
+        Recolor(pivot, color, forward_color);
+        ExpandFrontier({pivot}, [&](const NodeID node, std::vector<NodeID> &next_frontier) {
+            for (const auto edge : m_graph.GetAdjacentEdgeRange(node))
+            {
+                const auto target = m_graph.GetTarget(edge);
+                if (Recolor(target, color, forward_color))
+                    next_frontier.push_back(target);
+            }
+        });
+
+        // nodes reached by both searches are colored DONE_COLOR
+        Recolor(pivot, forward_color, DONE_COLOR);
+        ExpandFrontier({pivot}, [&](const NodeID node, std::vector<NodeID> &next_frontier) {
+            for (const auto edge : GetReverseEdgeRange(node))
+            {
+                const auto source = reverse_sources[edge];
+                if (Recolor(source, color, backward_color) ||
+                    Recolor(source, forward_color, DONE_COLOR))
+                {
+                    next_frontier.push_back(source);
+                }
+            }
+        });
+
+        struct Partition
+        {
+            std::vector<NodeID> component;
+            std::vector<NodeID> forward;
+            std::vector<NodeID> backward;
+            std::vector<NodeID> unreached;
+        };
+        tbb::enumerable_thread_specific<Partition> local_partitions;
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, nodes.size()),
+                          [&](const tbb::blocked_range<std::size_t> &range) {
+                              auto &partition = local_partitions.local();
+                              for (auto index = range.begin(); index != range.end(); ++index)
+                              {
+                                  const auto node = nodes[index];
+                                  const auto node_color = GetColor(node);
+                                  if (node_color == DONE_COLOR)
+                                      partition.component.push_back(node);
+                                  else if (node_color == forward_color)
+                                      partition.forward.push_back(node);
+                                  else if (node_color == backward_color)
+                                      partition.backward.push_back(node);
+                                  else
+                                      partition.unreached.push_back(node);
+                              }
+                          });
+        std::vector<NodeID>().swap(nodes);
+
+        Partition merged;
+        for (auto &partition : local_partitions)
+        {
+            const auto append = [](std::vector<NodeID> &to, const std::vector<NodeID> &from) {
+                to.insert(to.end(), from.begin(), from.end());
+            };
+            append(merged.component, partition.component);
+            append(merged.forward, partition.forward);
+            append(merged.backward, partition.backward);
+            append(merged.unreached, partition.unreached);
+            partition = Partition();
+        }
+
+        AddComponent(merged.component);
+
+        const auto next_small_splits =
+            merged.component.size() < minimal_split_size ? small_splits + 1 : 0;
+        merged.component = std::vector<NodeID>();
+
+        tbb::task_group splits;
+        splits.run([&] { Split(merged.forward, forward_color, next_small_splits); });
+        splits.run([&] { Split(merged.backward, backward_color, next_small_splits); });
+        Split(merged.unreached, color, next_small_splits);
+        splits.wait();
+    }
+
+    // Labels the nodes of a component with its smallest node id
+    void AddComponent(const std::vector<NodeID> &component)
+    {
+        BOOST_ASSERT(!component.empty());
+        const auto label = *std::min_element(component.begin(), component.end());
+        for (const auto node : component)
+            components_index[node] = label;
+    }
+
+    // Iterative Tarjan over the nodes with the given color
+    void RunTarjan(const std::vector<NodeID> &nodes, const std::uint32_t color)
+    {
+        std::vector<TarjanFrame> recursion_stack;
+        std::vector<NodeID> tarjan_stack;
+        std::vector<NodeID> component;
+        unsigned index = 0;
+
+        const auto visit = [&](const NodeID node) {
+            tarjan_index[node] = index;
+            tarjan_low_link[node] = index;
+            ++index;
+            tarjan_stack.push_back(node);
+            const auto edges = m_graph.GetAdjacentEdgeRange(node);
+            recursion_stack.push_back(TarjanFrame{node, edges.begin(), edges.end()});
+        };
+
+        for (const auto root : nodes)
+        {
+            if (tarjan_index[root] != SPECIAL_NODEID)
+                continue;
+
+            visit(root);
+            while (!recursion_stack.empty())
+            {
+                auto &frame = recursion_stack.back();
+                if (frame.current != frame.end)
+                {
+                    const auto target = m_graph.GetTarget(*frame.current);
+                    ++frame.current;
+                    // nodes of other sets and of finished components are ignored, so every
+                    // visited node of this color is still on the tarjan stack
+                    if (GetColor(target) != color)
+                        continue;
+
+                    if (tarjan_index[target] == SPECIAL_NODEID)
+                    {
+                        visit(target);
+                    }
+                    else
+                    {
+                        tarjan_low_link[frame.node] =
+                            std::min(tarjan_low_link[frame.node], tarjan_index[target]);
+                    }
+                    continue;
+                }
+
+                const auto node = frame.node;
+                recursion_stack.pop_back();
+                if (!recursion_stack.empty())
+                {
+                    const auto parent = recursion_stack.back().node;
+                    tarjan_low_link[parent] =
+                        std::min(tarjan_low_link[parent], tarjan_low_link[node]);
+                }
+
+                if (tarjan_low_link[node] == tarjan_index[node])
+                {
+                    NodeID member;
+                    do
+                    {
+                        member = tarjan_stack.back();
+                        tarjan_stack.pop_back();
+                        colors[member].store(DONE_COLOR, std::memory_order_relaxed);
+                        component.push_back(member);
+                    } while (member != node);
+
+                    AddComponent(component);
+                    component.clear();
+                }
+            }
+        }
+    }
+
+    // Replaces the labels by consecutive ids in the order of the smallest node of each component
+    void NumberComponents()
+    {
+        for (const auto node : util::irange<NodeID>(0, components_index.size()))
+        {
+            const auto label = components_index[node];
+            BOOST_ASSERT(label <= node);
+            if (label == node)
+            {
+                components_index[node] = component_size_vector.size();
+                component_size_vector.push_back(1);
+            }
+            else
+            {
+                // the smallest node was relabeled already
+                components_index[node] = components_index[label];
+                ++component_size_vector[components_index[node]];
+            }
+        }
+
+        for (const auto component_id : util::irange<std::size_t>(0, component_size_vector.size()))
+        {
+            if (component_size_vector[component_id] > 1000)
+            {
+                util::Log() << "large component [" << component_id
+                            << "]=" << component_size_vector[component_id];
+            }
+        }
+    }
+};
+}
+}
+
+#endif /* PARALLEL_SCC_HPP */
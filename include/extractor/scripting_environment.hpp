@@ -58,6 +58,10 @@ class ScriptingEnvironment
     virtual void ProcessTurn(ExtractionTurn &turn) = 0;
     virtual void ProcessSegment(ExtractionSegment &segment) = 0;
 
+    // Batched variants that run the turn and segment functions on all threads
+    virtual void ProcessTurns(std::vector<ExtractionTurn> &turns) = 0;
+    virtual void ProcessSegments(std::vector<ExtractionSegment> &segments) = 0;
+
     virtual void
     ProcessElements(const std::vector<osmium::memory::Buffer::const_iterator> &osm_elements,
                     const RestrictionParser &restriction_parser,
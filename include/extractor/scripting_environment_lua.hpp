@@ -21,10 +21,15 @@ struct LuaScriptingContext final
 {
     void ProcessNode(const osmium::Node &, ExtractionNode &result);
     void ProcessWay(const osmium::Way &, ExtractionWay &result);
+    void ProcessTurn(ExtractionTurn &turn);
+    void ProcessSegment(ExtractionSegment &segment);
 
     ProfileProperties properties;
     SourceContainer sources;
     sol::state state;
+    // looked up once, they are called for every turn and segment
+    sol::function turn_function;
+    sol::function segment_function;
 
     bool has_turn_penalty_function;
     bool has_node_function;
@@ -59,6 +64,8 @@ class Sol2ScriptingEnvironment final : public ScriptingEnvironment
     void SetupSources() override;
     void ProcessTurn(ExtractionTurn &turn) override;
     void ProcessSegment(ExtractionSegment &segment) override;
+    void ProcessTurns(std::vector<ExtractionTurn> &turns) override;
+    void ProcessSegments(std::vector<ExtractionSegment> &segments) override;
 
     void
     ProcessElements(const std::vector<osmium::memory::Buffer::const_iterator> &osm_elements,
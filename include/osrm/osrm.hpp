@@ -33,6 +33,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -44,6 +45,7 @@ using engine::api::NearestParameters;
 using engine::api::TripParameters;
 using engine::api::MatchParameters;
 using engine::api::TileParameters;
+using engine::api::BatchRouteParameters;
 
 /**
  * Represents a Open Source Routing Machine with access to its services.
@@ -56,6 +58,7 @@ using engine::api::TileParameters;
  *  - Trip: shortest round trip between coordinates
  *  - Match: snaps noisy coordinate traces to the road network
  *  - Tile: vector tiles with internal graph representation
+ *  - BatchRoute: durations and distances of independent origin/destination pairs
  *
  *  All services take service-specific parameters, fill a JSON object, and return a status code.
  */
@@ -85,6 +88,20 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
 
+    /**
+     * Same as above but encodes the response as protocol buffer message into result, see
+     * the Response message in docs/osrm.proto for the schema. The format is part of the
+     * name so that the type of the result buffer never selects it.
+     */
+    Status RouteProtobuf(const RouteParameters &parameters, std::string &result) const;
+
+    /**
+     * Same as above but renders the JSON response as text directly into result, appending
+     * to it. Skips building the json::Object which is considerably faster for large
+     * responses.
+     */
+    Status RouteJSON(const RouteParameters &parameters, std::vector<char> &result) const;
+
     /**
      * Distance tables for coordinates.
      *
@@ -94,6 +111,20 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
 
+    /**
+     * Same as above but encodes the response as protocol buffer message into result, see
+     * the Response message in docs/osrm.proto for the schema. The format is part of the
+     * name so that the type of the result buffer never selects it.
+     */
+    Status TableProtobuf(const TableParameters &parameters, std::string &result) const;
+
+    /**
+     * Same as above but renders the JSON response as text directly into result, appending
+     * to it. Skips building the json::Object which is considerably faster for large
+     * responses.
+     */
+    Status TableJSON(const TableParameters &parameters, std::vector<char> &result) const;
+
     /**
      * Nearest street segment for coordinate.
      *
@@ -103,6 +134,13 @@ class OSRM final
      */
     Status Nearest(const NearestParameters &parameters, json::Object &result) const;
 
+    /**
+     * Same as above but encodes the response as protocol buffer message into result, see
+     * the Response message in docs/osrm.proto for the schema. The format is part of the
+     * name so that the type of the result buffer never selects it.
+     */
+    Status NearestProtobuf(const NearestParameters &parameters, std::string &result) const;
+
     /**
      * Trip: shortest round trip between coordinates.
      *
@@ -112,6 +150,13 @@ class OSRM final
      */
     Status Trip(const TripParameters &parameters, json::Object &result) const;
 
+    /**
+     * Same as above but encodes the response as protocol buffer message into result, see
+     * the Response message in docs/osrm.proto for the schema. The format is part of the
+     * name so that the type of the result buffer never selects it.
+     */
+    Status TripProtobuf(const TripParameters &parameters, std::string &result) const;
+
     /**
      * Match: snaps noisy coordinate traces to the road network
      *
@@ -121,6 +166,20 @@ class OSRM final
      */
     Status Match(const MatchParameters &parameters, json::Object &result) const;
 
+    /**
+     * Same as above but encodes the response as protocol buffer message into result, see
+     * the Response message in docs/osrm.proto for the schema. The format is part of the
+     * name so that the type of the result buffer never selects it.
+     */
+    Status MatchProtobuf(const MatchParameters &parameters, std::string &result) const;
+
+    /**
+     * Same as above but renders the JSON response as text directly into result, appending
+     * to it. Skips building the json::Object which is considerably faster for large
+     * responses.
+     */
+    Status MatchJSON(const MatchParameters &parameters, std::vector<char> &result) const;
+
     /**
      * Tile: vector tiles with internal graph representation
      *
@@ -130,6 +189,31 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * BatchRoute: durations and distances of independent origin/destination pairs
+     *
+     * \param parameters batch route query specific parameters
+     * \return Status indicating success for the query or failure
+     * \see Status, BatchRouteParameters and json::Object
+     */
+    Status BatchRoute(const BatchRouteParameters &parameters, json::Object &result) const;
+
+    /**
+     * Same as above but renders the JSON response as text directly into result, appending
+     * to it. Skips building the json::Object which is considerably faster for large
+     * responses.
+     */
+    Status BatchRouteJSON(const BatchRouteParameters &parameters, std::vector<char> &result) const;
+
+    /**
+     * Reloads the dataset from the files in the background without interrupting queries.
+     * Queries started before the swap finish on the previous dataset.
+     *
+     * \return false when a reload is already running or the data is in shared memory, which is
+     *         updated by running osrm-datastore instead
+     */
+    bool Reload();
+
   private:
     std::unique_ptr<engine::EngineInterface> engine_;
 };
@@ -52,6 +52,7 @@ struct NearestParameters;
 struct TripParameters;
 struct MatchParameters;
 struct TileParameters;
+struct BatchRouteParameters;
 } // ns api
 
 class EngineInterface;
@@ -34,11 +34,17 @@ using CellStorageView = detail::CellStorageImpl<storage::Ownership::View>;
 
 namespace io
 {
+struct CellStorageHeader;
+template <storage::Ownership Ownership>
+inline void read(const boost::filesystem::path &path,
+                 detail::CellStorageImpl<Ownership> &storage,
+                 CellStorageHeader &header);
 template <storage::Ownership Ownership>
 inline void read(const boost::filesystem::path &path, detail::CellStorageImpl<Ownership> &storage);
 template <storage::Ownership Ownership>
 inline void write(const boost::filesystem::path &path,
-                  const detail::CellStorageImpl<Ownership> &storage);
+                  const detail::CellStorageImpl<Ownership> &storage,
+                  const CellStorageHeader &header);
 }
 
 namespace detail
@@ -69,6 +75,8 @@ template <storage::Ownership Ownership> class CellStorageImpl
 
     // Implementation of the cell view. We need a template parameter here
     // because we need to derive a read-only and read-write view from this.
+    // Weights and durations share the same layout, a row per source and a column per
+    // destination node of the cell.
     template <typename WeightValueT> class CellImpl
     {
       private:
@@ -78,6 +86,7 @@ template <storage::Ownership Ownership> class CellStorageImpl
         BoundarySize num_destination_nodes;
 
         WeightPtrT const weights;
+        WeightPtrT const durations;
         const NodeID *const source_boundary;
         const NodeID *const destination_boundary;
 
@@ -123,20 +132,19 @@ template <storage::Ownership Ownership> class CellStorageImpl
             const std::size_t stride;
         };
 
-      public:
-        auto GetOutWeight(NodeID node) const
+        auto GetOutRange(WeightPtrT const values, NodeID node) const
         {
             auto iter = std::find(source_boundary, source_boundary + num_source_nodes, node);
             if (iter == source_boundary + num_source_nodes)
-                return boost::make_iterator_range(weights, weights);
+                return boost::make_iterator_range(values, values);
 
             auto row = std::distance(source_boundary, iter);
-            auto begin = weights + num_destination_nodes * row;
+            auto begin = values + num_destination_nodes * row;
             auto end = begin + num_destination_nodes;
             return boost::make_iterator_range(begin, end);
         }
 
-        auto GetInWeight(NodeID node) const
+        auto GetInRange(WeightPtrT const values, NodeID node) const
         {
             auto iter =
                 std::find(destination_boundary, destination_boundary + num_destination_nodes, node);
@@ -144,12 +152,21 @@ template <storage::Ownership Ownership> class CellStorageImpl
                 return boost::make_iterator_range(ColumnIterator{}, ColumnIterator{});
 
             auto column = std::distance(destination_boundary, iter);
-            auto begin = ColumnIterator{weights + column, num_destination_nodes};
-            auto end = ColumnIterator{weights + column + num_source_nodes * num_destination_nodes,
+            auto begin = ColumnIterator{values + column, num_destination_nodes};
+            auto end = ColumnIterator{values + column + num_source_nodes * num_destination_nodes,
                                       num_destination_nodes};
             return boost::make_iterator_range(begin, end);
         }
 
+      public:
+        auto GetOutWeight(NodeID node) const { return GetOutRange(weights, node); }
+
+        auto GetInWeight(NodeID node) const { return GetInRange(weights, node); }
+
+        auto GetOutDuration(NodeID node) const { return GetOutRange(durations, node); }
+
+        auto GetInDuration(NodeID node) const { return GetInRange(durations, node); }
+
         auto GetSourceNodes() const
         {
             return boost::make_iterator_range(source_boundary, source_boundary + num_source_nodes);
@@ -163,15 +180,18 @@ template <storage::Ownership Ownership> class CellStorageImpl
 
         CellImpl(const CellData &data,
                  WeightPtrT const all_weight,
+                 WeightPtrT const all_duration,
                  const NodeID *const all_sources,
                  const NodeID *const all_destinations)
             : num_source_nodes{data.num_source_nodes},
               num_destination_nodes{data.num_destination_nodes},
               weights{all_weight + data.weight_offset},
+              durations{all_duration + data.weight_offset},
               source_boundary{all_sources + data.source_boundary_offset},
               destination_boundary{all_destinations + data.destination_boundary_offset}
         {
             BOOST_ASSERT(all_weight != nullptr);
+            BOOST_ASSERT(all_duration != nullptr);
             BOOST_ASSERT(num_source_nodes == 0 || all_sources != nullptr);
             BOOST_ASSERT(num_destination_nodes == 0 || all_destinations != nullptr);
         }
@@ -313,15 +333,18 @@ template <storage::Ownership Ownership> class CellStorageImpl
         }
 
         weights.resize(weight_offset + 1, INVALID_EDGE_WEIGHT);
+        durations.resize(weight_offset + 1, MAXIMAL_EDGE_DURATION);
     }
 
     template <typename = std::enable_if<Ownership == storage::Ownership::View>>
     CellStorageImpl(Vector<EdgeWeight> weights_,
+                    Vector<EdgeWeight> durations_,
                     Vector<NodeID> source_boundary_,
                     Vector<NodeID> destination_boundary_,
                     Vector<CellData> cells_,
                     Vector<std::uint64_t> level_to_cell_offset_)
-        : weights(std::move(weights_)), source_boundary(std::move(source_boundary_)),
+        : weights(std::move(weights_)), durations(std::move(durations_)),
+          source_boundary(std::move(source_boundary_)),
           destination_boundary(std::move(destination_boundary_)), cells(std::move(cells_)),
           level_to_cell_offset(std::move(level_to_cell_offset_))
     {
@@ -336,6 +359,7 @@ template <storage::Ownership Ownership> class CellStorageImpl
         BOOST_ASSERT(cell_index < cells.size());
         return ConstCell{cells[cell_index],
                          weights.data(),
+                         durations.data(),
                          source_boundary.empty() ? nullptr : source_boundary.data(),
                          destination_boundary.empty() ? nullptr : destination_boundary.data()};
     }
@@ -348,17 +372,23 @@ template <storage::Ownership Ownership> class CellStorageImpl
         const auto offset = level_to_cell_offset[level_index];
         const auto cell_index = offset + id;
         BOOST_ASSERT(cell_index < cells.size());
-        return Cell{
-            cells[cell_index], weights.data(), source_boundary.data(), destination_boundary.data()};
+        return Cell{cells[cell_index],
+                    weights.data(),
+                    durations.data(),
+                    source_boundary.data(),
+                    destination_boundary.data()};
     }
 
     friend void io::read<Ownership>(const boost::filesystem::path &path,
-                                    detail::CellStorageImpl<Ownership> &storage);
+                                    detail::CellStorageImpl<Ownership> &storage,
+                                    io::CellStorageHeader &header);
     friend void io::write<Ownership>(const boost::filesystem::path &path,
-                                     const detail::CellStorageImpl<Ownership> &storage);
+                                     const detail::CellStorageImpl<Ownership> &storage,
+                                     const io::CellStorageHeader &header);
 
   private:
     Vector<EdgeWeight> weights;
+    Vector<EdgeWeight> durations;
     Vector<NodeID> source_boundary;
     Vector<NodeID> destination_boundary;
     Vector<CellData> cells;
@@ -9,6 +9,16 @@
 #include "storage/io.hpp"
 #include "storage/shared_memory_ownership.hpp"
 
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+
+#include <boost/crc.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
 namespace osrm
 {
 namespace partition
@@ -16,15 +26,66 @@ namespace partition
 namespace io
 {
 
+// Leads the .cells file after the fingerprint. Bump the lower half of the format whenever the
+// layout changes, files written before the cells stored durations start with the weights count.
+const constexpr std::uint64_t CELL_STORAGE_FORMAT = 0x4f534d4c44430000 | 3;
+
+struct CellStorageHeader
+{
+    std::uint64_t format = CELL_STORAGE_FORMAT;
+    // checksum of the .partition file the cells were built for
+    std::uint32_t partition_checksum = 0;
+    // checksum of the .mldgr file written with the last customization, 0 if never customized
+    std::uint32_t graph_checksum = 0;
+};
+static_assert(sizeof(CellStorageHeader) == 16, "CellStorageHeader is written as is");
+
+inline CellStorageHeader readCellStorageHeader(storage::io::FileReader &reader,
+                                               const boost::filesystem::path &path)
+{
+    const auto header = reader.ReadOne<CellStorageHeader>();
+    if (header.format != CELL_STORAGE_FORMAT)
+    {
+        throw util::exception("Incompatible cell storage format in " + path.string() +
+                              ", please re-run osrm-partition and osrm-customize" + SOURCE_REF);
+    }
+    return header;
+}
+
+// CRC32 of the whole file content
+inline std::uint32_t checksum(const boost::filesystem::path &path)
+{
+    boost::filesystem::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+        throw util::exception("Error opening " + path.string() + SOURCE_REF);
+    }
+
+    boost::crc_32_type crc;
+    std::vector<char> buffer(1024 * 1024);
+    while (input)
+    {
+        input.read(buffer.data(), buffer.size());
+        crc.process_bytes(buffer.data(), input.gcount());
+    }
+    return crc.checksum();
+}
+
 template <typename EdgeDataT, storage::Ownership Ownership>
 inline void read(const boost::filesystem::path &path, MultiLevelGraph<EdgeDataT, Ownership> &graph)
 {
     const auto fingerprint = storage::io::FileReader::VerifyFingerprint;
     storage::io::FileReader reader{path, fingerprint};
 
-    reader.DeserializeVector(graph.node_array);
-    reader.DeserializeVector(graph.edge_array);
-    reader.DeserializeVector(graph.edge_to_level);
+    decltype(graph.node_array) node_array;
+    decltype(graph.edge_array) edge_array;
+    decltype(graph.node_to_edge_offset) node_to_edge_offset;
+    reader.DeserializeVector(node_array);
+    reader.DeserializeVector(edge_array);
+    reader.DeserializeVector(node_to_edge_offset);
+
+    graph = MultiLevelGraph<EdgeDataT, Ownership>(
+        std::move(node_array), std::move(edge_array), std::move(node_to_edge_offset));
 }
 
 template <typename EdgeDataT, storage::Ownership Ownership>
@@ -59,24 +120,39 @@ template <> inline void write(const boost::filesystem::path &path, const MultiLe
     writer.SerializeVector(mlp.cell_to_children);
 }
 
-template <> inline void read(const boost::filesystem::path &path, CellStorage &storage)
+template <>
+inline void
+read(const boost::filesystem::path &path, CellStorage &storage, CellStorageHeader &header)
 {
     const auto fingerprint = storage::io::FileReader::VerifyFingerprint;
     storage::io::FileReader reader{path, fingerprint};
 
+    header = readCellStorageHeader(reader, path);
     reader.DeserializeVector(storage.weights);
+    reader.DeserializeVector(storage.durations);
     reader.DeserializeVector(storage.source_boundary);
     reader.DeserializeVector(storage.destination_boundary);
     reader.DeserializeVector(storage.cells);
     reader.DeserializeVector(storage.level_to_cell_offset);
 }
 
-template <> inline void write(const boost::filesystem::path &path, const CellStorage &storage)
+template <> inline void read(const boost::filesystem::path &path, CellStorage &storage)
+{
+    CellStorageHeader header;
+    read(path, storage, header);
+}
+
+template <>
+inline void write(const boost::filesystem::path &path,
+                  const CellStorage &storage,
+                  const CellStorageHeader &header)
 {
     const auto fingerprint = storage::io::FileWriter::GenerateFingerprint;
     storage::io::FileWriter writer{path, fingerprint};
 
+    writer.WriteOne(header);
     writer.SerializeVector(storage.weights);
+    writer.SerializeVector(storage.durations);
     writer.SerializeVector(storage.source_boundary);
     writer.SerializeVector(storage.destination_boundary);
     writer.SerializeVector(storage.cells);
@@ -11,6 +11,7 @@
 #include <boost/spirit/include/phoenix.hpp>
 #include <boost/spirit/include/qi.hpp>
 
+#include <cctype>
 #include <limits>
 #include <string>
 
@@ -27,16 +28,15 @@ namespace ph = boost::phoenix;
 namespace qi = boost::spirit::qi;
 }
 
-template <typename T, char... Fmt> struct no_trailing_dot_policy : qi::real_policies<T>
+// Does not consume the dot of a format suffix like in "7.41,43.json" or "7.41,43.pbf"
+template <typename T> struct no_trailing_dot_policy : qi::real_policies<T>
 {
     template <typename Iterator> static bool parse_dot(Iterator &first, Iterator const &last)
     {
         if (first == last || *first != '.')
             return false;
 
-        static const constexpr char fmt[sizeof...(Fmt)] = {Fmt...};
-
-        if (first + sizeof(fmt) < last && std::equal(fmt, fmt + sizeof(fmt), first + 1u))
+        if (first + 1 != last && std::isalpha(static_cast<unsigned char>(*(first + 1))))
             return false;
 
         ++first;
@@ -70,9 +70,10 @@ template <typename T, char... Fmt> struct no_trailing_dot_policy : qi::real_poli
 template <typename Iterator, typename Signature>
 struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
 {
-    using json_policy = no_trailing_dot_policy<double, 'j', 's', 'o', 'n'>;
+    using format_policy = no_trailing_dot_policy<double>;
 
-    BaseParametersGrammar(qi::rule<Iterator, Signature> &root_rule)
+    // With coordinates_in_body the query starts directly with the format or the options
+    BaseParametersGrammar(qi::rule<Iterator, Signature> &root_rule, const bool coordinates_in_body)
         : BaseParametersGrammar::base_type(root_rule)
     {
         const auto add_hint = [](engine::api::BaseParameters &base_parameters,
@@ -128,9 +129,15 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
                                           },
                                           qi::_1)];
 
-        query_rule =
-            ((location_rule % ';') |
-             polyline_rule)[ph::bind(&engine::api::BaseParameters::coordinates, qi::_r1) = qi::_1];
+        if (coordinates_in_body)
+        {
+            query_rule = qi::eps;
+        }
+        else
+        {
+            query_rule = ((location_rule % ';') | polyline_rule)[ph::bind(
+                &engine::api::BaseParameters::coordinates, qi::_r1) = qi::_1];
+        }
 
         radiuses_rule = qi::lit("radiuses=") >
                         (-(qi::double_ | unlimited_rule) %
@@ -149,6 +156,13 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
             qi::lit("bearings=") >
             (-(qi::short_ > ',' > qi::short_))[ph::bind(add_bearing, qi::_r1, qi::_1)] % ';';
 
+        format_type.add("json", engine::api::BaseParameters::OutputFormatType::JSON)(
+            "pbf", engine::api::BaseParameters::OutputFormatType::PROTOBUF);
+
+        format_rule =
+            qi::lit('.') >
+            format_type[ph::bind(&engine::api::BaseParameters::format, qi::_r1) = qi::_1];
+
         base_rule = radiuses_rule(qi::_r1)   //
                     | hints_rule(qi::_r1)    //
                     | bearings_rule(qi::_r1) //
@@ -158,6 +172,7 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
   protected:
     qi::rule<Iterator, Signature> base_rule;
     qi::rule<Iterator, Signature> query_rule;
+    qi::rule<Iterator, Signature> format_rule;
 
   private:
     qi::rule<Iterator, Signature> bearings_rule;
@@ -173,7 +188,9 @@ struct BaseParametersGrammar : boost::spirit::qi::grammar<Iterator, Signature>
     qi::rule<Iterator, unsigned char()> base64_char;
     qi::rule<Iterator, std::string()> polyline_chars;
     qi::rule<Iterator, double()> unlimited_rule;
-    qi::real_parser<double, json_policy> double_;
+
+    qi::symbols<char, engine::api::BaseParameters::OutputFormatType> format_type;
+    qi::real_parser<double, format_policy> double_;
 };
 }
 }
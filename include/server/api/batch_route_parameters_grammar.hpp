@@ -0,0 +1,44 @@
+#ifndef BATCH_ROUTE_PARAMETERS_GRAMMAR_HPP
+#define BATCH_ROUTE_PARAMETERS_GRAMMAR_HPP
+
+#include "server/api/route_parameters_grammar.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+
+#include <boost/spirit/include/phoenix.hpp>
+#include <boost/spirit/include/qi.hpp>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+namespace
+{
+namespace ph = boost::phoenix;
+namespace qi = boost::spirit::qi;
+}
+
+template <typename Iterator = std::string::iterator,
+          typename Signature = void(engine::api::BatchRouteParameters &)>
+struct BatchRouteParametersGrammar final : public RouteParametersGrammar<Iterator, Signature>
+{
+    using BaseGrammar = RouteParametersGrammar<Iterator, Signature>;
+
+    explicit BatchRouteParametersGrammar(const bool coordinates_in_body = false)
+        : BaseGrammar(root_rule, coordinates_in_body)
+    {
+        // the summaries are only rendered as JSON, there is no pbf message for them
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+                    -('?' > BaseGrammar::base_rule(qi::_r1) % '&');
+    }
+
+  private:
+    qi::rule<Iterator, Signature> root_rule;
+};
+}
+}
+}
+
+#endif
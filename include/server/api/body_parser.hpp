@@ -0,0 +1,29 @@
+#ifndef SERVER_API_BODY_PARSER_HPP
+#define SERVER_API_BODY_PARSER_HPP
+
+#include "util/coordinate.hpp"
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+// Decodes the coordinates sent in the body of a POST request. Supported content types are
+//  - application/octet-stream: packed pairs of little endian int32 longitude, latitude in
+//    1e-6 degrees
+//  - application/x-polyline: a polyline with precision 5, like polyline(...) in the URL
+// Returns boost::none for other content types or malformed bodies.
+boost::optional<std::vector<util::Coordinate>> parseCoordinates(const std::string &content_type,
+                                                                const std::string &body);
+}
+}
+}
+
+#endif
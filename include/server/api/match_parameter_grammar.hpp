@@ -26,7 +26,8 @@ struct MatchParametersGrammar final : public RouteParametersGrammar<Iterator, Si
 {
     using BaseGrammar = RouteParametersGrammar<Iterator, Signature>;
 
-    MatchParametersGrammar() : BaseGrammar(root_rule)
+    explicit MatchParametersGrammar(const bool coordinates_in_body = false)
+        : BaseGrammar(root_rule, coordinates_in_body)
     {
         timestamps_rule =
             qi::lit("timestamps=") >
@@ -37,7 +38,7 @@ struct MatchParametersGrammar final : public RouteParametersGrammar<Iterator, Si
             "ignore", engine::api::MatchParameters::GapsType::Ignore);
 
         root_rule =
-            BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+            BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
             -('?' > (timestamps_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1) |
                      (qi::lit("gaps=") >
                       gaps_type[ph::bind(&engine::api::MatchParameters::gaps, qi::_r1) = qi::_1]) |
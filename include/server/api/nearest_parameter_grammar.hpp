@@ -26,13 +26,14 @@ struct NearestParametersGrammar final : public BaseParametersGrammar<Iterator, S
 {
     using BaseGrammar = BaseParametersGrammar<Iterator, Signature>;
 
-    NearestParametersGrammar() : BaseGrammar(root_rule)
+    explicit NearestParametersGrammar(const bool coordinates_in_body = false)
+        : BaseGrammar(root_rule, coordinates_in_body)
     {
         nearest_rule = (qi::lit("number=") >
                         qi::uint_)[ph::bind(&engine::api::NearestParameters::number_of_results,
                                             qi::_r1) = qi::_1];
 
-        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (nearest_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
     }
 
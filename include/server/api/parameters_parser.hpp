@@ -3,10 +3,12 @@
 
 #include "engine/api/base_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
+#include "util/coordinate.hpp"
 
 #include <boost/optional/optional.hpp>
 
 #include <type_traits>
+#include <vector>
 
 namespace osrm
 {
@@ -25,6 +27,9 @@ using is_parameter_t =
     std::integral_constant<bool,
                            std::is_base_of<engine::api::BaseParameters, T>::value ||
                                std::is_same<engine::api::TileParameters, T>::value>;
+
+template <typename T>
+using has_coordinates_t = std::is_base_of<engine::api::BaseParameters, T>;
 } // ns detail
 
 // Starts parsing and iter and modifies it until iter == end or parsing failed
@@ -33,6 +38,14 @@ template <typename ParameterT,
 boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
                                             const std::string::iterator end);
 
+// Same as above for requests that sent their coordinates in the body: [iter, end) only holds the
+// optional format and options, the coordinates are moved into the parameters
+template <typename ParameterT,
+          typename std::enable_if<detail::has_coordinates_t<ParameterT>::value, int>::type = 0>
+boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
+                                            const std::string::iterator end,
+                                            std::vector<util::Coordinate> coordinates);
+
 // Copy on purpose because we need mutability
 template <typename ParameterT,
           typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0>
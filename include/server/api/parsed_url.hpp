@@ -3,6 +3,8 @@
 
 #include "util/coordinate.hpp"
 
+#include <boost/optional.hpp>
+
 #include <string>
 #include <vector>
 
@@ -20,6 +22,8 @@ struct ParsedURL final
     std::string profile;
     std::string query;
     std::size_t prefix_length;
+    // set for POST requests that send the coordinates in the body instead of the URL
+    boost::optional<std::vector<util::Coordinate>> coordinates;
 };
 
 } // api
@@ -26,7 +26,8 @@ struct RouteParametersGrammar : public BaseParametersGrammar<Iterator, Signature
 {
     using BaseGrammar = BaseParametersGrammar<Iterator, Signature>;
 
-    RouteParametersGrammar() : RouteParametersGrammar(root_rule)
+    explicit RouteParametersGrammar(const bool coordinates_in_body = false)
+        : RouteParametersGrammar(root_rule, coordinates_in_body)
     {
         route_rule =
             (qi::lit("alternatives=") >
@@ -36,11 +37,13 @@ struct RouteParametersGrammar : public BaseParametersGrammar<Iterator, Signature
               qi::bool_[ph::bind(&engine::api::RouteParameters::continue_straight, qi::_r1) =
                             qi::_1]));
 
-        root_rule = query_rule(qi::_r1) > -qi::lit(".json") >
+        root_rule = query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (route_rule(qi::_r1) | base_rule(qi::_r1)) % '&');
     }
 
-    RouteParametersGrammar(qi::rule<Iterator, Signature> &root_rule_) : BaseGrammar(root_rule_)
+    RouteParametersGrammar(qi::rule<Iterator, Signature> &root_rule_,
+                           const bool coordinates_in_body)
+        : BaseGrammar(root_rule_, coordinates_in_body)
     {
         using AnnotationsType = engine::api::RouteParameters::AnnotationsType;
 
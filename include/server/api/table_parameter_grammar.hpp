@@ -26,7 +26,8 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
 {
     using BaseGrammar = BaseParametersGrammar<Iterator, Signature>;
 
-    TableParametersGrammar() : BaseGrammar(root_rule)
+    explicit TableParametersGrammar(const bool coordinates_in_body = false)
+        : BaseGrammar(root_rule, coordinates_in_body)
     {
 #ifdef BOOST_HAS_LONG_LONG
         if (std::is_same<std::size_t, unsigned long long>::value)
@@ -48,9 +49,26 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
             (qi::lit("all") |
              (size_t_ % ';')[ph::bind(&engine::api::TableParameters::sources, qi::_r1) = qi::_1]);
 
-        table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1);
+        using AnnotationsType = engine::api::TableParameters::AnnotationsType;
 
-        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+        const auto reset_annotations = [](engine::api::TableParameters &table_parameters) {
+            table_parameters.annotations = AnnotationsType::None;
+        };
+        const auto add_annotation = [](engine::api::TableParameters &table_parameters,
+                                       AnnotationsType table_param) {
+            table_parameters.annotations = table_parameters.annotations | table_param;
+        };
+
+        annotations_type.add("duration", AnnotationsType::Duration)("distance",
+                                                                    AnnotationsType::Distance);
+
+        annotations_rule =
+            qi::lit("annotations=")[ph::bind(reset_annotations, qi::_r1)] >
+            (annotations_type[ph::bind(add_annotation, qi::_r1, qi::_1)] % ',');
+
+        table_rule = destinations_rule(qi::_r1) | sources_rule(qi::_r1) | annotations_rule(qi::_r1);
+
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (table_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) % '&');
     }
 
@@ -59,7 +77,10 @@ struct TableParametersGrammar final : public BaseParametersGrammar<Iterator, Sig
     qi::rule<Iterator, Signature> table_rule;
     qi::rule<Iterator, Signature> sources_rule;
     qi::rule<Iterator, Signature> destinations_rule;
+    qi::rule<Iterator, Signature> annotations_rule;
     qi::rule<Iterator, std::size_t()> size_t_;
+
+    qi::symbols<char, engine::api::TableParameters::AnnotationsType> annotations_type;
 };
 }
 }
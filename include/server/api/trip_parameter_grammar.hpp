@@ -26,7 +26,8 @@ struct TripParametersGrammar final : public RouteParametersGrammar<Iterator, Sig
 {
     using BaseGrammar = RouteParametersGrammar<Iterator, Signature>;
 
-    TripParametersGrammar() : BaseGrammar(root_rule)
+    explicit TripParametersGrammar(const bool coordinates_in_body = false)
+        : BaseGrammar(root_rule, coordinates_in_body)
     {
         roundtrip_rule =
             qi::lit("roundtrip=") >
@@ -45,7 +46,7 @@ struct TripParametersGrammar final : public RouteParametersGrammar<Iterator, Sig
             qi::lit("destination=") >
             destination_type[ph::bind(&engine::api::TripParameters::destination, qi::_r1) = qi::_1];
 
-        root_rule = BaseGrammar::query_rule(qi::_r1) > -qi::lit(".json") >
+        root_rule = BaseGrammar::query_rule(qi::_r1) > -BaseGrammar::format_rule(qi::_r1) >
                     -('?' > (roundtrip_rule(qi::_r1) | source_rule(qi::_r1) |
                              destination_rule(qi::_r1) | BaseGrammar::base_rule(qi::_r1)) %
                                 '&');
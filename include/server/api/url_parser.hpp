@@ -14,13 +14,17 @@ namespace server
 namespace api
 {
 
-// Starts parsing and iter and modifies it until iter == end or parsing failed
-boost::optional<ParsedURL> parseURL(std::string::iterator &iter, const std::string::iterator end);
+// Starts parsing and iter and modifies it until iter == end or parsing failed.
+// With coordinates_in_body the coordinates part of the URL is left out, see parseCoordinates.
+boost::optional<ParsedURL> parseURL(std::string::iterator &iter,
+                                    const std::string::iterator end,
+                                    const bool coordinates_in_body = false);
 
-inline boost::optional<ParsedURL> parseURL(std::string url_string)
+inline boost::optional<ParsedURL> parseURL(std::string url_string,
+                                           const bool coordinates_in_body = false)
 {
     auto iter = url_string.begin();
-    return parseURL(iter, url_string.end());
+    return parseURL(iter, url_string.end(), coordinates_in_body);
 }
 }
 }
@@ -5,9 +5,11 @@
 #include "server/http/reply.hpp"
 #include "server/http/request.hpp"
 #include "server/request_parser.hpp"
+#include "server/worker_pool.hpp"
 
 #include <boost/array.hpp>
 #include <boost/asio.hpp>
+#include <boost/asio/deadline_timer.hpp>
 #include <boost/config.hpp>
 #include <boost/version.hpp>
 
@@ -37,7 +39,10 @@ class RequestHandler;
 class Connection : public std::enable_shared_from_this<Connection>
 {
   public:
-    explicit Connection(boost::asio::io_service &io_service, RequestHandler &handler);
+    explicit Connection(boost::asio::io_service &io_service,
+                        RequestHandler &handler,
+                        WorkerPool &worker_pool,
+                        const unsigned keepalive_timeout);
     Connection(const Connection &) = delete;
     Connection &operator=(const Connection &) = delete;
 
@@ -47,20 +52,52 @@ class Connection : public std::enable_shared_from_this<Connection>
     void start();
 
   private:
+    /// Read more data from the socket, arming the idle timer on persistent connections.
+    void read_more();
+
     void handle_read(const boost::system::error_code &e, std::size_t bytes_transferred);
 
+    /// Parse the buffered data in [begin, end) and answer the request if it is complete.
+    void process_data(char *begin, char *end);
+
+    /// Compute the reply for the current request, runs on a worker thread if available.
+    void compute_reply();
+
+    /// Add connection headers, compress and write the current reply.
+    void send_reply();
+
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
+    /// Handle completion of the interim "100 Continue" response, continue with the body.
+    void handle_continue_write(const boost::system::error_code &e);
+
+    /// Handle expiry of the keep-alive idle timer.
+    void handle_timeout(const boost::system::error_code &e);
+
+    /// Decide whether the connection stays open after answering the current request.
+    bool wants_keep_alive() const;
+
+    void graceful_shutdown();
+
     std::vector<char> compress_buffers(const std::vector<char> &uncompressed_data,
                                        const http::compression_type compression_type);
 
     boost::asio::io_service::strand strand;
     boost::asio::ip::tcp::socket TCP_socket;
+    boost::asio::deadline_timer timer;
     RequestHandler &request_handler;
+    WorkerPool &worker_pool;
     RequestParser request_parser;
     boost::array<char, 8192> incoming_data_buffer;
+    // unparsed bytes of pipelined requests that were received together with the current one
+    char *pending_begin;
+    char *pending_end;
+    const unsigned keepalive_timeout;
+    unsigned remaining_requests;
+    bool keep_alive;
     http::request current_request;
+    http::compression_type current_compression;
     http::reply current_reply;
     std::vector<char> compressed_output;
     // Header compression_header;
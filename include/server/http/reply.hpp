@@ -21,7 +21,8 @@ class reply
     {
         ok = 200,
         bad_request = 400,
-        internal_server_error = 500
+        internal_server_error = 500,
+        service_unavailable = 503
     } status;
 
     std::vector<header> headers;
@@ -31,6 +32,7 @@ class reply
     static reply stock_reply(const status_type status);
     void set_size(const std::size_t size);
     void set_uncompressed_size();
+    void reset();
 
     reply();
 
@@ -14,9 +14,16 @@ namespace http
 
 struct request
 {
+    std::string method;
     std::string uri;
     std::string referrer;
     std::string agent;
+    std::string connection;
+    std::string content_type;
+    // raw content of POST requests, empty for GET
+    std::string body;
+    unsigned http_version_major = 0;
+    unsigned http_version_minor = 0;
     boost::asio::ip::address endpoint;
 };
 }
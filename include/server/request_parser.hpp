@@ -4,6 +4,7 @@
 #include "server/http/compression_type.hpp"
 #include "server/http/header.hpp"
 
+#include <cstddef>
 #include <tuple>
 
 namespace osrm
@@ -25,15 +26,26 @@ class RequestParser
     {
         valid,
         invalid,
-        indeterminate
+        indeterminate,
+        // the headers are complete and the client waits for "100 Continue" to send the body
+        expect_continue
     };
 
-    std::tuple<RequestStatus, http::compression_type>
+    // Consumes input until a request is complete or the input is exhausted. The returned
+    // pointer marks the end of the consumed input, bytes behind it belong to the next
+    // (pipelined) request on the same connection.
+    std::tuple<RequestStatus, http::compression_type, char *>
     parse(http::request &current_request, char *begin, char *end);
 
+    // Prepares the parser to consume the next request on a persistent connection
+    void reset();
+
   private:
     RequestStatus consume(http::request &current_request, const char input);
 
+    // Copies as much of the announced content as is available in [begin, end)
+    RequestStatus consume_body(http::request &current_request, char *&begin, char *end);
+
     bool is_char(const int character) const;
 
     bool is_CTL(const int character) const;
@@ -64,11 +76,14 @@ class RequestParser
         space_before_header_value,
         header_value,
         expecting_newline_2,
-        expecting_newline_3
+        expecting_newline_3,
+        body
     } state;
 
     http::header current_header;
     http::compression_type selected_compression;
+    std::size_t content_length;
+    bool expect_continue;
 };
 }
 }
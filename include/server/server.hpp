@@ -4,6 +4,7 @@
 #include "server/connection.hpp"
 #include "server/request_handler.hpp"
 #include "server/service_handler.hpp"
+#include "server/worker_pool.hpp"
 
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
@@ -34,17 +35,40 @@ class Server
   public:
     // Note: returns a shared instead of a unique ptr as it is captured in a lambda somewhere else
     static std::shared_ptr<Server>
-    CreateServer(std::string &ip_address, int ip_port, unsigned requested_num_threads)
+    CreateServer(std::string &ip_address,
+                 int ip_port,
+                 unsigned requested_num_threads,
+                 unsigned requested_num_compute_threads,
+                 unsigned max_queue_size,
+                 unsigned keepalive_timeout,
+                 bool pin_threads = false)
     {
         util::Log() << "http 1.1 compression handled by zlib version " << zlibVersion();
         const unsigned hardware_threads = std::max(1u, std::thread::hardware_concurrency());
         const unsigned real_num_threads = std::min(hardware_threads, requested_num_threads);
-        return std::make_shared<Server>(ip_address, ip_port, real_num_threads);
+        const unsigned real_num_compute_threads =
+            std::min(hardware_threads, requested_num_compute_threads);
+        return std::make_shared<Server>(ip_address,
+                                        ip_port,
+                                        real_num_threads,
+                                        real_num_compute_threads,
+                                        max_queue_size,
+                                        keepalive_timeout,
+                                        pin_threads);
     }
 
-    explicit Server(const std::string &address, const int port, const unsigned thread_pool_size)
-        : thread_pool_size(thread_pool_size), acceptor(io_service),
-          new_connection(std::make_shared<Connection>(io_service, request_handler))
+    explicit Server(const std::string &address,
+                    const int port,
+                    const unsigned thread_pool_size,
+                    const unsigned compute_pool_size,
+                    const unsigned max_queue_size,
+                    const unsigned keepalive_timeout,
+                    const bool pin_threads = false)
+        : thread_pool_size(thread_pool_size), keepalive_timeout(keepalive_timeout),
+          pin_threads(pin_threads), acceptor(io_service),
+          worker_pool(compute_pool_size, max_queue_size, pin_threads),
+          new_connection(std::make_shared<Connection>(
+              io_service, request_handler, worker_pool, keepalive_timeout))
     {
         const auto port_string = std::to_string(port);
 
@@ -62,6 +86,15 @@ class Server
         acceptor.listen();
 
         util::Log() << "Listening on: " << acceptor.local_endpoint();
+        if (compute_pool_size > 0)
+        {
+            util::Log() << "Computing replies on " << compute_pool_size << " worker threads";
+        }
+        if (pin_threads)
+        {
+            util::Log() << "Pinning threads to " << util::numa::GetNumberOfNodes()
+                        << " NUMA nodes";
+        }
 
         acceptor.async_accept(
             new_connection->socket(),
@@ -70,20 +103,31 @@ class Server
 
     void Run()
     {
+        worker_pool.Start();
+
         std::vector<std::shared_ptr<std::thread>> threads;
         for (unsigned i = 0; i < thread_pool_size; ++i)
         {
-            std::shared_ptr<std::thread> thread = std::make_shared<std::thread>(
-                boost::bind(&boost::asio::io_service::run, &io_service));
+            std::shared_ptr<std::thread> thread = std::make_shared<std::thread>([this, i] {
+                if (pin_threads)
+                    WorkerPool::PinToNode(i);
+                io_service.run();
+            });
             threads.push_back(thread);
         }
         for (auto thread : threads)
         {
             thread->join();
         }
+
+        worker_pool.Join();
     }
 
-    void Stop() { io_service.stop(); }
+    void Stop()
+    {
+        io_service.stop();
+        worker_pool.Stop();
+    }
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler_)
     {
@@ -96,7 +140,8 @@ class Server
         if (!e)
         {
             new_connection->start();
-            new_connection = std::make_shared<Connection>(io_service, request_handler);
+            new_connection = std::make_shared<Connection>(
+                io_service, request_handler, worker_pool, keepalive_timeout);
             acceptor.async_accept(
                 new_connection->socket(),
                 boost::bind(&Server::HandleAccept, this, boost::asio::placeholders::error));
@@ -104,10 +149,13 @@ class Server
     }
 
     unsigned thread_pool_size;
+    unsigned keepalive_timeout;
+    bool pin_threads;
     boost::asio::io_service io_service;
     boost::asio::ip::tcp::acceptor acceptor;
-    std::shared_ptr<Connection> new_connection;
     RequestHandler request_handler;
+    WorkerPool worker_pool;
+    std::shared_ptr<Connection> new_connection;
 };
 }
 }
@@ -5,6 +5,7 @@
 #include "osrm/osrm.hpp"
 #include "util/coordinate.hpp"
 
+#include <boost/optional.hpp>
 #include <mapbox/variant.hpp>
 
 #include <string>
@@ -20,13 +21,18 @@ namespace service
 class BaseService
 {
   public:
-    using ResultT = mapbox::util::variant<util::json::Object, std::string>;
+    // JSON responses are either built as json::Object or already rendered into a char buffer
+    using ResultT = mapbox::util::variant<util::json::Object, std::vector<char>, std::string>;
+    // coordinates of POST requests that are sent in the body instead of the query
+    using CoordinatesT = boost::optional<std::vector<util::Coordinate>>;
 
     BaseService(OSRM &routing_machine) : routing_machine(routing_machine) {}
     virtual ~BaseService() = default;
 
-    virtual engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) = 0;
+    virtual engine::Status RunQuery(std::size_t prefix_length,
+                                    std::string &query,
+                                    CoordinatesT coordinates,
+                                    ResultT &result) = 0;
 
     virtual unsigned GetVersion() = 0;
 
@@ -22,8 +22,10 @@ class MatchService final : public BaseService
   public:
     MatchService(OSRM &routing_machine) : BaseService(routing_machine) {}
 
-    engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) final override;
+    engine::Status RunQuery(std::size_t prefix_length,
+                            std::string &query,
+                            CoordinatesT coordinates,
+                            ResultT &result) final override;
 
     unsigned GetVersion() final override { return 1; }
 };
@@ -39,6 +39,9 @@ class ServiceHandler final : public ServiceHandlerInterface
 
     virtual engine::Status RunQuery(api::ParsedURL parsed_url, ResultT &result) override;
 
+    // Reloads the dataset of the routing machine in the background
+    bool Reload();
+
   private:
     std::unordered_map<std::string, std::unique_ptr<service::BaseService>> service_map;
     OSRM routing_machine;
@@ -0,0 +1,112 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include "util/log.hpp"
+#include "util/memory_placement.hpp"
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace osrm
+{
+namespace server
+{
+
+/// Runs request computations outside of the I/O threads so that a single expensive query
+/// does not block every connection served by the same I/O thread.
+/// Without worker threads tasks are run inline on the calling thread.
+/// With pin_threads the workers are spread round robin over the NUMA nodes and bound to them.
+class WorkerPool
+{
+  public:
+    WorkerPool(const unsigned num_threads,
+               const unsigned max_queue_size,
+               const bool pin_threads = false)
+        : num_threads(num_threads), max_queue_size(max_queue_size), pin_threads(pin_threads),
+          queued_tasks(0), work(std::make_unique<boost::asio::io_service::work>(io_service))
+    {
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    /// Schedules the task on a worker thread. Returns false if the task was rejected
+    /// because max_queue_size tasks are already waiting (0 means unlimited).
+    template <typename TaskT> bool Post(TaskT task)
+    {
+        if (num_threads == 0)
+        {
+            task();
+            return true;
+        }
+
+        const auto waiting = queued_tasks.fetch_add(1);
+        if (max_queue_size > 0 && waiting >= max_queue_size)
+        {
+            queued_tasks.fetch_sub(1);
+            return false;
+        }
+
+        io_service.post([this, task]() {
+            queued_tasks.fetch_sub(1);
+            task();
+        });
+        return true;
+    }
+
+    /// Spawns the worker threads, they run until Stop is called.
+    void Start()
+    {
+        for (unsigned i = 0; i < num_threads; ++i)
+        {
+            threads.emplace_back([this, i] {
+                if (pin_threads)
+                    PinToNode(i);
+                io_service.run();
+            });
+        }
+    }
+
+    void Stop()
+    {
+        work.reset();
+        io_service.stop();
+    }
+
+    void Join()
+    {
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+    unsigned GetNumberOfThreads() const { return num_threads; }
+
+    /// Binds the calling thread to the NUMA node thread_index falls on round robin.
+    static void PinToNode(const unsigned thread_index)
+    {
+        const auto node = thread_index % util::numa::GetNumberOfNodes();
+        if (!util::numa::BindCurrentThreadToNode(node))
+            util::Log(logWARNING) << "Could not bind thread " << thread_index << " to NUMA node "
+                                  << node;
+    }
+
+  private:
+    const unsigned num_threads;
+    const unsigned max_queue_size;
+    const bool pin_threads;
+    std::atomic<unsigned> queued_tasks;
+    boost::asio::io_service io_service;
+    std::unique_ptr<boost::asio::io_service::work> work;
+    std::vector<std::thread> threads;
+};
+}
+}
+
+#endif // WORKER_POOL_HPP
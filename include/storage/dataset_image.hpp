@@ -0,0 +1,48 @@
+#ifndef OSRM_STORAGE_DATASET_IMAGE_HPP
+#define OSRM_STORAGE_DATASET_IMAGE_HPP
+
+#include "storage/shared_datatype.hpp"
+#include "util/fingerprint.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace osrm
+{
+namespace storage
+{
+
+const constexpr char DATASET_IMAGE_MAGIC[8] = {'O', 'S', 'R', 'M', 'I', 'M', 'G', '1'};
+// Larger than the alignment of any block and a multiple of the page size
+const constexpr std::uint64_t DATASET_IMAGE_ALIGNMENT = 4096;
+
+/**
+ * A dataset image holds the same DataLayout and data blocks that osrm-datastore copies into
+ * shared memory, written to a file once so that it can be mapped read-only instead of being
+ * loaded. The blocks start at a page aligned offset so that their alignment within the file
+ * matches their alignment in the mapping.
+ *
+ *   [DatasetImageHeader][padding to data_offset][data blocks of header.layout]
+ */
+struct DatasetImageHeader
+{
+    char magic[sizeof(DATASET_IMAGE_MAGIC)];
+    util::FingerPrint fingerprint;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    DataLayout layout;
+
+    static std::uint64_t GetDataOffset()
+    {
+        return (sizeof(DatasetImageHeader) + DATASET_IMAGE_ALIGNMENT - 1) /
+               DATASET_IMAGE_ALIGNMENT * DATASET_IMAGE_ALIGNMENT;
+    }
+};
+
+static_assert(std::is_trivially_copyable<DatasetImageHeader>::value,
+              "DatasetImageHeader is written to disk as is");
+}
+}
+
+#endif
@@ -65,7 +65,8 @@ const constexpr char *block_id_to_name[] = {"NAME_CHAR_DATA",
                                             "MLD_CELL_LEVEL_OFFSETS",
                                             "MLD_GRAPH_NODE_LIST",
                                             "MLD_GRAPH_EDGE_LIST",
-                                            "MLD_GRAPH_NODE_TO_OFFSET"};
+                                            "MLD_GRAPH_NODE_TO_OFFSET",
+                                            "MLD_CELL_DURATIONS"};
 
 struct DataLayout
 {
@@ -119,6 +120,7 @@ struct DataLayout
         MLD_GRAPH_NODE_LIST,
         MLD_GRAPH_EDGE_LIST,
         MLD_GRAPH_NODE_TO_OFFSET,
+        MLD_CELL_DURATIONS,
         NUM_BLOCKS
     };
 
@@ -224,22 +226,59 @@ struct DataLayout
     }
 };
 
+// Blocks that depend on the metric and change with a traffic update. osrm-datastore --only-metric
+// loads only these into a separate region and keeps all other blocks in the current region.
+inline bool isUpdatableBlock(const DataLayout::BlockID bid)
+{
+    switch (bid)
+    {
+    case DataLayout::HSGR_CHECKSUM:
+    case DataLayout::CH_GRAPH_NODE_LIST:
+    case DataLayout::CH_GRAPH_EDGE_LIST:
+    case DataLayout::CH_CORE_MARKER:
+    case DataLayout::GEOMETRIES_FWD_WEIGHT_LIST:
+    case DataLayout::GEOMETRIES_REV_WEIGHT_LIST:
+    case DataLayout::GEOMETRIES_FWD_DURATION_LIST:
+    case DataLayout::GEOMETRIES_REV_DURATION_LIST:
+    case DataLayout::DATASOURCES_LIST:
+    case DataLayout::DATASOURCES_NAMES:
+    case DataLayout::TURN_WEIGHT_PENALTIES:
+    case DataLayout::TURN_DURATION_PENALTIES:
+    case DataLayout::MLD_CELL_WEIGHTS:
+    case DataLayout::MLD_CELL_DURATIONS:
+    case DataLayout::MLD_GRAPH_NODE_LIST:
+    case DataLayout::MLD_GRAPH_EDGE_LIST:
+    case DataLayout::MLD_GRAPH_NODE_TO_OFFSET:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Regions 1 and 2 alternately hold complete datasets, regions 3 and 4 alternately hold the
+// updatable blocks of partial updates on top of them.
 enum SharedDataType
 {
     REGION_NONE,
     REGION_1,
-    REGION_2
+    REGION_2,
+    REGION_3,
+    REGION_4
 };
 
 struct SharedDataTimestamp
 {
-    explicit SharedDataTimestamp(SharedDataType region, unsigned timestamp)
-        : region(region), timestamp(timestamp)
+    explicit SharedDataTimestamp(SharedDataType region,
+                                 unsigned timestamp,
+                                 SharedDataType updatable_region = REGION_NONE)
+        : region(region), timestamp(timestamp), updatable_region(updatable_region)
     {
     }
 
     SharedDataType region;
     unsigned timestamp;
+    // REGION_NONE if the updatable blocks are read from region
+    SharedDataType updatable_region;
 
     static constexpr const char *name = "osrm-region";
 };
@@ -252,6 +291,10 @@ inline std::string regionToString(const SharedDataType region)
         return "REGION_1";
     case REGION_2:
         return "REGION_2";
+    case REGION_3:
+        return "REGION_3";
+    case REGION_4:
+        return "REGION_4";
     case REGION_NONE:
         return "REGION_NONE";
     default:
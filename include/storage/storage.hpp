@@ -44,10 +44,17 @@ class Storage
   public:
     Storage(StorageConfig config);
 
-    int Run(int max_wait);
+    // Loads the dataset into shared memory. With only_metric only the updatable blocks are
+    // loaded into a separate region, all other blocks are used from the current dataset.
+    // With use_huge_pages the region is advised to be backed by transparent huge pages.
+    int Run(int max_wait, bool only_metric, bool use_huge_pages = false);
 
     void PopulateLayout(DataLayout &layout);
-    void PopulateData(const DataLayout &layout, char *memory_ptr);
+    // With only_updatable the blocks that are not updatable are skipped
+    void PopulateData(const DataLayout &layout, char *memory_ptr, bool only_updatable = false);
+
+    // Writes layout and data into a dataset image that can be mapped instead of loaded
+    void WriteImage(const boost::filesystem::path &image_path);
 
   private:
     StorageConfig config;
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <map>
 #include <type_traits>
@@ -16,25 +17,27 @@ namespace osrm
 namespace util
 {
 
+// Array storage that is cleared in O(1) by bumping a generation counter. Indices written in
+// an older generation are reported as not inserted.
 template <typename NodeID, typename Key> class GenerationArrayStorage
 {
     using GenerationCounter = std::uint16_t;
 
   public:
     explicit GenerationArrayStorage(std::size_t size)
-        : positions(size, 0), generation(1), generations(size, 0)
+        : generation(1), generations(size, 0), positions(size, 0)
     {
     }
 
     Key &operator[](NodeID node)
     {
-        generation[node] = generation;
+        generations[node] = generation;
         return positions[node];
     }
 
     Key peek_index(const NodeID node) const
     {
-        if (generations[node] < generation)
+        if (generations[node] != generation)
         {
             return std::numeric_limits<Key>::max();
         }
@@ -138,7 +141,10 @@ class BinaryHeap
     using WeightType = Weight;
     using DataType = Data;
 
-    explicit BinaryHeap(std::size_t maxID) : node_index(maxID) { Clear(); }
+    explicit BinaryHeap(std::size_t maxID) : max_id(maxID), node_index(maxID) { Clear(); }
+
+    // Number of node ids the heap was allocated for
+    std::size_t MaxID() const { return max_id; }
 
     void Clear()
     {
@@ -276,6 +282,7 @@ class BinaryHeap
         Weight weight;
     };
 
+    std::size_t max_id;
     std::vector<HeapNode> inserted_nodes;
     std::vector<HeapElement> heap;
     IndexStorage node_index;
@@ -0,0 +1,325 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include "osrm/json_container.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace json
+{
+
+namespace detail
+{
+
+inline void appendInteger(std::vector<char> &out, std::uint64_t value)
+{
+    char buffer[20];
+    char *begin = buffer + sizeof(buffer);
+    do
+    {
+        *--begin = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    out.insert(out.end(), begin, buffer + sizeof(buffer));
+}
+
+// Rounds a fraction in [0, 1) to an integer of micro units the way printf rounds: on the exact
+// decimal value of the double with ties to even. The product with 1e6 is rounded itself, so the
+// rounding error recovered with fma decides whenever the product lands on a half.
+inline std::uint64_t roundToMicro(const double fraction)
+{
+    constexpr double MICRO_SCALE = 1e6;
+
+    const double scaled = fraction * MICRO_SCALE;
+    const double error = std::fma(fraction, MICRO_SCALE, -scaled);
+    const double truncated = std::floor(scaled);
+    auto micro = static_cast<std::uint64_t>(truncated);
+
+    // exact, the remainder and 0.5 share the unit in the last place of scaled
+    const double remainder = scaled - truncated;
+    if (remainder < 0.25)
+        return micro;
+    const double distance = remainder - 0.5;
+    if (distance > 0 || (distance == 0 && (error > 0 || (error == 0 && micro % 2 == 1))))
+        ++micro;
+    return micro;
+}
+
+// Formats a number exactly like cast::to_string_with_precision does: six fixed decimals with
+// trailing zeros and a trailing dot removed, negative values that round to zero print as -0.
+// Values below 1e9 are split into an integral part and micro units which avoids going through
+// iostreams or printf for the common case.
+inline void appendNumber(std::vector<char> &out, const double value)
+{
+    constexpr std::uint64_t MICRO_SCALE = 1000000;
+    constexpr double MAX_SPLIT_VALUE = 1e9;
+    constexpr double MAX_INTEGRAL_VALUE = 1e15;
+
+    const double magnitude = std::abs(value);
+    if (magnitude < MAX_SPLIT_VALUE)
+    {
+        const double truncated = std::floor(magnitude);
+        auto integral = static_cast<std::uint64_t>(truncated);
+        auto fraction = roundToMicro(magnitude - truncated);
+        if (fraction == MICRO_SCALE)
+        {
+            ++integral;
+            fraction = 0;
+        }
+
+        if (std::signbit(value))
+            out.push_back('-');
+        appendInteger(out, integral);
+
+        if (fraction != 0)
+        {
+            char digits[6];
+            int length = 6;
+            while (fraction % 10 == 0)
+            {
+                fraction /= 10;
+                --length;
+            }
+            for (int i = length - 1; i >= 0; --i)
+            {
+                digits[i] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+            out.push_back('.');
+            out.insert(out.end(), digits, digits + length);
+        }
+        return;
+    }
+
+    if (magnitude < MAX_INTEGRAL_VALUE && std::trunc(value) == value)
+    {
+        if (value < 0)
+            out.push_back('-');
+        appendInteger(out, static_cast<std::uint64_t>(magnitude));
+        return;
+    }
+
+    // large, fractional or non-finite values take the slow path
+    char buffer[512];
+    const auto length = std::snprintf(buffer, sizeof(buffer), "%.6f", value);
+    BOOST_ASSERT(length > 0);
+    char *end = buffer + std::min<std::size_t>(length, sizeof(buffer) - 1);
+    if (std::memchr(buffer, '.', end - buffer) != nullptr)
+    {
+        while (*(end - 1) == '0')
+            --end;
+        if (*(end - 1) == '.')
+            --end;
+    }
+    out.insert(out.end(), buffer, end);
+}
+
+// Same escaping as util::escape_JSON but without the temporary string
+inline void appendEscaped(std::vector<char> &out, const char *begin, const char *end)
+{
+    for (; begin != end; ++begin)
+    {
+        const char letter = *begin;
+        switch (letter)
+        {
+        case '\\':
+            out.push_back('\\');
+            out.push_back('\\');
+            break;
+        case '"':
+            out.push_back('\\');
+            out.push_back('"');
+            break;
+        case '/':
+            out.push_back('\\');
+            out.push_back('/');
+            break;
+        case '\b':
+            out.push_back('\\');
+            out.push_back('b');
+            break;
+        case '\f':
+            out.push_back('\\');
+            out.push_back('f');
+            break;
+        case '\n':
+            out.push_back('\\');
+            out.push_back('n');
+            break;
+        case '\r':
+            out.push_back('\\');
+            out.push_back('r');
+            break;
+        case '\t':
+            out.push_back('\\');
+            out.push_back('t');
+            break;
+        default:
+            out.push_back(letter);
+            break;
+        }
+    }
+}
+}
+
+/**
+ * Streams JSON directly into a character buffer without building a json::Object first.
+ *
+ * Separators are inserted automatically, callers only need to balance the Start/End calls
+ * and emit a Key before every value inside an object:
+ *
+ *   writer.StartObject();
+ *   writer.Key("code");
+ *   writer.WriteString("Ok");
+ *   writer.EndObject();
+ *
+ * The buffer is appended to, so it can be reserved up front by the caller or with Reserve.
+ */
+class Writer
+{
+  public:
+    explicit Writer(std::vector<char> &out_) : out(out_), needs_separator(false) {}
+
+    void Reserve(const std::size_t additional_bytes) { out.reserve(out.size() + additional_bytes); }
+
+    void StartObject()
+    {
+        Separate();
+        out.push_back('{');
+        needs_separator = false;
+    }
+
+    void EndObject()
+    {
+        out.push_back('}');
+        needs_separator = true;
+    }
+
+    void StartArray()
+    {
+        Separate();
+        out.push_back('[');
+        needs_separator = false;
+    }
+
+    void EndArray()
+    {
+        out.push_back(']');
+        needs_separator = true;
+    }
+
+    // Keys are written verbatim like in the renderers, they are never user supplied
+    void Key(const char *key) { Key(key, std::strlen(key)); }
+    void Key(const std::string &key) { Key(key.data(), key.size()); }
+
+    void WriteString(const char *value) { WriteString(value, std::strlen(value)); }
+    void WriteString(const std::string &value) { WriteString(value.data(), value.size()); }
+    void WriteString(const char *value, const std::size_t length)
+    {
+        Separate();
+        out.push_back('"');
+        detail::appendEscaped(out, value, value + length);
+        out.push_back('"');
+        needs_separator = true;
+    }
+
+    void WriteNumber(const double value)
+    {
+        Separate();
+        detail::appendNumber(out, value);
+        needs_separator = true;
+    }
+
+    void WriteBool(const bool value)
+    {
+        if (value)
+            Literal("true", 4);
+        else
+            Literal("false", 5);
+    }
+
+    void WriteNull() { Literal("null", 4); }
+
+    // Splices an already built DOM value into the stream
+    void WriteValue(const json::Value &value)
+    {
+        mapbox::util::apply_visitor(Visitor{*this}, value);
+    }
+
+  private:
+    struct Visitor
+    {
+        void operator()(const json::String &string) const { writer.WriteString(string.value); }
+        void operator()(const json::Number &number) const { writer.WriteNumber(number.value); }
+        void operator()(const json::True &) const { writer.WriteBool(true); }
+        void operator()(const json::False &) const { writer.WriteBool(false); }
+        void operator()(const json::Null &) const { writer.WriteNull(); }
+
+        void operator()(const json::Object &object) const
+        {
+            writer.StartObject();
+            for (const auto &member : object.values)
+            {
+                writer.Key(member.first);
+                mapbox::util::apply_visitor(*this, member.second);
+            }
+            writer.EndObject();
+        }
+
+        void operator()(const json::Array &array) const
+        {
+            writer.StartArray();
+            for (const auto &value : array.values)
+            {
+                mapbox::util::apply_visitor(*this, value);
+            }
+            writer.EndArray();
+        }
+
+        Writer &writer;
+    };
+
+    void Separate()
+    {
+        if (needs_separator)
+            out.push_back(',');
+    }
+
+    void Key(const char *key, const std::size_t length)
+    {
+        Separate();
+        out.push_back('"');
+        out.insert(out.end(), key, key + length);
+        out.push_back('"');
+        out.push_back(':');
+        needs_separator = false;
+    }
+
+    void Literal(const char *literal, const std::size_t length)
+    {
+        Separate();
+        out.insert(out.end(), literal, literal + length);
+        needs_separator = true;
+    }
+
+    std::vector<char> &out;
+    bool needs_separator;
+};
+
+} // namespace json
+} // namespace util
+} // namespace osrm
+
+#endif // JSON_WRITER_HPP
@@ -4,8 +4,12 @@
 #include "util/log.hpp"
 
 #include <stxxl/mng>
+
+#include <cstdint>
+
 #ifndef _WIN32
 #include <sys/resource.h>
+#include <unistd.h>
 #endif
 
 namespace osrm
@@ -25,6 +29,20 @@ inline void DumpSTXXLStats()
 #endif
 }
 
+// Physical memory of the machine in bytes, 0 if it is not known
+inline std::uint64_t GetPhysicalMemory()
+{
+#if !defined(_WIN32) && defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+    const auto pages = ::sysconf(_SC_PHYS_PAGES);
+    const auto page_size = ::sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0)
+    {
+        return static_cast<std::uint64_t>(pages) * static_cast<std::uint64_t>(page_size);
+    }
+#endif
+    return 0;
+}
+
 inline void DumpMemoryStats()
 {
 #ifndef _WIN32
@@ -0,0 +1,50 @@
+#ifndef OSRM_UTIL_MEMORY_PLACEMENT_HPP
+#define OSRM_UTIL_MEMORY_PLACEMENT_HPP
+
+#include <cstddef>
+#include <memory>
+
+namespace osrm
+{
+namespace util
+{
+
+struct PlacedMemoryDeleter
+{
+    void operator()(char *memory) const;
+
+    std::size_t mapped_size;
+};
+
+using PlacedMemoryPtr = std::unique_ptr<char[], PlacedMemoryDeleter>;
+
+/**
+ * Allocates zeroed memory for a dataset and faults in all of its pages from the calling thread,
+ * so with the default first touch policy they are placed on the NUMA node the thread runs on.
+ *
+ * With use_huge_pages the memory is taken from the reserved huge pages (MAP_HUGETLB) of the
+ * default huge page size, which is 2 MB unless the kernel was booted with default_hugepagesz=1G.
+ * If none are reserved it falls back to transparent huge pages.
+ */
+PlacedMemoryPtr AllocatePlacedMemory(std::size_t size, bool use_huge_pages);
+
+// Asks the kernel to back the range with transparent huge pages, returns false if unsupported
+bool AdviseHugePages(void *address, std::size_t size);
+
+namespace numa
+{
+
+// Number of NUMA nodes with CPUs, 1 if the topology is not known. Nodes are numbered from 0
+// even if the kernel node ids have gaps.
+unsigned GetNumberOfNodes();
+
+// NUMA node of the CPU the calling thread currently runs on
+unsigned GetCurrentNode();
+
+// Restricts the calling thread to the CPUs of the node, returns false if that is not possible
+bool BindCurrentThreadToNode(unsigned node);
+}
+}
+}
+
+#endif
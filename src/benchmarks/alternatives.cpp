@@ -0,0 +1,102 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    const std::string algorithm = argc > 2 ? argv[2] : "CH";
+    if (algorithm == "CH")
+    {
+        config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "MLD")
+    {
+        config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        std::cerr << "Unknown algorithm " << algorithm << ", expected CH or MLD\n";
+        return EXIT_FAILURE;
+    }
+
+    OSRM osrm{config};
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    const auto benchmark = [&](const bool alternatives, const int num_requests) {
+        // Random coordinates in monaco, seeded to route the same pairs in every run
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> longitude(7.409, 7.436);
+        std::uniform_real_distribution<double> latitude(43.725, 43.751);
+
+        int num_routes = 0;
+        int num_alternatives = 0;
+        TIMER_START(routes);
+        for (int i = 0; i < num_requests; ++i)
+        {
+            RouteParameters params;
+            params.alternatives = alternatives;
+            params.overview = RouteParameters::OverviewType::False;
+            for (int j = 0; j < 2; ++j)
+            {
+                params.coordinates.push_back(FloatCoordinate{FloatLongitude{longitude(generator)},
+                                                             FloatLatitude{latitude(generator)}});
+            }
+
+            json::Object result;
+            if (osrm.Route(params, result) == Status::Ok)
+            {
+                ++num_routes;
+                if (result.values.at("routes").get<json::Array>().values.size() > 1)
+                {
+                    ++num_alternatives;
+                }
+            }
+        }
+        TIMER_STOP(routes);
+
+        std::cout << algorithm << (alternatives ? " with" : " without") << " alternatives: "
+                  << (TIMER_MSEC(routes) / num_requests) << "ms/req, " << num_alternatives
+                  << " alternatives for " << num_routes << " routes" << std::endl;
+    };
+
+    benchmark(false, 1000);
+    benchmark(true, 1000);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
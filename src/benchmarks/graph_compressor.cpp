@@ -0,0 +1,127 @@
+#include "extractor/compressed_edge_container.hpp"
+#include "extractor/graph_compressor.hpp"
+#include "extractor/restriction_map.hpp"
+#include "util/node_based_graph.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <tbb/task_scheduler_init.h>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <cstdlib>
+
+using namespace osrm;
+
+namespace
+{
+using InputEdge = util::NodeBasedDynamicGraph::InputEdge;
+
+// Grid of size x size intersections where every street between two of them is split into
+// shape_points + 1 segments, roughly what the node based graph of a road network looks like
+std::vector<InputEdge> makeStreetGrid(const NodeID size, const NodeID shape_points)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<EdgeWeight> weight(1, 100);
+
+    std::vector<InputEdge> edges;
+    const auto addSegment = [&](const NodeID from, const NodeID to) {
+        // src, tgt, weight, edge_id, name_id, fwd, bkwd, roundabout, circular, startpoint,
+        // local access, split edge, travel_mode
+        InputEdge edge{from,
+                       to,
+                       weight(generator),
+                       SPECIAL_EDGEID,
+                       0,
+                       0,
+                       false,
+                       false,
+                       false,
+                       false,
+                       true,
+                       TRAVEL_MODE_DRIVING,
+                       INVALID_LANE_DESCRIPTIONID};
+        edge.data.duration = edge.data.weight;
+        edges.push_back(edge);
+        std::swap(edge.source, edge.target);
+        edges.push_back(edge);
+    };
+
+    NodeID next_node = size * size;
+    const auto addStreet = [&](const NodeID from, const NodeID to) {
+        NodeID previous = from;
+        for (NodeID point = 0; point < shape_points; ++point)
+        {
+            addSegment(previous, next_node);
+            previous = next_node++;
+        }
+        addSegment(previous, to);
+    };
+
+    for (NodeID row = 0; row < size; ++row)
+    {
+        for (NodeID column = 0; column < size; ++column)
+        {
+            const auto intersection = row * size + column;
+            if (column + 1 < size)
+                addStreet(intersection, intersection + 1);
+            if (row + 1 < size)
+                addStreet(intersection, intersection + size);
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+    return edges;
+}
+}
+
+// Compares the sequential and the parallel compression of degree 2 chains
+int main(int argc, const char *argv[]) try
+{
+    const NodeID size = argc > 1 ? std::stoul(argv[1]) : 400;
+    const NodeID shape_points = argc > 2 ? std::stoul(argv[2]) : 8;
+    const int threads = argc > 3 ? std::stoi(argv[3]) : tbb::task_scheduler_init::automatic;
+
+    tbb::task_scheduler_init init(threads);
+
+    const auto edges = makeStreetGrid(size, shape_points);
+    const NodeID number_of_nodes = size * size + 2 * size * (size - 1) * shape_points;
+    std::cout << "Graph with " << number_of_nodes << " nodes and " << edges.size() << " edges"
+              << std::endl;
+
+    const auto benchmark = [&](const bool parallel) {
+        std::unordered_set<NodeID> barrier_nodes;
+        std::unordered_set<NodeID> traffic_lights;
+        extractor::RestrictionMap restriction_map;
+        extractor::CompressedEdgeContainer container;
+        util::NodeBasedDynamicGraph graph(number_of_nodes, edges);
+        extractor::GraphCompressor compressor;
+
+        TIMER_START(compression);
+        if (parallel)
+            compressor.CompressParallel(
+                barrier_nodes, traffic_lights, restriction_map, graph, container);
+        else
+            compressor.Compress(barrier_nodes, traffic_lights, restriction_map, graph, container);
+        TIMER_STOP(compression);
+
+        std::cout << (parallel ? "parallel: " : "sequential: ") << TIMER_MSEC(compression)
+                  << "ms, " << graph.GetNumberOfEdges() << " edges left" << std::endl;
+    };
+
+    benchmark(false);
+    benchmark(true);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,147 @@
+#include "util/binary_heap.hpp"
+#include "util/static_graph.hpp"
+#include "util/timing_util.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace benchmarks
+{
+
+// Choosen by a fair W20 dice roll (this value is completely arbitrary)
+constexpr unsigned RANDOM_SEED = 13;
+
+struct EdgeData
+{
+    EdgeWeight weight;
+};
+
+using Graph = util::StaticGraph<EdgeData>;
+using Edge = util::static_graph_details::SortableEdgeWithData<EdgeData>;
+
+// Grid with random edge weights, a rough stand-in for a road network
+Graph makeGrid(const NodeID width, const NodeID height)
+{
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<EdgeWeight> weights(1, 100);
+
+    std::vector<Edge> edges;
+    const auto add_edge = [&](const NodeID from, const NodeID to) {
+        const auto weight = weights(generator);
+        edges.push_back(Edge{from, to, weight});
+        edges.push_back(Edge{to, from, weight});
+    };
+    for (NodeID y = 0; y < height; ++y)
+    {
+        for (NodeID x = 0; x < width; ++x)
+        {
+            const NodeID node = y * width + x;
+            if (x + 1 < width)
+                add_edge(node, node + 1);
+            if (y + 1 < height)
+                add_edge(node, node + width);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    return Graph(width * height, edges);
+}
+
+// Runs point-to-point Dijkstra queries and returns the sum of the shortest path weights
+template <typename Heap>
+EdgeWeight runQueries(const Graph &graph, const std::vector<std::pair<NodeID, NodeID>> &queries)
+{
+    Heap heap(graph.GetNumberOfNodes());
+
+    EdgeWeight checksum = 0;
+    for (const auto &query : queries)
+    {
+        heap.Clear();
+        heap.Insert(query.first, 0, query.first);
+        while (!heap.Empty())
+        {
+            const auto node = heap.DeleteMin();
+            const auto weight = heap.GetKey(node);
+            if (node == query.second)
+            {
+                checksum += weight;
+                break;
+            }
+
+            for (const auto edge : graph.GetAdjacentEdgeRange(node))
+            {
+                const auto to = graph.GetTarget(edge);
+                const auto to_weight = weight + graph.GetEdgeData(edge).weight;
+                if (!heap.WasInserted(to))
+                {
+                    heap.Insert(to, to_weight, node);
+                }
+                else if (to_weight < heap.GetKey(to))
+                {
+                    heap.GetData(to) = node;
+                    heap.DecreaseKey(to, to_weight);
+                }
+            }
+        }
+    }
+
+    return checksum;
+}
+
+template <typename Storage>
+void benchmark(const std::string &name,
+               const Graph &graph,
+               const std::vector<std::pair<NodeID, NodeID>> &queries)
+{
+    using Heap = util::BinaryHeap<NodeID, NodeID, EdgeWeight, NodeID, Storage>;
+
+    TIMER_START(queries);
+    const auto checksum = runQueries<Heap>(graph, queries);
+    TIMER_STOP(queries);
+
+    std::cout << name << ": " << (TIMER_MSEC(queries) / queries.size()) << "ms/query"
+              << " (checksum " << checksum << ")" << std::endl;
+}
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+    using namespace osrm;
+    using namespace osrm::benchmarks;
+
+    const NodeID size = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const std::size_t num_queries = argc > 2 ? std::stoul(argv[2]) : 100;
+
+    const auto graph = makeGrid(size, size);
+
+    std::mt19937 generator(RANDOM_SEED);
+    std::uniform_int_distribution<NodeID> nodes(0, graph.GetNumberOfNodes() - 1);
+    std::vector<std::pair<NodeID, NodeID>> queries;
+    for (std::size_t i = 0; i < num_queries; ++i)
+    {
+        queries.emplace_back(nodes(generator), nodes(generator));
+    }
+
+    std::cout << "Running " << num_queries << " queries on a " << size << "x" << size
+              << " grid" << std::endl;
+
+    benchmark<util::UnorderedMapStorage<NodeID, int>>("UnorderedMapStorage", graph, queries);
+    benchmark<util::GenerationArrayStorage<NodeID, int>>("GenerationArrayStorage", graph, queries);
+    benchmark<util::ArrayStorage<NodeID, int>>("ArrayStorage", graph, queries);
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
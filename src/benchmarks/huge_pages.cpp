@@ -0,0 +1,179 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+
+// Counts the data TLB misses of loads on the calling thread
+class TLBMissCounter
+{
+  public:
+    TLBMissCounter()
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HW_CACHE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+
+        descriptor = static_cast<int>(::syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+        if (descriptor < 0)
+        {
+            std::cerr << "Could not open the dTLB miss counter (" << std::strerror(errno)
+                      << "), check /proc/sys/kernel/perf_event_paranoid\n";
+        }
+    }
+
+    ~TLBMissCounter()
+    {
+        if (descriptor >= 0)
+            ::close(descriptor);
+    }
+
+    bool Valid() const { return descriptor >= 0; }
+
+    void Start()
+    {
+        if (!Valid())
+            return;
+        ::ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    std::uint64_t Stop()
+    {
+        std::uint64_t misses = 0;
+        if (!Valid())
+            return misses;
+        ::ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        if (::read(descriptor, &misses, sizeof(misses)) != sizeof(misses))
+            misses = 0;
+        return misses;
+    }
+
+  private:
+    int descriptor;
+};
+}
+
+// Compares the data TLB misses of random table queries with the dataset loaded into regular and
+// into huge pages. Reserve huge pages first to measure MAP_HUGETLB instead of transparent ones:
+//   echo 2048 > /proc/sys/vm/nr_hugepages
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    const std::string algorithm = argc > 2 ? argv[2] : "CH";
+    if (algorithm == "CH")
+    {
+        config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "MLD")
+    {
+        config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        std::cerr << "Unknown algorithm " << algorithm << ", expected CH or MLD\n";
+        return EXIT_FAILURE;
+    }
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    const auto benchmark = [&](const bool use_huge_pages) {
+        config.use_huge_pages = use_huge_pages;
+        OSRM osrm{config};
+
+        // Same random coordinates in monaco for both runs
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> longitude(7.409, 7.436);
+        std::uniform_real_distribution<double> latitude(43.725, 43.751);
+
+        const std::size_t num_coordinates = 250;
+        const int num_requests = 10;
+
+        TableParameters params;
+        for (std::size_t i = 0; i < num_coordinates; ++i)
+        {
+            params.coordinates.push_back(FloatCoordinate{FloatLongitude{longitude(generator)},
+                                                         FloatLatitude{latitude(generator)}});
+        }
+
+        TLBMissCounter counter;
+        counter.Start();
+        TIMER_START(tables);
+        for (int i = 0; i < num_requests; ++i)
+        {
+            json::Object result;
+            const auto rc = osrm.Table(params, result);
+            if (rc != Status::Ok)
+            {
+                return false;
+            }
+        }
+        TIMER_STOP(tables);
+        const auto misses = counter.Stop();
+
+        std::cout << algorithm << (use_huge_pages ? " huge pages: " : " regular pages: ")
+                  << (TIMER_MSEC(tables) / num_requests) << "ms/req";
+        if (counter.Valid())
+        {
+            std::cout << " " << (misses / num_requests) << " dTLB load misses/req";
+        }
+        std::cout << std::endl;
+        return true;
+    };
+
+    if (!benchmark(false) || !benchmark(true))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,104 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/table_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+#include <cstdlib>
+
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " data.osrm [CH|MLD] [max table threads]\n";
+        return EXIT_FAILURE;
+    }
+
+    using namespace osrm;
+
+    // Configure based on a .osrm base path, and no datasets in shared mem from osrm-datastore
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+
+    const std::string algorithm = argc > 2 ? argv[2] : "CH";
+    if (algorithm == "CH")
+    {
+        config.algorithm = EngineConfig::Algorithm::CH;
+    }
+    else if (algorithm == "MLD")
+    {
+        config.algorithm = EngineConfig::Algorithm::MLD;
+    }
+    else
+    {
+        std::cerr << "Unknown algorithm " << algorithm << ", expected CH or MLD\n";
+        return EXIT_FAILURE;
+    }
+
+    config.max_table_threads = argc > 3 ? std::stoi(argv[3]) : 1;
+
+    OSRM osrm{config};
+
+    using osrm::util::FloatCoordinate;
+    using osrm::util::FloatLatitude;
+    using osrm::util::FloatLongitude;
+
+    // Random coordinates in monaco, seeded to make runs comparable across algorithms
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> longitude(7.409, 7.436);
+    std::uniform_real_distribution<double> latitude(43.725, 43.751);
+
+    const auto benchmark = [&](const std::size_t num_coordinates, const int num_requests) {
+        TableParameters params;
+        for (std::size_t i = 0; i < num_coordinates; ++i)
+        {
+            params.coordinates.push_back(FloatCoordinate{FloatLongitude{longitude(generator)},
+                                                         FloatLatitude{latitude(generator)}});
+        }
+
+        TIMER_START(tables);
+        for (int i = 0; i < num_requests; ++i)
+        {
+            json::Object result;
+            const auto rc = osrm.Table(params, result);
+            if (rc != Status::Ok ||
+                result.values.at("durations").get<json::Array>().values.size() != num_coordinates)
+            {
+                return false;
+            }
+        }
+        TIMER_STOP(tables);
+
+        const auto num_entries = num_coordinates * num_coordinates;
+        std::cout << algorithm << " (" << config.max_table_threads << " threads) "
+                  << num_coordinates << "x" << num_coordinates << ": "
+                  << (TIMER_MSEC(tables) / num_requests) << "ms/req "
+                  << (num_entries * num_requests / TIMER_SEC(tables)) << " entries/s"
+                  << std::endl;
+        return true;
+    };
+
+    if (!benchmark(100, 10) || !benchmark(1000, 1))
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -12,9 +12,16 @@
 
 #include "updater/updater.hpp"
 
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/log.hpp"
 #include "util/timing_util.hpp"
 
+#include <boost/filesystem/operations.hpp>
+#include <boost/optional.hpp>
+
+#include <vector>
+
 namespace osrm
 {
 namespace customizer
@@ -95,6 +102,80 @@ auto LoadAndUpdateEdgeExpandedGraph(const CustomizationConfig &config,
     return edge_based_graph;
 }
 
+// Returns the nodes with adjacent edges that changed their weight or duration between both
+// graphs. If the graphs have a different topology boost::none is returned.
+template <typename Graph>
+boost::optional<std::vector<NodeID>> GetUpdatedNodes(const Graph &previous_graph,
+                                                     const Graph &graph)
+{
+    if (previous_graph.GetNumberOfNodes() != graph.GetNumberOfNodes() ||
+        previous_graph.GetNumberOfEdges() != graph.GetNumberOfEdges())
+    {
+        return boost::none;
+    }
+
+    std::vector<NodeID> updated_nodes;
+    for (auto node : util::irange(0u, graph.GetNumberOfNodes()))
+    {
+        const auto previous_edges = previous_graph.GetAdjacentEdgeRange(node);
+        const auto edges = graph.GetAdjacentEdgeRange(node);
+        if (previous_edges.size() != edges.size())
+        {
+            return boost::none;
+        }
+
+        bool updated = false;
+        auto previous_edge = previous_edges.begin();
+        for (auto edge : edges)
+        {
+            const auto &previous_data = previous_graph.GetEdgeData(*previous_edge);
+            const auto &data = graph.GetEdgeData(edge);
+            if (previous_graph.GetTarget(*previous_edge) != graph.GetTarget(edge) ||
+                previous_data.forward != data.forward || previous_data.backward != data.backward)
+            {
+                return boost::none;
+            }
+            updated = updated || previous_data.weight != data.weight ||
+                      previous_data.duration != data.duration;
+            ++previous_edge;
+        }
+
+        if (updated)
+        {
+            updated_nodes.push_back(node);
+        }
+    }
+
+    return updated_nodes;
+}
+
+// The .cells file stores the checksum of the .mldgr file it was customized with. osrm-partition
+// resets it, so a mismatch means the cells are not customized for the previous graph.
+template <typename Graph>
+boost::optional<std::vector<NodeID>>
+LoadUpdatedNodes(const CustomizationConfig &config,
+                 const partition::io::CellStorageHeader &header,
+                 const Graph &graph)
+{
+    if (!boost::filesystem::exists(config.mld_graph_path) || header.graph_checksum == 0 ||
+        header.graph_checksum != partition::io::checksum(config.mld_graph_path))
+    {
+        util::Log(logWARNING) << "No previous customization found, customizing all cells";
+        return boost::none;
+    }
+
+    Graph previous_graph;
+    partition::io::read(config.mld_graph_path, previous_graph);
+
+    auto updated_nodes = GetUpdatedNodes(previous_graph, graph);
+    if (!updated_nodes)
+    {
+        util::Log(logWARNING) << "Previous customization used a different graph, customizing all "
+                                 "cells";
+    }
+    return updated_nodes;
+}
+
 int Customizer::Run(const CustomizationConfig &config)
 {
     TIMER_START(loading_data);
@@ -105,26 +186,46 @@ int Customizer::Run(const CustomizationConfig &config)
     auto edge_based_graph = LoadAndUpdateEdgeExpandedGraph(config, mlp);
 
     partition::CellStorage storage;
-    partition::io::read(config.mld_storage_path, storage);
+    partition::io::CellStorageHeader cells_header;
+    partition::io::read(config.mld_storage_path, storage, cells_header);
+    if (cells_header.partition_checksum != partition::io::checksum(config.mld_partition_path))
+    {
+        throw util::exception(config.mld_storage_path.string() + " does not belong to " +
+                              config.mld_partition_path.string() +
+                              ", please re-run osrm-partition" + SOURCE_REF);
+    }
     TIMER_STOP(loading_data);
     util::Log() << "Loading partition data took " << TIMER_SEC(loading_data) << " seconds";
 
     TIMER_START(cell_customize);
     CellCustomizer customizer(mlp);
-    customizer.Customize(*edge_based_graph, storage);
+    const auto updated_nodes = config.incremental
+                                   ? LoadUpdatedNodes(config, cells_header, *edge_based_graph)
+                                   : boost::optional<std::vector<NodeID>>{};
+    if (updated_nodes)
+    {
+        util::Log() << "Customizing cells of " << updated_nodes->size() << " updated nodes";
+        customizer.Customize(*edge_based_graph, storage, *updated_nodes);
+    }
+    else
+    {
+        customizer.Customize(*edge_based_graph, storage);
+    }
     TIMER_STOP(cell_customize);
     util::Log() << "Cells customization took " << TIMER_SEC(cell_customize) << " seconds";
 
-    TIMER_START(writing_mld_data);
-    partition::io::write(config.mld_storage_path, storage);
-    TIMER_STOP(writing_mld_data);
-    util::Log() << "MLD customization writing took " << TIMER_SEC(writing_mld_data) << " seconds";
-
+    // the graph is written first so the cells can record its checksum
     TIMER_START(writing_graph);
     partition::io::write(config.mld_graph_path, *edge_based_graph);
     TIMER_STOP(writing_graph);
     util::Log() << "Graph writing took " << TIMER_SEC(writing_graph) << " seconds";
 
+    TIMER_START(writing_mld_data);
+    cells_header.graph_checksum = partition::io::checksum(config.mld_graph_path);
+    partition::io::write(config.mld_storage_path, storage, cells_header);
+    TIMER_STOP(writing_mld_data);
+    util::Log() << "MLD customization writing took " << TIMER_SEC(writing_mld_data) << " seconds";
+
     CellStorageStatistics(*edge_based_graph, mlp, storage);
 
     return 0;
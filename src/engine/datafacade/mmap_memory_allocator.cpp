@@ -0,0 +1,93 @@
+#include "engine/datafacade/mmap_memory_allocator.hpp"
+#include "storage/dataset_image.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/fingerprint.hpp"
+#include "util/log.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+MMapMemoryAllocator::MMapMemoryAllocator(const storage::StorageConfig &config)
+{
+    const auto &image_path = config.dataset_image_path;
+    try
+    {
+        mapped_image.open(image_path);
+    }
+    catch (const std::exception &exc)
+    {
+        throw util::exception("Could not map dataset image " + image_path.string() + ": " +
+                              exc.what() + ". Create it with osrm-datastore --image." +
+                              SOURCE_REF);
+    }
+
+    storage::DatasetImageHeader header;
+    if (mapped_image.size() < sizeof(header))
+    {
+        throw util::exception("Dataset image " + image_path.string() + " is truncated" +
+                              SOURCE_REF);
+    }
+    std::memcpy(&header, mapped_image.data(), sizeof(header));
+
+    if (!std::equal(storage::DATASET_IMAGE_MAGIC,
+                    storage::DATASET_IMAGE_MAGIC + sizeof(storage::DATASET_IMAGE_MAGIC),
+                    header.magic))
+    {
+        throw util::exception(image_path.string() + " is not a dataset image" + SOURCE_REF);
+    }
+    if (!header.fingerprint.IsValid() ||
+        !util::FingerPrint::GetValid().IsDataCompatible(header.fingerprint))
+    {
+        throw util::exception("Dataset image " + image_path.string() +
+                              " was written by an incompatible version, please recreate it" +
+                              SOURCE_REF);
+    }
+    if (header.data_offset % storage::DATASET_IMAGE_ALIGNMENT != 0 ||
+        header.data_size != header.layout.GetSizeOfLayout() ||
+        mapped_image.size() < header.data_offset + header.data_size)
+    {
+        throw util::exception("Dataset image " + image_path.string() + " is truncated" +
+                              SOURCE_REF);
+    }
+
+    // the image is not updated with the files it was written from
+    const auto image_time = boost::filesystem::last_write_time(image_path);
+    for (const auto &path : {config.hsgr_data_path,
+                             config.mld_graph_path,
+                             config.mld_storage_path,
+                             config.geometries_path,
+                             config.timestamp_path})
+    {
+        if (boost::filesystem::exists(path) &&
+            boost::filesystem::last_write_time(path) > image_time)
+        {
+            util::Log(logWARNING) << path.string() << " is newer than the dataset image "
+                                  << image_path.string() << ", the image might be outdated";
+        }
+    }
+
+    layout = header.layout;
+    // the data facades only read from the blocks, the mapping stays read-only
+    memory = const_cast<char *>(mapped_image.data()) + header.data_offset;
+}
+
+MMapMemoryAllocator::~MMapMemoryAllocator() {}
+
+storage::DataLayout &MMapMemoryAllocator::GetLayout() { return layout; }
+char *MMapMemoryAllocator::GetMemory() { return memory; }
+
+} // namespace datafacade
+} // namespace engine
+} // namespace osrm
@@ -10,7 +10,8 @@ namespace engine
 namespace datafacade
 {
 
-ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config)
+ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &config,
+                                               const bool use_huge_pages)
 {
     storage::Storage storage(config);
 
@@ -19,7 +20,8 @@ ProcessMemoryAllocator::ProcessMemoryAllocator(const storage::StorageConfig &con
     storage.PopulateLayout(*internal_layout);
 
     // Allocate the memory block, then load data from files into it
-    internal_memory = std::make_unique<char[]>(internal_layout->GetSizeOfLayout());
+    internal_memory =
+        util::AllocatePlacedMemory(internal_layout->GetSizeOfLayout(), use_huge_pages);
     storage.PopulateData(*internal_layout, internal_memory.get());
 }
 
@@ -10,12 +10,22 @@ namespace engine
 namespace datafacade
 {
 
-SharedMemoryAllocator::SharedMemoryAllocator(storage::SharedDataType data_region)
+SharedMemoryAllocator::SharedMemoryAllocator(storage::SharedDataType data_region,
+                                             storage::SharedDataType updatable_region)
 {
     util::Log(logDEBUG) << "Loading new data for region " << regionToString(data_region);
 
     BOOST_ASSERT(storage::SharedMemory::RegionExists(data_region));
     m_large_memory = storage::makeSharedMemory(data_region);
+
+    if (updatable_region != storage::REGION_NONE)
+    {
+        util::Log(logDEBUG) << "Loading updated metric for region "
+                            << regionToString(updatable_region);
+
+        BOOST_ASSERT(storage::SharedMemory::RegionExists(updatable_region));
+        m_updatable_memory = storage::makeSharedMemory(updatable_region);
+    }
 }
 
 SharedMemoryAllocator::~SharedMemoryAllocator() {}
@@ -29,6 +39,20 @@ char *SharedMemoryAllocator::GetMemory()
     return reinterpret_cast<char *>(m_large_memory->Ptr()) + sizeof(storage::DataLayout);
 }
 
+storage::DataLayout &SharedMemoryAllocator::GetUpdatableLayout()
+{
+    if (!m_updatable_memory)
+        return GetLayout();
+    return *reinterpret_cast<storage::DataLayout *>(m_updatable_memory->Ptr());
+}
+
+char *SharedMemoryAllocator::GetUpdatableMemory()
+{
+    if (!m_updatable_memory)
+        return GetMemory();
+    return reinterpret_cast<char *>(m_updatable_memory->Ptr()) + sizeof(storage::DataLayout);
+}
+
 } // namespace datafacade
 } // namespace engine
 } // namespace osrm
@@ -23,9 +23,16 @@ bool EngineConfig::IsValid() const
                               unlimited_or_more_than(max_locations_map_matching, 2) &&
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
-                              unlimited_or_more_than(max_results_nearest, 0);
+                              unlimited_or_more_than(max_results_nearest, 0) &&
+                              unlimited_or_more_than(max_routes_batch, 0) &&
+                              max_table_threads > 0 && max_batch_threads > 0;
 
-    return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) && limits_valid;
+    // huge pages and replicas only apply to datasets loaded into process memory
+    const bool placement_valid =
+        (!use_huge_pages && !use_numa_replicas) || (!use_shared_memory && !use_mmap);
+
+    return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) &&
+           limits_valid && placement_valid;
 }
 }
 }
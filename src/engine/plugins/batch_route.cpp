@@ -0,0 +1,120 @@
+#include "engine/plugins/batch_route.hpp"
+
+#include "engine/api/batch_route_api.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+#include "engine/routing_algorithms/parallel_searches.hpp"
+#include "engine/status.hpp"
+#include "util/json_container.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/assert.hpp>
+
+#include <string>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+namespace plugins
+{
+
+BatchRoutePlugin::BatchRoutePlugin(const int max_routes_batch, const int max_batch_threads)
+    : max_routes_batch(max_routes_batch), max_batch_threads(max_batch_threads)
+{
+}
+
+template <typename ResultT>
+Status
+BatchRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                                const RoutingAlgorithmsInterface &algorithms,
+                                const api::BatchRouteParameters &params,
+                                ResultT &result) const
+{
+    BOOST_ASSERT(params.IsValid());
+
+    if (!algorithms.HasDirectShortestPathSearch() && !algorithms.HasShortestPathSearch())
+    {
+        return Error(
+            "NotImplemented",
+            "Direct shortest path search is not implemented for the chosen search algorithm.",
+            result);
+    }
+
+    const auto number_of_routes = params.coordinates.size() / 2;
+    if (max_routes_batch > 0 && static_cast<int>(number_of_routes) > max_routes_batch)
+    {
+        return Error("TooBig",
+                     "Number of routes " + std::to_string(number_of_routes) +
+                         " is higher than current maximum (" + std::to_string(max_routes_batch) +
+                         ")",
+                     result);
+    }
+
+    if (!CheckAllCoordinates(params.coordinates))
+    {
+        return Error("InvalidValue", "Invalid coordinate value.", result);
+    }
+
+    const bool continue_straight_at_waypoint =
+        params.continue_straight ? *params.continue_straight : facade.GetContinueStraightDefault();
+
+    api::BatchRouteAPI batch_route_api{facade, params};
+    api::BatchRouteAPI::RouteSummaries summaries(number_of_routes);
+
+    // Pairs that can not be snapped or have no route between them are left empty instead of
+    // failing the whole batch
+    const auto route_pair = [&](const std::size_t index) {
+        const std::vector<PhantomNodePair> phantom_node_pairs = {
+            GetPhantomNodePair(facade, params, 2 * index),
+            GetPhantomNodePair(facade, params, 2 * index + 1)};
+        if (!phantom_node_pairs.front().first.IsValid() ||
+            !phantom_node_pairs.back().first.IsValid())
+        {
+            return;
+        }
+
+        const auto snapped_phantoms = SnapPhantomNodes(phantom_node_pairs);
+        PhantomNodes phantom_nodes{snapped_phantoms.front(), snapped_phantoms.back()};
+        // same as for the first leg of a route request
+        if (phantom_nodes.source_phantom.forward_segment_id.id != SPECIAL_SEGMENTID)
+        {
+            phantom_nodes.source_phantom.forward_segment_id.enabled |=
+                !continue_straight_at_waypoint;
+        }
+        if (phantom_nodes.source_phantom.reverse_segment_id.id != SPECIAL_SEGMENTID)
+        {
+            phantom_nodes.source_phantom.reverse_segment_id.enabled |=
+                !continue_straight_at_waypoint;
+        }
+
+        const auto raw_route =
+            algorithms.HasDirectShortestPathSearch()
+                ? algorithms.DirectShortestPathSearch(phantom_nodes)
+                : algorithms.ShortestPathSearch({phantom_nodes}, params.continue_straight);
+        if (raw_route.is_valid())
+        {
+            summaries[index] = batch_route_api.MakeSummary(raw_route);
+        }
+    };
+    routing_algorithms::runSearches(number_of_routes, max_batch_threads, route_pair);
+
+    batch_route_api.MakeResponse(summaries, result);
+
+    return Status::Ok;
+}
+
+template Status
+BatchRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                                const RoutingAlgorithmsInterface &algorithms,
+                                const api::BatchRouteParameters &params,
+                                util::json::Object &result) const;
+
+template Status
+BatchRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                                const RoutingAlgorithmsInterface &algorithms,
+                                const api::BatchRouteParameters &params,
+                                util::json::Writer &result) const;
+}
+}
+}
@@ -109,10 +109,11 @@ void filterCandidates(const std::vector<util::Coordinate> &coordinates,
     }
 }
 
+template <typename ResultT>
 Status MatchPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                                   const RoutingAlgorithmsInterface &algorithms,
                                   const api::MatchParameters &parameters,
-                                  util::json::Object &json_result) const
+                                  ResultT &json_result) const
 {
     if (!algorithms.HasMapMatching())
     {
@@ -243,6 +244,24 @@ Status MatchPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryData
 
     return Status::Ok;
 }
+
+template Status
+MatchPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::MatchParameters &parameters,
+                           util::json::Object &json_result) const;
+
+template Status
+MatchPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::MatchParameters &parameters,
+                           util::json::Writer &json_result) const;
+
+template Status
+MatchPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::MatchParameters &parameters,
+                           protozero::pbf_writer &json_result) const;
 }
 }
 }
@@ -19,11 +19,12 @@ namespace plugins
 
 NearestPlugin::NearestPlugin(const int max_results_) : max_results{max_results_} {}
 
+template <typename ResultT>
 Status
 NearestPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                              const RoutingAlgorithmsInterface & /*algorithms*/,
                              const api::NearestParameters &params,
-                             util::json::Object &json_result) const
+                             ResultT &json_result) const
 {
     BOOST_ASSERT(params.IsValid());
 
@@ -57,6 +58,18 @@ NearestPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacad
 
     return Status::Ok;
 }
+
+template Status
+NearestPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                             const RoutingAlgorithmsInterface &algorithms,
+                             const api::NearestParameters &params,
+                             util::json::Object &json_result) const;
+
+template Status
+NearestPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                             const RoutingAlgorithmsInterface &algorithms,
+                             const api::NearestParameters &params,
+                             protozero::pbf_writer &json_result) const;
 }
 }
 }
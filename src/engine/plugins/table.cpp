@@ -23,15 +23,17 @@ namespace engine
 namespace plugins
 {
 
-TablePlugin::TablePlugin(const int max_locations_distance_table)
-    : max_locations_distance_table(max_locations_distance_table)
+TablePlugin::TablePlugin(const int max_locations_distance_table, const int max_table_threads)
+    : max_locations_distance_table(max_locations_distance_table),
+      max_table_threads(max_table_threads)
 {
 }
 
+template <typename ResultT>
 Status TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                                   const RoutingAlgorithmsInterface &algorithms,
                                   const api::TableParameters &params,
-                                  util::json::Object &result) const
+                                  ResultT &result) const
 {
     if (!algorithms.HasManyToManySearch())
     {
@@ -68,19 +70,42 @@ Status TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryData
     }
 
     auto snapped_phantoms = SnapPhantomNodes(GetPhantomNodes(facade, params));
-    auto result_table =
-        algorithms.ManyToManySearch(snapped_phantoms, params.sources, params.destinations);
-
-    if (result_table.empty())
+    const bool calculate_distance =
+        params.annotations & api::TableParameters::AnnotationsType::Distance;
+    auto result_tables = algorithms.ManyToManySearch(snapped_phantoms,
+                                                     params.sources,
+                                                     params.destinations,
+                                                     max_table_threads,
+                                                     calculate_distance);
+
+    if (result_tables.first.empty())
     {
         return Error("NoTable", "No table found", result);
     }
 
     api::TableAPI table_api{facade, params};
-    table_api.MakeResponse(result_table, snapped_phantoms, result);
+    table_api.MakeResponse(result_tables.first, result_tables.second, snapped_phantoms, result);
 
     return Status::Ok;
 }
+
+template Status
+TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::TableParameters &params,
+                           util::json::Object &result) const;
+
+template Status
+TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::TableParameters &params,
+                           util::json::Writer &result) const;
+
+template Status
+TablePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                           const RoutingAlgorithmsInterface &algorithms,
+                           const api::TableParameters &params,
+                           protozero::pbf_writer &result) const;
 }
 }
 }
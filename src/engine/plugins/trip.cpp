@@ -142,10 +142,11 @@ void ManipulateTableForFSE(const std::size_t source_id,
     //*********  End of changes to table  *************************************
 }
 
+template <typename ResultT>
 Status TripPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                                  const RoutingAlgorithmsInterface &algorithms,
                                  const api::TripParameters &parameters,
-                                 util::json::Object &json_result) const
+                                 ResultT &json_result) const
 {
     if (!algorithms.HasShortestPathSearch())
     {
@@ -214,7 +215,8 @@ Status TripPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataF
 
     // compute the duration table of all phantom nodes
     auto result_table = util::DistTableWrapper<EdgeWeight>(
-        algorithms.ManyToManySearch(snapped_phantoms, {}, {}), number_of_locations);
+        algorithms.ManyToManySearch(snapped_phantoms, {}, {}, 1, false).first,
+        number_of_locations);
 
     if (result_table.size() == 0)
     {
@@ -274,6 +276,18 @@ Status TripPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataF
 
     return Status::Ok;
 }
+
+template Status
+TripPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                          const RoutingAlgorithmsInterface &algorithms,
+                          const api::TripParameters &parameters,
+                          util::json::Object &json_result) const;
+
+template Status
+TripPlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                          const RoutingAlgorithmsInterface &algorithms,
+                          const api::TripParameters &parameters,
+                          protozero::pbf_writer &json_result) const;
 }
 }
 }
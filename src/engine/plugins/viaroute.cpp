@@ -26,11 +26,12 @@ ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute)
 {
 }
 
+template <typename ResultT>
 Status
 ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
                               const RoutingAlgorithmsInterface &algorithms,
                               const api::RouteParameters &route_parameters,
-                              util::json::Object &json_result) const
+                              ResultT &json_result) const
 {
     BOOST_ASSERT(route_parameters.IsValid());
 
@@ -145,6 +146,24 @@ ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFaca
 
     return Status::Ok;
 }
+
+template Status
+ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                              const RoutingAlgorithmsInterface &algorithms,
+                              const api::RouteParameters &route_parameters,
+                              util::json::Object &json_result) const;
+
+template Status
+ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                              const RoutingAlgorithmsInterface &algorithms,
+                              const api::RouteParameters &route_parameters,
+                              util::json::Writer &json_result) const;
+
+template Status
+ViaRoutePlugin::HandleRequest(const datafacade::ContiguousInternalMemoryDataFacadeBase &facade,
+                              const RoutingAlgorithmsInterface &algorithms,
+                              const api::RouteParameters &route_parameters,
+                              protozero::pbf_writer &json_result) const;
 }
 }
 }
@@ -1,5 +1,6 @@
 #include "engine/routing_algorithms/alternative_path.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
 
 #include "util/integer_range.hpp"
 
@@ -19,16 +20,12 @@ namespace engine
 {
 namespace routing_algorithms
 {
-namespace ch
-{
-
 namespace
 {
 const double constexpr VIAPATH_ALPHA = 0.10;
 const double constexpr VIAPATH_EPSILON = 0.15; // alternative at most 15% longer
 const double constexpr VIAPATH_GAMMA = 0.75;   // alternative shares at most 75% with the shortest.
 
-using QueryHeap = SearchEngineData<Algorithm>::QueryHeap;
 using SearchSpaceEdge = std::pair<NodeID, NodeID>;
 
 struct RankedCandidateNode
@@ -48,6 +45,96 @@ struct RankedCandidateNode
     }
 };
 
+// sweep over search space, compute sharing for each current edge (u,v)
+template <typename HeapT>
+std::unordered_map<NodeID, int>
+approximateSharing(const std::vector<SearchSpaceEdge> &search_space,
+                   const std::unordered_set<NodeID> &nodes_in_path,
+                   const HeapT &heap)
+{
+    std::unordered_map<NodeID, int> approximated_sharing;
+
+    for (const SearchSpaceEdge &current_edge : search_space)
+    {
+        const NodeID u = current_edge.first;
+        const NodeID v = current_edge.second;
+
+        if (nodes_in_path.find(v) != nodes_in_path.end())
+        {
+            // current_edge is on shortest path => sharing(v):=queue.GetKey(v);
+            approximated_sharing.emplace(v, heap.GetKey(v));
+        }
+        else
+        {
+            // current edge is not on shortest path. Check if we know a value for the other
+            // endpoint
+            const auto sharing_of_u_iterator = approximated_sharing.find(u);
+            if (sharing_of_u_iterator != approximated_sharing.end())
+            {
+                approximated_sharing.emplace(v, sharing_of_u_iterator->second);
+            }
+        }
+    }
+
+    return approximated_sharing;
+}
+
+// preselect via nodes by the approximated length, sharing and stretch of the via path
+template <typename HeapT>
+std::vector<RankedCandidateNode>
+preselectViaNodes(const std::vector<NodeID> &via_node_candidate_list,
+                  const NodeID middle_node,
+                  const std::unordered_set<NodeID> &nodes_in_path,
+                  const std::vector<SearchSpaceEdge> &forward_search_space,
+                  const std::vector<SearchSpaceEdge> &reverse_search_space,
+                  const HeapT &forward_heap,
+                  const HeapT &reverse_heap,
+                  const EdgeWeight upper_bound_to_shortest_path_weight)
+{
+    const auto approximated_forward_sharing =
+        approximateSharing(forward_search_space, nodes_in_path, forward_heap);
+    const auto approximated_reverse_sharing =
+        approximateSharing(reverse_search_space, nodes_in_path, reverse_heap);
+
+    std::vector<RankedCandidateNode> preselected_node_list;
+    for (const NodeID node : via_node_candidate_list)
+    {
+        if (node == middle_node)
+            continue;
+        const auto fwd_iterator = approximated_forward_sharing.find(node);
+        const int fwd_sharing =
+            (fwd_iterator != approximated_forward_sharing.end()) ? fwd_iterator->second : 0;
+        const auto rev_iterator = approximated_reverse_sharing.find(node);
+        const int rev_sharing =
+            (rev_iterator != approximated_reverse_sharing.end()) ? rev_iterator->second : 0;
+
+        const int approximated_sharing = fwd_sharing + rev_sharing;
+        const int approximated_length = forward_heap.GetKey(node) + reverse_heap.GetKey(node);
+        const bool length_passes =
+            (approximated_length < upper_bound_to_shortest_path_weight * (1 + VIAPATH_EPSILON));
+        const bool sharing_passes =
+            (approximated_sharing <= upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
+        const bool stretch_passes =
+            (approximated_length - approximated_sharing) <
+            ((1. + VIAPATH_ALPHA) * (upper_bound_to_shortest_path_weight - approximated_sharing));
+
+        if (length_passes && sharing_passes && stretch_passes)
+        {
+            preselected_node_list.emplace_back(node, approximated_length, approximated_sharing);
+        }
+    }
+
+    return preselected_node_list;
+}
+}
+
+namespace ch
+{
+
+namespace
+{
+using QueryHeap = SearchEngineData<Algorithm>::QueryHeap;
+
 // todo: reorder parameters
 template <bool DIRECTION>
 void alternativeRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
@@ -658,81 +745,14 @@ alternativePathSearch(SearchEngineData<Algorithm> &engine_working_data,
     nodes_in_path.insert(middle_node);
     nodes_in_path.insert(packed_reverse_path.begin(), packed_reverse_path.end());
 
-    std::unordered_map<NodeID, int> approximated_forward_sharing;
-    std::unordered_map<NodeID, int> approximated_reverse_sharing;
-
-    // sweep over search space, compute forward sharing for each current edge (u,v)
-    for (const SearchSpaceEdge &current_edge : forward_search_space)
-    {
-        const NodeID u = current_edge.first;
-        const NodeID v = current_edge.second;
-
-        if (nodes_in_path.find(v) != nodes_in_path.end())
-        {
-            // current_edge is on shortest path => sharing(v):=queue.GetKey(v);
-            approximated_forward_sharing.emplace(v, forward_heap1.GetKey(v));
-        }
-        else
-        {
-            // current edge is not on shortest path. Check if we know a value for the other
-            // endpoint
-            const auto sharing_of_u_iterator = approximated_forward_sharing.find(u);
-            if (sharing_of_u_iterator != approximated_forward_sharing.end())
-            {
-                approximated_forward_sharing.emplace(v, sharing_of_u_iterator->second);
-            }
-        }
-    }
-
-    // sweep over search space, compute backward sharing
-    for (const SearchSpaceEdge &current_edge : reverse_search_space)
-    {
-        const NodeID u = current_edge.first;
-        const NodeID v = current_edge.second;
-        if (nodes_in_path.find(v) != nodes_in_path.end())
-        {
-            // current_edge is on shortest path => sharing(u):=queue.GetKey(u);
-            approximated_reverse_sharing.emplace(v, reverse_heap1.GetKey(v));
-        }
-        else
-        {
-            // current edge is not on shortest path. Check if we know a value for the other
-            // endpoint
-            const auto sharing_of_u_iterator = approximated_reverse_sharing.find(u);
-            if (sharing_of_u_iterator != approximated_reverse_sharing.end())
-            {
-                approximated_reverse_sharing.emplace(v, sharing_of_u_iterator->second);
-            }
-        }
-    }
-
-    std::vector<NodeID> preselected_node_list;
-    for (const NodeID node : via_node_candidate_list)
-    {
-        if (node == middle_node)
-            continue;
-        const auto fwd_iterator = approximated_forward_sharing.find(node);
-        const int fwd_sharing =
-            (fwd_iterator != approximated_forward_sharing.end()) ? fwd_iterator->second : 0;
-        const auto rev_iterator = approximated_reverse_sharing.find(node);
-        const int rev_sharing =
-            (rev_iterator != approximated_reverse_sharing.end()) ? rev_iterator->second : 0;
-
-        const int approximated_sharing = fwd_sharing + rev_sharing;
-        const int approximated_length = forward_heap1.GetKey(node) + reverse_heap1.GetKey(node);
-        const bool length_passes =
-            (approximated_length < upper_bound_to_shortest_path_weight * (1 + VIAPATH_EPSILON));
-        const bool sharing_passes =
-            (approximated_sharing <= upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
-        const bool stretch_passes =
-            (approximated_length - approximated_sharing) <
-            ((1. + VIAPATH_ALPHA) * (upper_bound_to_shortest_path_weight - approximated_sharing));
-
-        if (length_passes && sharing_passes && stretch_passes)
-        {
-            preselected_node_list.emplace_back(node);
-        }
-    }
+    const auto preselected_node_list = preselectViaNodes(via_node_candidate_list,
+                                                         middle_node,
+                                                         nodes_in_path,
+                                                         forward_search_space,
+                                                         reverse_search_space,
+                                                         forward_heap1,
+                                                         reverse_heap1,
+                                                         upper_bound_to_shortest_path_weight);
 
     std::vector<NodeID> &packed_shortest_path = packed_forward_path;
     if (!path_is_a_loop)
@@ -745,8 +765,9 @@ alternativePathSearch(SearchEngineData<Algorithm> &engine_working_data,
     std::vector<RankedCandidateNode> ranked_candidates_list;
 
     // prioritizing via nodes for deep inspection
-    for (const NodeID node : preselected_node_list)
+    for (const RankedCandidateNode &preselected : preselected_node_list)
     {
+        const NodeID node = preselected.node;
         int length_of_via_path = 0, sharing_of_via_path = 0;
         computeLengthAndSharingOfViaPath(engine_working_data,
                                          facade,
@@ -848,6 +869,369 @@ alternativePathSearch(SearchEngineData<Algorithm> &engine_working_data,
 }
 
 } // namespace ch
+
+namespace mld
+{
+
+namespace
+{
+using QueryHeap = SearchEngineData<Algorithm>::QueryHeap;
+
+template <bool DIRECTION>
+void alternativeRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                            QueryHeap &heap1,
+                            QueryHeap &heap2,
+                            NodeID &middle_node,
+                            EdgeWeight &upper_bound_to_shortest_path_weight,
+                            std::vector<NodeID> &search_space_intersection,
+                            std::vector<SearchSpaceEdge> &search_space,
+                            const EdgeWeight min_edge_offset,
+                            const PhantomNodes &phantom_node_pair)
+{
+    QueryHeap &forward_heap = DIRECTION == FORWARD_DIRECTION ? heap1 : heap2;
+    QueryHeap &reverse_heap = DIRECTION == FORWARD_DIRECTION ? heap2 : heap1;
+
+    const NodeID node = forward_heap.Min();
+    const EdgeWeight weight = forward_heap.MinKey();
+
+    const auto scaled_weight =
+        static_cast<EdgeWeight>((weight + min_edge_offset) / (1. + VIAPATH_EPSILON));
+    if ((INVALID_EDGE_WEIGHT != upper_bound_to_shortest_path_weight) &&
+        (scaled_weight > upper_bound_to_shortest_path_weight))
+    {
+        forward_heap.DeleteAll();
+        return;
+    }
+
+    search_space.emplace_back(forward_heap.GetData(node).parent, node);
+
+    if (reverse_heap.WasInserted(node))
+    {
+        search_space_intersection.emplace_back(node);
+    }
+
+    // settles the node, updates the meeting node and relaxes overlay and boundary edges
+    routingStep<DIRECTION>(facade,
+                           forward_heap,
+                           reverse_heap,
+                           middle_node,
+                           upper_bound_to_shortest_path_weight,
+                           DO_NOT_FORCE_LOOPS,
+                           DO_NOT_FORCE_LOOPS,
+                           phantom_node_pair);
+}
+
+// conduct T-Test: the part of the via path around the via node has to be a shortest path
+bool viaNodeCandidatePassesTTest(
+    const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+    QueryHeap &forward_heap,
+    QueryHeap &reverse_heap,
+    const NodeID via_node,
+    const NodeID source_node,
+    const std::vector<EdgeID> &unpacked_via_path,
+    const EdgeWeight length_of_shortest_path)
+{
+    const auto T_threshold = static_cast<EdgeWeight>(VIAPATH_EPSILON * length_of_shortest_path);
+
+    std::vector<NodeID> via_path_nodes;
+    via_path_nodes.reserve(unpacked_via_path.size() + 1);
+    via_path_nodes.push_back(source_node);
+    std::transform(unpacked_via_path.begin(),
+                   unpacked_via_path.end(),
+                   std::back_inserter(via_path_nodes),
+                   [&facade](const auto edge) { return facade.GetTarget(edge); });
+
+    const auto via_node_iterator =
+        std::find(via_path_nodes.begin(), via_path_nodes.end(), via_node);
+    BOOST_ASSERT(via_node_iterator != via_path_nodes.end());
+
+    // walk T_threshold back to s_P and forward to t_P along the via path
+    auto s_P_index =
+        static_cast<std::size_t>(std::distance(via_path_nodes.begin(), via_node_iterator));
+    auto t_P_index = s_P_index;
+    EdgeWeight t_test_path_length = 0;
+
+    EdgeWeight unpacked_until_weight = 0;
+    while (s_P_index > 0 && unpacked_until_weight < T_threshold)
+    {
+        unpacked_until_weight += facade.GetEdgeData(unpacked_via_path[s_P_index - 1]).weight;
+        --s_P_index;
+    }
+    t_test_path_length += unpacked_until_weight;
+
+    unpacked_until_weight = 0;
+    while (t_P_index < unpacked_via_path.size() && unpacked_until_weight < T_threshold)
+    {
+        unpacked_until_weight += facade.GetEdgeData(unpacked_via_path[t_P_index]).weight;
+        ++t_P_index;
+    }
+    t_test_path_length += unpacked_until_weight;
+
+    const NodeID s_P = via_path_nodes[s_P_index];
+    const NodeID t_P = via_path_nodes[t_P_index];
+    if (s_P == t_P)
+    {
+        return true;
+    }
+
+    // the query levels of the T-Test search are given by s_P and t_P
+    PhantomNodes t_test_phantoms;
+    t_test_phantoms.source_phantom.forward_segment_id = {s_P, true};
+    t_test_phantoms.target_phantom.forward_segment_id = {t_P, true};
+
+    forward_heap.Clear();
+    reverse_heap.Clear();
+    forward_heap.Insert(s_P, 0, {s_P});
+    reverse_heap.Insert(t_P, 0, {t_P});
+
+    // Run actual T-Test query, the sub path passes if there is no shorter path
+    EdgeWeight upper_bound = INVALID_EDGE_WEIGHT;
+    NodeID middle = SPECIAL_NODEID;
+    EdgeWeight forward_heap_min = forward_heap.MinKey();
+    EdgeWeight reverse_heap_min = reverse_heap.MinKey();
+    while (forward_heap.Size() + reverse_heap.Size() > 0 &&
+           forward_heap_min + reverse_heap_min < upper_bound)
+    {
+        if (!forward_heap.Empty())
+        {
+            routingStep<FORWARD_DIRECTION>(facade,
+                                           forward_heap,
+                                           reverse_heap,
+                                           middle,
+                                           upper_bound,
+                                           DO_NOT_FORCE_LOOPS,
+                                           DO_NOT_FORCE_LOOPS,
+                                           t_test_phantoms);
+            if (!forward_heap.Empty())
+                forward_heap_min = forward_heap.MinKey();
+        }
+        if (!reverse_heap.Empty())
+        {
+            routingStep<REVERSE_DIRECTION>(facade,
+                                           reverse_heap,
+                                           forward_heap,
+                                           middle,
+                                           upper_bound,
+                                           DO_NOT_FORCE_LOOPS,
+                                           DO_NOT_FORCE_LOOPS,
+                                           t_test_phantoms);
+            if (!reverse_heap.Empty())
+                reverse_heap_min = reverse_heap.MinKey();
+        }
+    }
+
+    return upper_bound >= t_test_path_length;
+}
+}
+
+InternalRouteResult
+alternativePathSearch(SearchEngineData<Algorithm> &engine_working_data,
+                      const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                      const PhantomNodes &phantom_node_pair)
+{
+    InternalRouteResult raw_route_data;
+    raw_route_data.segment_end_coordinates = {phantom_node_pair};
+    std::vector<NodeID> via_node_candidate_list;
+    std::vector<SearchSpaceEdge> forward_search_space;
+    std::vector<SearchSpaceEdge> reverse_search_space;
+
+    engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+    engine_working_data.InitializeOrClearSecondThreadLocalStorage(facade.GetNumberOfNodes());
+
+    auto &forward_heap1 = *engine_working_data.forward_heap_1;
+    auto &reverse_heap1 = *engine_working_data.reverse_heap_1;
+    auto &forward_heap2 = *engine_working_data.forward_heap_2;
+    auto &reverse_heap2 = *engine_working_data.reverse_heap_2;
+
+    EdgeWeight upper_bound_to_shortest_path_weight = INVALID_EDGE_WEIGHT;
+    NodeID middle_node = SPECIAL_NODEID;
+    const EdgeWeight min_edge_offset =
+        std::min(phantom_node_pair.source_phantom.forward_segment_id.enabled
+                     ? -phantom_node_pair.source_phantom.GetForwardWeightPlusOffset()
+                     : 0,
+                 phantom_node_pair.source_phantom.reverse_segment_id.enabled
+                     ? -phantom_node_pair.source_phantom.GetReverseWeightPlusOffset()
+                     : 0);
+
+    insertNodesInHeaps(forward_heap1, reverse_heap1, phantom_node_pair);
+
+    // search from s and t till new_min/(1+epsilon) > length_of_shortest_path,
+    // the via node candidates are the nodes of the overlay graph reached by both searches
+    while (0 < (forward_heap1.Size() + reverse_heap1.Size()))
+    {
+        if (0 < forward_heap1.Size())
+        {
+            alternativeRoutingStep<FORWARD_DIRECTION>(facade,
+                                                      forward_heap1,
+                                                      reverse_heap1,
+                                                      middle_node,
+                                                      upper_bound_to_shortest_path_weight,
+                                                      via_node_candidate_list,
+                                                      forward_search_space,
+                                                      min_edge_offset,
+                                                      phantom_node_pair);
+        }
+        if (0 < reverse_heap1.Size())
+        {
+            alternativeRoutingStep<REVERSE_DIRECTION>(facade,
+                                                      forward_heap1,
+                                                      reverse_heap1,
+                                                      middle_node,
+                                                      upper_bound_to_shortest_path_weight,
+                                                      via_node_candidate_list,
+                                                      reverse_search_space,
+                                                      min_edge_offset,
+                                                      phantom_node_pair);
+        }
+    }
+
+    if (INVALID_EDGE_WEIGHT == upper_bound_to_shortest_path_weight)
+    {
+        return raw_route_data;
+    }
+
+    std::sort(begin(via_node_candidate_list), end(via_node_candidate_list));
+    auto unique_end = std::unique(begin(via_node_candidate_list), end(via_node_candidate_list));
+    via_node_candidate_list.resize(unique_end - begin(via_node_candidate_list));
+
+    const auto packed_shortest_path =
+        retrievePackedPathFromHeap(forward_heap1, reverse_heap1, middle_node);
+
+    // this set is is used as an indicator if a node is on the shortest path
+    std::unordered_set<NodeID> nodes_in_path(packed_shortest_path.size() + 1);
+    nodes_in_path.insert(middle_node);
+    for (const auto &packed_edge : packed_shortest_path)
+    {
+        nodes_in_path.insert(std::get<0>(packed_edge));
+        nodes_in_path.insert(std::get<1>(packed_edge));
+    }
+
+    const auto preselected_node_list = preselectViaNodes(via_node_candidate_list,
+                                                         middle_node,
+                                                         nodes_in_path,
+                                                         forward_search_space,
+                                                         reverse_search_space,
+                                                         forward_heap1,
+                                                         reverse_heap1,
+                                                         upper_bound_to_shortest_path_weight);
+
+    // Unpack the shortest path, the second heaps are reused for the unpacking searches
+    const auto unpacked_shortest_path = unpackPackedPath(facade,
+                                                         forward_heap2,
+                                                         reverse_heap2,
+                                                         packed_shortest_path,
+                                                         DO_NOT_FORCE_LOOPS,
+                                                         DO_NOT_FORCE_LOOPS,
+                                                         phantom_node_pair);
+    const NodeID source_node =
+        packed_shortest_path.empty() ? middle_node : std::get<0>(packed_shortest_path.front());
+    const NodeID target_node =
+        packed_shortest_path.empty() ? middle_node : std::get<1>(packed_shortest_path.back());
+
+    raw_route_data.unpacked_path_segments.resize(1);
+    raw_route_data.source_traversed_in_reverse.push_back(
+        (source_node != phantom_node_pair.source_phantom.forward_segment_id.id));
+    raw_route_data.target_traversed_in_reverse.push_back(
+        (target_node != phantom_node_pair.target_phantom.forward_segment_id.id));
+    annotatePath(facade,
+                 source_node,
+                 target_node,
+                 unpacked_shortest_path,
+                 phantom_node_pair,
+                 raw_route_data.unpacked_path_segments.front());
+    raw_route_data.shortest_path_length = upper_bound_to_shortest_path_weight;
+
+    const std::unordered_set<EdgeID> edges_in_path(unpacked_shortest_path.begin(),
+                                                   unpacked_shortest_path.end());
+    const int maximum_allowed_sharing =
+        static_cast<int>(upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
+
+    // the via path <s,..,v,..,t> of a candidate, unpacked to the edges of the base graph
+    struct ViaPath
+    {
+        NodeID source_node;
+        NodeID target_node;
+        std::vector<EdgeID> edges;
+    };
+    std::unordered_map<NodeID, ViaPath> via_paths;
+    std::vector<RankedCandidateNode> ranked_candidates_list;
+
+    // prioritizing via nodes for deep inspection
+    for (const RankedCandidateNode &preselected : preselected_node_list)
+    {
+        // the via path is given by the parents in both search spaces
+        const auto packed_via_path =
+            retrievePackedPathFromHeap(forward_heap1, reverse_heap1, preselected.node);
+        // the node of both phantom nodes is reached by both searches if the route is a loop,
+        // there is no via path through it
+        if (packed_via_path.empty())
+        {
+            continue;
+        }
+        auto unpacked_via_path = unpackPackedPath(facade,
+                                                  forward_heap2,
+                                                  reverse_heap2,
+                                                  packed_via_path,
+                                                  DO_NOT_FORCE_LOOPS,
+                                                  DO_NOT_FORCE_LOOPS,
+                                                  phantom_node_pair);
+
+        int sharing_of_via_path = 0;
+        for (const auto edge : unpacked_via_path)
+        {
+            if (edges_in_path.count(edge) > 0)
+            {
+                sharing_of_via_path += facade.GetEdgeData(edge).weight;
+            }
+        }
+
+        const int length_of_via_path = preselected.length;
+        if (sharing_of_via_path <= maximum_allowed_sharing &&
+            length_of_via_path <= upper_bound_to_shortest_path_weight * (1 + VIAPATH_EPSILON))
+        {
+            ranked_candidates_list.emplace_back(
+                preselected.node, length_of_via_path, sharing_of_via_path);
+            via_paths.emplace(preselected.node,
+                              ViaPath{std::get<0>(packed_via_path.front()),
+                                      std::get<1>(packed_via_path.back()),
+                                      std::move(unpacked_via_path)});
+        }
+    }
+    std::sort(ranked_candidates_list.begin(), ranked_candidates_list.end());
+
+    for (const RankedCandidateNode &candidate : ranked_candidates_list)
+    {
+        const auto &via_path = via_paths.at(candidate.node);
+        if (!viaNodeCandidatePassesTTest(facade,
+                                         forward_heap2,
+                                         reverse_heap2,
+                                         candidate.node,
+                                         via_path.source_node,
+                                         via_path.edges,
+                                         upper_bound_to_shortest_path_weight))
+        {
+            continue;
+        }
+
+        // select first admissable
+        raw_route_data.alt_source_traversed_in_reverse.push_back(
+            (via_path.source_node != phantom_node_pair.source_phantom.forward_segment_id.id));
+        raw_route_data.alt_target_traversed_in_reverse.push_back(
+            (via_path.target_node != phantom_node_pair.target_phantom.forward_segment_id.id));
+        annotatePath(facade,
+                     via_path.source_node,
+                     via_path.target_node,
+                     via_path.edges,
+                     phantom_node_pair,
+                     raw_route_data.unpacked_alternative);
+        raw_route_data.alternative_path_length = candidate.length;
+        break;
+    }
+
+    return raw_route_data;
+}
+
+} // namespace mld
 } // namespace routing_algorithms
 } // namespace engine
-} // namespace osrm}
+} // namespace osrm
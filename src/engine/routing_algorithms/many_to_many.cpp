@@ -1,11 +1,23 @@
 #include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/parallel_searches.hpp"
+#include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
+#include "engine/routing_algorithms/routing_base_mld.hpp"
+
+#include "util/coordinate_calculation.hpp"
+#include "util/for_each_pair.hpp"
 
 #include <boost/assert.hpp>
+#include <boost/range/iterator_range.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -15,26 +27,265 @@ namespace engine
 namespace routing_algorithms
 {
 
-namespace ch
-{
-
-using ManyToManyQueryHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
-
 namespace
 {
 struct NodeBucket
 {
+    NodeID middle_node;
     unsigned target_id; // essentially a row in the weight matrix
     EdgeWeight weight;
     EdgeWeight duration;
-    NodeBucket(const unsigned target_id, const EdgeWeight weight, const EdgeWeight duration)
-        : target_id(target_id), weight(weight), duration(duration)
+    NodeBucket(const NodeID middle_node,
+               const unsigned target_id,
+               const EdgeWeight weight,
+               const EdgeWeight duration)
+        : middle_node(middle_node), target_id(target_id), weight(weight), duration(duration)
     {
     }
+
+    bool operator<(const NodeBucket &rhs) const
+    {
+        return std::tie(middle_node, target_id) < std::tie(rhs.middle_node, rhs.target_id);
+    }
+
+    // Allows to search the buckets of a middle node with std::equal_range
+    struct MiddleNodeCompare
+    {
+        bool operator()(const NodeBucket &lhs, const NodeID rhs) const
+        {
+            return lhs.middle_node < rhs;
+        }
+        bool operator()(const NodeID lhs, const NodeBucket &rhs) const
+        {
+            return lhs < rhs.middle_node;
+        }
+    };
 };
 
-// FIXME This should be replaced by an std::unordered_multimap, though this needs benchmarking
-using SearchSpaceWithBuckets = std::unordered_map<NodeID, std::vector<NodeBucket>>;
+// Only used if distances are requested, so the duration only searches keep the smaller buckets
+struct NodeBucketWithDistance : NodeBucket
+{
+    EdgeDistance distance; // from the middle node to the target phantom node
+    NodeBucketWithDistance(const NodeID middle_node,
+                           const unsigned target_id,
+                           const EdgeWeight weight,
+                           const EdgeWeight duration,
+                           const EdgeDistance distance)
+        : NodeBucket(middle_node, target_id, weight, duration), distance(distance)
+    {
+    }
+};
+
+template <typename DistanceT>
+void addBucket(std::vector<NodeBucket> &buckets,
+               const NodeID node,
+               const unsigned column_idx,
+               const EdgeWeight weight,
+               const EdgeWeight duration,
+               const DistanceT & /* get_distance */)
+{
+    buckets.emplace_back(node, column_idx, weight, duration);
+}
+
+template <typename DistanceT>
+void addBucket(std::vector<NodeBucketWithDistance> &buckets,
+               const NodeID node,
+               const unsigned column_idx,
+               const EdgeWeight weight,
+               const EdgeWeight duration,
+               const DistanceT &get_distance)
+{
+    buckets.emplace_back(node, column_idx, weight, duration, get_distance());
+}
+
+template <typename DistanceT>
+void updateDistance(const NodeBucket & /* bucket */,
+                    std::vector<EdgeDistance> & /* distances_table */,
+                    const std::size_t /* entry_idx */,
+                    const DistanceT & /* get_distance */)
+{
+}
+
+template <typename DistanceT>
+void updateDistance(const NodeBucketWithDistance &bucket,
+                    std::vector<EdgeDistance> &distances_table,
+                    const std::size_t entry_idx,
+                    const DistanceT &get_distance)
+{
+    distances_table[entry_idx] = get_distance() + bucket.distance;
+}
+
+// Distances of the nodes settled by one search, keyed by node
+using SearchTreeDistances = std::unordered_map<NodeID, EdgeDistance>;
+
+template <typename FacadeT, typename IteratorT>
+EdgeDistance getGeometryLength(const FacadeT &facade, IteratorT begin, IteratorT end)
+{
+    EdgeDistance length = 0;
+    util::for_each_pair(begin, end, [&facade, &length](const NodeID from, const NodeID to) {
+        length += util::coordinate_calculation::haversineDistance(
+            facade.GetCoordinateOfNode(from), facade.GetCoordinateOfNode(to));
+    });
+    return length;
+}
+
+// Length of the edge-based node that is left by the turn with the given id
+template <typename FacadeT>
+EdgeDistance getTurnSourceLength(const FacadeT &facade, const EdgeID turn_id)
+{
+    const auto geometry_index = facade.GetGeometryIndexForEdgeID(turn_id);
+    const auto geometry = geometry_index.forward
+                              ? facade.GetUncompressedForwardGeometry(geometry_index.id)
+                              : facade.GetUncompressedReverseGeometry(geometry_index.id);
+    return getGeometryLength(facade, geometry.begin(), geometry.end());
+}
+
+// Distance from the start of the edge-based node to the phantom node location,
+// the distance analogue of PhantomNode::GetForwardWeightPlusOffset
+template <typename FacadeT>
+EdgeDistance getPhantomOffset(const FacadeT &facade, const PhantomNode &phantom, const NodeID node)
+{
+    const bool forward =
+        phantom.forward_segment_id.enabled && phantom.forward_segment_id.id == node;
+    BOOST_ASSERT(forward ||
+                 (phantom.reverse_segment_id.enabled && phantom.reverse_segment_id.id == node));
+
+    const auto geometry = forward
+                              ? facade.GetUncompressedForwardGeometry(phantom.packed_geometry_id)
+                              : facade.GetUncompressedReverseGeometry(phantom.packed_geometry_id);
+    BOOST_ASSERT(geometry.size() > 1);
+    BOOST_ASSERT(phantom.fwd_segment_position + 1u < geometry.size());
+    const std::size_t position =
+        forward ? phantom.fwd_segment_position : geometry.size() - 2 - phantom.fwd_segment_position;
+
+    return getGeometryLength(facade, geometry.begin(), geometry.begin() + position + 1) +
+           util::coordinate_calculation::haversineDistance(
+               facade.GetCoordinateOfNode(geometry[position]), phantom.location);
+}
+
+// Distance of a settled node from the phantom node the search started at. Follows the parents
+// stored in the heap up to the first node with a known distance, so every edge of the search
+// tree is unpacked at most once. The forward search starts with the negative source offset
+// and the backward search with the target offset, like the weights in insertNodesInHeap.
+template <bool DIRECTION, typename FacadeT, typename HeapT, typename EdgeDistanceT>
+EdgeDistance getSearchTreeDistance(const FacadeT &facade,
+                                   const HeapT &query_heap,
+                                   const PhantomNode &phantom,
+                                   SearchTreeDistances &distances,
+                                   const NodeID node,
+                                   const EdgeDistanceT &get_edge_distance)
+{
+    std::vector<NodeID> path;
+    auto current = node;
+    auto known = distances.find(current);
+    while (known == distances.end())
+    {
+        const auto parent = query_heap.GetData(current).parent;
+        if (parent == current)
+        {
+            const auto offset = getPhantomOffset(facade, phantom, current);
+            known = distances.emplace(current, DIRECTION == FORWARD_DIRECTION ? -offset : offset)
+                        .first;
+            break;
+        }
+        path.push_back(current);
+        current = parent;
+        known = distances.find(current);
+    }
+
+    auto distance = known->second;
+    for (auto child = path.rbegin(); child != path.rend(); ++child)
+    {
+        distance += get_edge_distance(query_heap.GetData(*child).parent, *child);
+        distances.emplace(*child, distance);
+    }
+    return distance;
+}
+
+// Buckets of all backward searches in one flat array sorted by their middle node.
+// Compared to a hash map of vectors there is no allocation per settled node and the
+// buckets of a node are found with a binary search over a contiguous array.
+// Backward searches write the buckets of their column only, so they can run concurrently.
+// The buckets of all columns are merged once all searches are finished.
+template <typename BucketT>
+std::vector<BucketT> mergeBuckets(std::vector<std::vector<BucketT>> &column_buckets)
+{
+    std::size_t number_of_buckets = 0;
+    for (const auto &buckets : column_buckets)
+    {
+        number_of_buckets += buckets.size();
+    }
+
+    std::vector<BucketT> search_space_with_buckets;
+    search_space_with_buckets.reserve(number_of_buckets);
+    for (auto &buckets : column_buckets)
+    {
+        search_space_with_buckets.insert(
+            search_space_with_buckets.end(), buckets.begin(), buckets.end());
+        std::vector<BucketT>().swap(buckets);
+    }
+    std::sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
+
+    return search_space_with_buckets;
+}
+
+template <typename BucketT>
+auto getBuckets(const std::vector<BucketT> &search_space_with_buckets, const NodeID node)
+{
+    const auto bucket_range = std::equal_range(search_space_with_buckets.begin(),
+                                               search_space_with_buckets.end(),
+                                               node,
+                                               NodeBucket::MiddleNodeCompare{});
+    return boost::make_iterator_range(bucket_range.first, bucket_range.second);
+}
+}
+
+namespace ch
+{
+
+using ManyToManyQueryHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
+
+namespace
+{
+// Distance of the CH edge between parent and node of a search tree, in search direction
+template <bool DIRECTION>
+EdgeDistance
+getEdgeDistance(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                const NodeID parent,
+                const NodeID node)
+{
+    // the backward search follows edges from the node to its parent
+    const std::array<NodeID, 2> packed_edge =
+        DIRECTION == FORWARD_DIRECTION ? std::array<NodeID, 2>{{parent, node}}
+                                       : std::array<NodeID, 2>{{node, parent}};
+
+    EdgeDistance distance = 0;
+    unpackPath(facade,
+               packed_edge.begin(),
+               packed_edge.end(),
+               [&facade, &distance](std::pair<NodeID, NodeID> & /* edge */, const auto &edge_id) {
+                   distance += getTurnSourceLength(facade, facade.GetEdgeData(edge_id).turn_id);
+               });
+    return distance;
+}
+
+template <bool DIRECTION>
+EdgeDistance getDistance(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                         const ManyToManyQueryHeap &query_heap,
+                         const PhantomNode &phantom,
+                         SearchTreeDistances &distances,
+                         const NodeID node)
+{
+    return getSearchTreeDistance<DIRECTION>(
+        facade,
+        query_heap,
+        phantom,
+        distances,
+        node,
+        [&facade](const NodeID from, const NodeID to) {
+            return getEdgeDistance<DIRECTION>(facade, from, to);
+        });
+}
 
 template <bool DIRECTION>
 void relaxOutgoingEdges(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
@@ -72,53 +323,64 @@ void relaxOutgoingEdges(const datafacade::ContiguousInternalMemoryDataFacade<Alg
     }
 }
 
+template <typename BucketT>
 void forwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
                         const unsigned row_idx,
                         const unsigned number_of_targets,
                         ManyToManyQueryHeap &query_heap,
-                        const SearchSpaceWithBuckets &search_space_with_buckets,
+                        const std::vector<BucketT> &search_space_with_buckets,
                         std::vector<EdgeWeight> &weights_table,
-                        std::vector<EdgeWeight> &durations_table)
+                        std::vector<EdgeWeight> &durations_table,
+                        std::vector<EdgeDistance> &distances_table,
+                        SearchTreeDistances &distances,
+                        const PhantomNode &phantom_node)
 {
     const NodeID node = query_heap.DeleteMin();
     const EdgeWeight source_weight = query_heap.GetKey(node);
     const EdgeWeight source_duration = query_heap.GetData(node).duration;
 
-    // check if each encountered node has an entry
-    const auto bucket_iterator = search_space_with_buckets.find(node);
-    // iterate bucket if there exists one
-    if (bucket_iterator != search_space_with_buckets.end())
+    const auto get_distance = [&] {
+        return getDistance<FORWARD_DIRECTION>(facade, query_heap, phantom_node, distances, node);
+    };
+
+    // iterate the buckets of all targets that settled this node
+    for (const BucketT &current_bucket : getBuckets(search_space_with_buckets, node))
     {
-        const std::vector<NodeBucket> &bucket_list = bucket_iterator->second;
-        for (const NodeBucket &current_bucket : bucket_list)
-        {
-            // get target id from bucket entry
-            const unsigned column_idx = current_bucket.target_id;
-            const EdgeWeight target_weight = current_bucket.weight;
-            const EdgeWeight target_duration = current_bucket.duration;
+        // get target id from bucket entry
+        const unsigned column_idx = current_bucket.target_id;
+        const EdgeWeight target_weight = current_bucket.weight;
+        const EdgeWeight target_duration = current_bucket.duration;
 
-            auto &current_weight = weights_table[row_idx * number_of_targets + column_idx];
-            auto &current_duration = durations_table[row_idx * number_of_targets + column_idx];
+        const auto entry_idx = row_idx * number_of_targets + column_idx;
+        auto &current_weight = weights_table[entry_idx];
+        auto &current_duration = durations_table[entry_idx];
 
-            // check if new weight is better
-            const EdgeWeight new_weight = source_weight + target_weight;
-            if (new_weight < 0)
+        // check if new weight is better
+        const EdgeWeight new_weight = source_weight + target_weight;
+        if (new_weight < 0)
+        {
+            const EdgeWeight loop_weight = ch::getLoopWeight<false>(facade, node);
+            const EdgeWeight new_weight_with_loop = new_weight + loop_weight;
+            if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
             {
-                const EdgeWeight loop_weight = ch::getLoopWeight<false>(facade, node);
-                const EdgeWeight new_weight_with_loop = new_weight + loop_weight;
-                if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0)
+                if (new_weight_with_loop < current_weight)
                 {
-                    current_weight = std::min(current_weight, new_weight_with_loop);
-                    current_duration = std::min(current_duration,
-                                                source_duration + target_duration +
-                                                    ch::getLoopWeight<true>(facade, node));
+                    updateDistance(current_bucket, distances_table, entry_idx, [&] {
+                        return get_distance() +
+                               getEdgeDistance<FORWARD_DIRECTION>(facade, node, node);
+                    });
                 }
+                current_weight = std::min(current_weight, new_weight_with_loop);
+                current_duration = std::min(current_duration,
+                                            source_duration + target_duration +
+                                                ch::getLoopWeight<true>(facade, node));
             }
-            else if (new_weight < current_weight)
-            {
-                current_weight = new_weight;
-                current_duration = source_duration + target_duration;
-            }
+        }
+        else if (new_weight < current_weight)
+        {
+            current_weight = new_weight;
+            current_duration = source_duration + target_duration;
+            updateDistance(current_bucket, distances_table, entry_idx, get_distance);
         }
     }
     if (ch::stallAtNode<FORWARD_DIRECTION>(facade, node, source_weight, query_heap))
@@ -129,17 +391,22 @@ void forwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Alg
     relaxOutgoingEdges<FORWARD_DIRECTION>(facade, node, source_weight, source_duration, query_heap);
 }
 
+template <typename BucketT>
 void backwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
                          const unsigned column_idx,
                          ManyToManyQueryHeap &query_heap,
-                         SearchSpaceWithBuckets &search_space_with_buckets)
+                         std::vector<BucketT> &buckets,
+                         SearchTreeDistances &distances,
+                         const PhantomNode &phantom_node)
 {
     const NodeID node = query_heap.DeleteMin();
     const EdgeWeight target_weight = query_heap.GetKey(node);
     const EdgeWeight target_duration = query_heap.GetData(node).duration;
 
     // store settled nodes in search space bucket
-    search_space_with_buckets[node].emplace_back(column_idx, target_weight, target_duration);
+    addBucket(buckets, node, column_idx, target_weight, target_duration, [&] {
+        return getDistance<REVERSE_DIRECTION>(facade, query_heap, phantom_node, distances, node);
+    });
 
     if (ch::stallAtNode<REVERSE_DIRECTION>(facade, node, target_weight, query_heap))
     {
@@ -148,14 +415,16 @@ void backwardRoutingStep(const datafacade::ContiguousInternalMemoryDataFacade<Al
 
     relaxOutgoingEdges<REVERSE_DIRECTION>(facade, node, target_weight, target_duration, query_heap);
 }
-}
 
-std::vector<EdgeWeight>
-manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
-                 const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
-                 const std::vector<PhantomNode> &phantom_nodes,
-                 const std::vector<std::size_t> &source_indices,
-                 const std::vector<std::size_t> &target_indices)
+template <typename BucketT>
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
+searchWithBuckets(SearchEngineData<Algorithm> &engine_working_data,
+                  const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                  const std::vector<PhantomNode> &phantom_nodes,
+                  const std::vector<std::size_t> &source_indices,
+                  const std::vector<std::size_t> &target_indices,
+                  const unsigned max_threads,
+                  const bool calculate_distance)
 {
     const auto number_of_sources =
         source_indices.empty() ? phantom_nodes.size() : source_indices.size();
@@ -165,35 +434,44 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
 
     std::vector<EdgeWeight> weights_table(number_of_entries, INVALID_EDGE_WEIGHT);
     std::vector<EdgeWeight> durations_table(number_of_entries, MAXIMAL_EDGE_DURATION);
+    std::vector<EdgeDistance> distances_table(calculate_distance ? number_of_entries : 0,
+                                              INVALID_EDGE_DISTANCE);
 
-    engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(facade.GetNumberOfNodes());
-
-    auto &query_heap = *(engine_working_data.many_to_many_heap);
-
-    SearchSpaceWithBuckets search_space_with_buckets;
+    std::vector<std::vector<BucketT>> column_buckets(number_of_targets);
+    runSearches(number_of_targets, max_threads, [&](const std::size_t column_idx) {
+        const auto &phantom =
+            phantom_nodes[target_indices.empty() ? column_idx : target_indices[column_idx]];
 
-    unsigned column_idx = 0;
-    const auto search_target_phantom = [&](const PhantomNode &phantom) {
         // clear heap and insert target nodes
-        query_heap.Clear();
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
         insertNodesInHeap<REVERSE_DIRECTION>(query_heap, phantom);
 
         // explore search space
+        SearchTreeDistances distances;
         while (!query_heap.Empty())
         {
-            backwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
+            backwardRoutingStep(
+                facade, column_idx, query_heap, column_buckets[column_idx], distances, phantom);
         }
-        ++column_idx;
-    };
+    });
+
+    const auto search_space_with_buckets = mergeBuckets(column_buckets);
 
     // for each source do forward search
-    unsigned row_idx = 0;
-    const auto search_source_phantom = [&](const PhantomNode &phantom) {
+    runSearches(number_of_sources, max_threads, [&](const std::size_t row_idx) {
+        const auto &phantom =
+            phantom_nodes[source_indices.empty() ? row_idx : source_indices[row_idx]];
+
         // clear heap and insert source nodes
-        query_heap.Clear();
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
         insertNodesInHeap<FORWARD_DIRECTION>(query_heap, phantom);
 
         // explore search space
+        SearchTreeDistances distances;
         while (!query_heap.Empty())
         {
             forwardRoutingStep(facade,
@@ -202,47 +480,628 @@ manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
                                query_heap,
                                search_space_with_buckets,
                                weights_table,
-                               durations_table);
+                               durations_table,
+                               distances_table,
+                               distances,
+                               phantom);
+        }
+    });
+
+    return std::make_pair(std::move(durations_table), std::move(distances_table));
+}
+
+// Bucket that keeps the parent of the middle node in the backward search tree, so the packed
+// path from the middle node to the target can be retrieved after the search
+struct NodeBucketWithParent : NodeBucket
+{
+    NodeID parent;
+    NodeBucketWithParent(const NodeID middle_node,
+                         const unsigned target_id,
+                         const EdgeWeight weight,
+                         const EdgeWeight duration,
+                         const NodeID parent)
+        : NodeBucket(middle_node, target_id, weight, duration), parent(parent)
+    {
+    }
+};
+
+// Appends the nodes after the middle node on the path to the target of the column
+inline void retrievePackedPathFromBuckets(const std::vector<NodeBucketWithParent> &buckets,
+                                          const unsigned column_idx,
+                                          const NodeID middle_node,
+                                          std::vector<NodeID> &packed_path)
+{
+    const auto bucket_less = [](const NodeBucketWithParent &lhs,
+                                const std::pair<NodeID, unsigned> &rhs) {
+        return std::tie(lhs.middle_node, lhs.target_id) < std::tie(rhs.first, rhs.second);
+    };
+
+    NodeID current_node = middle_node;
+    while (true)
+    {
+        // every node of the backward search tree was settled, so it has a bucket of the column
+        const auto bucket = std::lower_bound(
+            buckets.begin(), buckets.end(), std::make_pair(current_node, column_idx), bucket_less);
+        BOOST_ASSERT(bucket != buckets.end() && bucket->middle_node == current_node &&
+                     bucket->target_id == column_idx);
+        if (bucket->parent == current_node)
+        {
+            break;
+        }
+        current_node = bucket->parent;
+        packed_path.emplace_back(current_node);
+    }
+}
+
+// The forward searches start with the negative offsets of the source phantom nodes, so the
+// backward searches have to run further by the largest source offset to find all paths with
+// a weight below the upper bound.
+inline EdgeWeight getBackwardUpperBound(const std::vector<PhantomNode> &source_phantoms,
+                                        const EdgeWeight weight_upper_bound)
+{
+    EdgeWeight max_source_offset = 0;
+    for (const auto &phantom : source_phantoms)
+    {
+        if (phantom.forward_segment_id.enabled)
+            max_source_offset = std::max(max_source_offset, phantom.GetForwardWeightPlusOffset());
+        if (phantom.reverse_segment_id.enabled)
+            max_source_offset = std::max(max_source_offset, phantom.GetReverseWeightPlusOffset());
+    }
+
+    return std::min<std::int64_t>(static_cast<std::int64_t>(weight_upper_bound) + max_source_offset,
+                                  INVALID_EDGE_WEIGHT);
+}
+}
+
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices,
+                 const unsigned max_threads,
+                 const bool calculate_distance)
+{
+    if (calculate_distance)
+    {
+        return searchWithBuckets<NodeBucketWithDistance>(engine_working_data,
+                                                         facade,
+                                                         phantom_nodes,
+                                                         source_indices,
+                                                         target_indices,
+                                                         max_threads,
+                                                         calculate_distance);
+    }
+    return searchWithBuckets<NodeBucket>(engine_working_data,
+                                         facade,
+                                         phantom_nodes,
+                                         source_indices,
+                                         target_indices,
+                                         max_threads,
+                                         calculate_distance);
+}
+
+std::vector<double>
+getNetworkDistances(SearchEngineData<Algorithm> &engine_working_data,
+                    const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                    const std::vector<PhantomNode> &source_phantoms,
+                    const std::vector<PhantomNode> &target_phantoms,
+                    const EdgeWeight weight_upper_bound)
+{
+    const auto number_of_targets = target_phantoms.size();
+    std::vector<double> network_distances(source_phantoms.size() * number_of_targets,
+                                          std::numeric_limits<double>::max());
+
+    const auto backward_upper_bound = getBackwardUpperBound(source_phantoms, weight_upper_bound);
+
+    std::vector<NodeBucketWithParent> search_space_with_buckets;
+    for (std::size_t column_idx = 0; column_idx < number_of_targets; ++column_idx)
+    {
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
+        insertNodesInHeap<REVERSE_DIRECTION>(query_heap, target_phantoms[column_idx]);
+
+        while (!query_heap.Empty() && query_heap.MinKey() < backward_upper_bound)
+        {
+            const NodeID node = query_heap.DeleteMin();
+            const EdgeWeight target_weight = query_heap.GetKey(node);
+            const auto &data = query_heap.GetData(node);
+            const EdgeWeight target_duration = data.duration;
+            search_space_with_buckets.emplace_back(
+                node, column_idx, target_weight, target_duration, data.parent);
+
+            if (!ch::stallAtNode<REVERSE_DIRECTION>(facade, node, target_weight, query_heap))
+            {
+                relaxOutgoingEdges<REVERSE_DIRECTION>(
+                    facade, node, target_weight, target_duration, query_heap);
+            }
+        }
+    }
+    std::sort(search_space_with_buckets.begin(), search_space_with_buckets.end());
+
+    std::vector<EdgeWeight> weights(number_of_targets);
+    std::vector<NodeID> middle_nodes(number_of_targets);
+    std::vector<bool> loops(number_of_targets);
+    for (std::size_t row_idx = 0; row_idx < source_phantoms.size(); ++row_idx)
+    {
+        const auto &source_phantom = source_phantoms[row_idx];
+        std::fill(weights.begin(), weights.end(), weight_upper_bound);
+        std::fill(middle_nodes.begin(), middle_nodes.end(), SPECIAL_NODEID);
+        std::fill(loops.begin(), loops.end(), false);
+
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
+        insertNodesInHeap<FORWARD_DIRECTION>(query_heap, source_phantom);
+
+        // the buckets hold non-negative weights, nodes above the largest weight found so far
+        // can not improve any entry of the row
+        EdgeWeight row_upper_bound = weight_upper_bound;
+        while (!query_heap.Empty() && query_heap.MinKey() < row_upper_bound)
+        {
+            const NodeID node = query_heap.DeleteMin();
+            const EdgeWeight source_weight = query_heap.GetKey(node);
+            const EdgeWeight source_duration = query_heap.GetData(node).duration;
+
+            for (const auto &current_bucket : getBuckets(search_space_with_buckets, node))
+            {
+                const auto column_idx = current_bucket.target_id;
+                const EdgeWeight new_weight = source_weight + current_bucket.weight;
+                // like the point to point search a negative weight needs a loop at the node
+                if (new_weight < 0)
+                {
+                    const EdgeWeight loop_weight = ch::getLoopWeight<false>(facade, node);
+                    const EdgeWeight new_weight_with_loop = new_weight + loop_weight;
+                    if (loop_weight != INVALID_EDGE_WEIGHT && new_weight_with_loop >= 0 &&
+                        new_weight_with_loop < weights[column_idx])
+                    {
+                        weights[column_idx] = new_weight_with_loop;
+                        middle_nodes[column_idx] = node;
+                        loops[column_idx] = true;
+                    }
+                }
+                else if (new_weight < weights[column_idx])
+                {
+                    weights[column_idx] = new_weight;
+                    middle_nodes[column_idx] = node;
+                    loops[column_idx] = false;
+                }
+            }
+            row_upper_bound = *std::max_element(weights.begin(), weights.end());
+
+            if (ch::stallAtNode<FORWARD_DIRECTION>(facade, node, source_weight, query_heap))
+            {
+                continue;
+            }
+            relaxOutgoingEdges<FORWARD_DIRECTION>(
+                facade, node, source_weight, source_duration, query_heap);
+        }
+
+        // unpack the paths and measure them like getNetworkDistance
+        for (std::size_t column_idx = 0; column_idx < number_of_targets; ++column_idx)
+        {
+            const NodeID middle_node = middle_nodes[column_idx];
+            if (middle_node == SPECIAL_NODEID)
+            {
+                continue;
+            }
+
+            std::vector<NodeID> packed_path;
+            if (loops[column_idx])
+            {
+                // self loop makes up the full path
+                packed_path.push_back(middle_node);
+                packed_path.push_back(middle_node);
+            }
+            else
+            {
+                NodeID current_node = middle_node;
+                while (current_node != query_heap.GetData(current_node).parent)
+                {
+                    current_node = query_heap.GetData(current_node).parent;
+                    packed_path.emplace_back(current_node);
+                }
+                std::reverse(packed_path.begin(), packed_path.end());
+                packed_path.emplace_back(middle_node);
+                retrievePackedPathFromBuckets(
+                    search_space_with_buckets, column_idx, middle_node, packed_path);
+            }
+
+            const auto &target_phantom = target_phantoms[column_idx];
+            std::vector<PathData> unpacked_path;
+            unpackPath(facade,
+                       packed_path.begin(),
+                       packed_path.end(),
+                       {source_phantom, target_phantom},
+                       unpacked_path);
+            network_distances[row_idx * number_of_targets + column_idx] =
+                getPathDistance(facade, unpacked_path, source_phantom, target_phantom);
         }
-        ++row_idx;
+    }
+
+    return network_distances;
+}
+
+} // namespace ch
+
+namespace mld
+{
+
+using ManyToManyQueryHeap = SearchEngineData<Algorithm>::ManyToManyQueryHeap;
+
+namespace
+{
+// The search from a phantom node only knows its own end point, so the query level of a node
+// is the highest level on which it lies in a different cell than the phantom node.
+// Forward and backward searches meet on the overlay graph of the level that separates them.
+inline LevelID getNodeQueryLevel(const partition::MultiLevelPartitionView &partition,
+                                 const NodeID node,
+                                 const PhantomNode &phantom_node)
+{
+    auto highest_different_level = [&partition, node](const SegmentID &segment) {
+        if (segment.enabled)
+            return partition.GetHighestDifferentLevel(segment.id, node);
+        return INVALID_LEVEL_ID;
     };
 
-    if (target_indices.empty())
+    return std::min(highest_different_level(phantom_node.forward_segment_id),
+                    highest_different_level(phantom_node.reverse_segment_id));
+}
+
+// Distance of the edge between parent and node of a search tree, in search direction.
+// Overlay edges are unpacked by a search restricted to the cell of the overlay edge.
+template <bool DIRECTION>
+EdgeDistance
+getEdgeDistance(SearchEngineData<Algorithm> &engine_working_data,
+                const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                const ManyToManyQueryHeap &query_heap,
+                const PhantomNode &phantom_node,
+                const NodeID parent,
+                const NodeID node)
+{
+    // the backward search follows edges from the node to its parent
+    const NodeID from = DIRECTION == FORWARD_DIRECTION ? parent : node;
+    const NodeID to = DIRECTION == FORWARD_DIRECTION ? node : parent;
+
+    if (!query_heap.GetData(node).from_clique_arc)
+    {
+        return getTurnSourceLength(facade, facade.GetEdgeData(facade.FindEdge(from, to)).turn_id);
+    }
+
+    const auto &partition = facade.GetMultiLevelPartition();
+    const LevelID level = getNodeQueryLevel(partition, parent, phantom_node);
+    const CellID cell = partition.GetCell(level, parent);
+
+    engine_working_data.InitializeOrClearFirstThreadLocalStorage(facade.GetNumberOfNodes());
+    const auto unpacked_edges = unpackPackedPath(facade,
+                                                 *engine_working_data.forward_heap_1,
+                                                 *engine_working_data.reverse_heap_1,
+                                                 PackedPath{std::make_tuple(from, to, true)},
+                                                 DO_NOT_FORCE_LOOPS,
+                                                 DO_NOT_FORCE_LOOPS,
+                                                 level,
+                                                 cell);
+
+    EdgeDistance distance = 0;
+    for (const auto edge : unpacked_edges)
+    {
+        distance += getTurnSourceLength(facade, facade.GetEdgeData(edge).turn_id);
+    }
+    return distance;
+}
+
+// A path from a node back to itself through other nodes is found by the searches meeting at
+// one of these nodes. A loop over the node alone is a self-loop edge of the base graph.
+inline EdgeID getLoopEdge(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                          const NodeID node)
+{
+    EdgeID loop_edge = SPECIAL_EDGEID;
+    for (const auto edge : facade.GetAdjacentEdgeRange(node))
     {
-        for (const auto &phantom : phantom_nodes)
+        const auto &data = facade.GetEdgeData(edge);
+        if (data.forward && facade.GetTarget(edge) == node &&
+            (loop_edge == SPECIAL_EDGEID || data.weight < facade.GetEdgeData(loop_edge).weight))
         {
-            search_target_phantom(phantom);
+            loop_edge = edge;
         }
     }
-    else
+    return loop_edge;
+}
+
+template <bool DIRECTION>
+EdgeDistance getDistance(SearchEngineData<Algorithm> &engine_working_data,
+                         const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                         const ManyToManyQueryHeap &query_heap,
+                         const PhantomNode &phantom_node,
+                         SearchTreeDistances &distances,
+                         const NodeID node)
+{
+    return getSearchTreeDistance<DIRECTION>(
+        facade,
+        query_heap,
+        phantom_node,
+        distances,
+        node,
+        [&](const NodeID from, const NodeID to) {
+            return getEdgeDistance<DIRECTION>(
+                engine_working_data, facade, query_heap, phantom_node, from, to);
+        });
+}
+
+template <bool DIRECTION>
+void relaxOutgoingEdges(const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                        const NodeID node,
+                        const EdgeWeight weight,
+                        const EdgeWeight duration,
+                        ManyToManyQueryHeap &query_heap,
+                        const PhantomNode &phantom_node)
+{
+    const auto &partition = facade.GetMultiLevelPartition();
+    const auto &cells = facade.GetCellStorage();
+
+    const auto level = getNodeQueryLevel(partition, node, phantom_node);
+
+    const auto relax = [&](const NodeID to,
+                           const EdgeWeight to_weight,
+                           const EdgeWeight to_duration,
+                           const bool from_clique_arc) {
+        if (!query_heap.WasInserted(to))
+        {
+            query_heap.Insert(to, to_weight, {node, from_clique_arc, to_duration});
+        }
+        else if (to_weight < query_heap.GetKey(to))
+        {
+            query_heap.GetData(to) = {node, from_clique_arc, to_duration};
+            query_heap.DecreaseKey(to, to_weight);
+        }
+    };
+
+    if (level >= 1 && !query_heap.GetData(node).from_clique_arc)
     {
-        for (const auto index : target_indices)
+        const auto &cell = cells.GetCell(level, partition.GetCell(level, node));
+        if (DIRECTION == FORWARD_DIRECTION)
         {
-            const auto &phantom = phantom_nodes[index];
-            search_target_phantom(phantom);
+            // Shortcuts in forward direction
+            auto destination = cell.GetDestinationNodes().begin();
+            auto shortcut_durations = cell.GetOutDuration(node);
+            auto shortcut_duration = shortcut_durations.begin();
+            for (auto shortcut_weight : cell.GetOutWeight(node))
+            {
+                BOOST_ASSERT(destination != cell.GetDestinationNodes().end());
+                BOOST_ASSERT(shortcut_duration != shortcut_durations.end());
+                const NodeID to = *destination;
+                if (shortcut_weight != INVALID_EDGE_WEIGHT && node != to)
+                {
+                    relax(to, weight + shortcut_weight, duration + *shortcut_duration, true);
+                }
+                ++destination;
+                ++shortcut_duration;
+            }
+        }
+        else
+        {
+            // Shortcuts in backward direction
+            auto source = cell.GetSourceNodes().begin();
+            auto shortcut_durations = cell.GetInDuration(node);
+            auto shortcut_duration = shortcut_durations.begin();
+            for (auto shortcut_weight : cell.GetInWeight(node))
+            {
+                BOOST_ASSERT(source != cell.GetSourceNodes().end());
+                BOOST_ASSERT(shortcut_duration != shortcut_durations.end());
+                const NodeID to = *source;
+                if (shortcut_weight != INVALID_EDGE_WEIGHT && node != to)
+                {
+                    relax(to, weight + shortcut_weight, duration + *shortcut_duration, true);
+                }
+                ++source;
+                ++shortcut_duration;
+            }
         }
     }
 
-    if (source_indices.empty())
+    // Boundary edges
+    for (const auto edge : facade.GetBorderEdgeRange(level, node))
     {
-        for (const auto &phantom : phantom_nodes)
+        const auto &data = facade.GetEdgeData(edge);
+        if (DIRECTION == FORWARD_DIRECTION ? data.forward : data.backward)
         {
-            search_source_phantom(phantom);
+            BOOST_ASSERT_MSG(data.weight > 0, "edge_weight invalid");
+            relax(facade.GetTarget(edge), weight + data.weight, duration + data.duration, false);
         }
     }
-    else
+}
+
+template <typename BucketT>
+void forwardRoutingStep(SearchEngineData<Algorithm> &engine_working_data,
+                        const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                        const unsigned row_idx,
+                        const unsigned number_of_targets,
+                        ManyToManyQueryHeap &query_heap,
+                        const std::vector<BucketT> &search_space_with_buckets,
+                        std::vector<EdgeWeight> &weights_table,
+                        std::vector<EdgeWeight> &durations_table,
+                        std::vector<EdgeDistance> &distances_table,
+                        SearchTreeDistances &distances,
+                        const PhantomNode &phantom_node)
+{
+    const NodeID node = query_heap.DeleteMin();
+    const EdgeWeight source_weight = query_heap.GetKey(node);
+    const EdgeWeight source_duration = query_heap.GetData(node).duration;
+
+    const auto get_distance = [&] {
+        return getDistance<FORWARD_DIRECTION>(
+            engine_working_data, facade, query_heap, phantom_node, distances, node);
+    };
+
+    for (const BucketT &current_bucket : getBuckets(search_space_with_buckets, node))
     {
-        for (const auto index : source_indices)
+        const unsigned column_idx = current_bucket.target_id;
+        const auto entry_idx = row_idx * number_of_targets + column_idx;
+        auto &current_weight = weights_table[entry_idx];
+        auto &current_duration = durations_table[entry_idx];
+
+        // Paths with a negative weight only occur if source and target are on the same
+        // segment and the target lies behind the source, the route has to loop back to it
+        const EdgeWeight new_weight = source_weight + current_bucket.weight;
+        if (new_weight < 0)
         {
-            const auto &phantom = phantom_nodes[index];
-            search_source_phantom(phantom);
+            const EdgeID loop_edge = getLoopEdge(facade, node);
+            if (loop_edge == SPECIAL_EDGEID)
+            {
+                continue;
+            }
+            const auto &loop_data = facade.GetEdgeData(loop_edge);
+            const EdgeWeight new_weight_with_loop = new_weight + loop_data.weight;
+            if (new_weight_with_loop >= 0 && new_weight_with_loop < current_weight)
+            {
+                current_weight = new_weight_with_loop;
+                current_duration = source_duration + current_bucket.duration + loop_data.duration;
+                updateDistance(current_bucket, distances_table, entry_idx, [&] {
+                    return get_distance() + getTurnSourceLength(facade, loop_data.turn_id);
+                });
+            }
+        }
+        else if (new_weight < current_weight)
+        {
+            current_weight = new_weight;
+            current_duration = source_duration + current_bucket.duration;
+            updateDistance(current_bucket, distances_table, entry_idx, get_distance);
         }
     }
 
-    return durations_table;
+    relaxOutgoingEdges<FORWARD_DIRECTION>(
+        facade, node, source_weight, source_duration, query_heap, phantom_node);
 }
 
-} // namespace ch
+template <typename BucketT>
+void backwardRoutingStep(SearchEngineData<Algorithm> &engine_working_data,
+                         const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                         const unsigned column_idx,
+                         ManyToManyQueryHeap &query_heap,
+                         std::vector<BucketT> &buckets,
+                         SearchTreeDistances &distances,
+                         const PhantomNode &phantom_node)
+{
+    const NodeID node = query_heap.DeleteMin();
+    const EdgeWeight target_weight = query_heap.GetKey(node);
+    const EdgeWeight target_duration = query_heap.GetData(node).duration;
+
+    // store settled nodes in search space bucket
+    addBucket(buckets, node, column_idx, target_weight, target_duration, [&] {
+        return getDistance<REVERSE_DIRECTION>(
+            engine_working_data, facade, query_heap, phantom_node, distances, node);
+    });
+
+    relaxOutgoingEdges<REVERSE_DIRECTION>(
+        facade, node, target_weight, target_duration, query_heap, phantom_node);
+}
+
+template <typename BucketT>
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
+searchWithBuckets(SearchEngineData<Algorithm> &engine_working_data,
+                  const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                  const std::vector<PhantomNode> &phantom_nodes,
+                  const std::vector<std::size_t> &source_indices,
+                  const std::vector<std::size_t> &target_indices,
+                  const unsigned max_threads,
+                  const bool calculate_distance)
+{
+    const auto number_of_sources =
+        source_indices.empty() ? phantom_nodes.size() : source_indices.size();
+    const auto number_of_targets =
+        target_indices.empty() ? phantom_nodes.size() : target_indices.size();
+    const auto number_of_entries = number_of_sources * number_of_targets;
+
+    std::vector<EdgeWeight> weights_table(number_of_entries, INVALID_EDGE_WEIGHT);
+    std::vector<EdgeWeight> durations_table(number_of_entries, MAXIMAL_EDGE_DURATION);
+    std::vector<EdgeDistance> distances_table(calculate_distance ? number_of_entries : 0,
+                                              INVALID_EDGE_DISTANCE);
+
+    std::vector<std::vector<BucketT>> column_buckets(number_of_targets);
+    runSearches(number_of_targets, max_threads, [&](const std::size_t column_idx) {
+        const auto &phantom =
+            phantom_nodes[target_indices.empty() ? column_idx : target_indices[column_idx]];
+
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
+        insertNodesInHeap<REVERSE_DIRECTION>(query_heap, phantom);
+
+        SearchTreeDistances distances;
+        while (!query_heap.Empty())
+        {
+            backwardRoutingStep(engine_working_data,
+                                facade,
+                                column_idx,
+                                query_heap,
+                                column_buckets[column_idx],
+                                distances,
+                                phantom);
+        }
+    });
+
+    const auto search_space_with_buckets = mergeBuckets(column_buckets);
+
+    runSearches(number_of_sources, max_threads, [&](const std::size_t row_idx) {
+        const auto &phantom =
+            phantom_nodes[source_indices.empty() ? row_idx : source_indices[row_idx]];
+
+        engine_working_data.InitializeOrClearManyToManyThreadLocalStorage(
+            facade.GetNumberOfNodes());
+        auto &query_heap = *(engine_working_data.many_to_many_heap);
+        insertNodesInHeap<FORWARD_DIRECTION>(query_heap, phantom);
+
+        SearchTreeDistances distances;
+        while (!query_heap.Empty())
+        {
+            forwardRoutingStep(engine_working_data,
+                               facade,
+                               row_idx,
+                               number_of_targets,
+                               query_heap,
+                               search_space_with_buckets,
+                               weights_table,
+                               durations_table,
+                               distances_table,
+                               distances,
+                               phantom);
+        }
+    });
+
+    return std::make_pair(std::move(durations_table), std::move(distances_table));
+}
+}
+
+std::pair<std::vector<EdgeWeight>, std::vector<EdgeDistance>>
+manyToManySearch(SearchEngineData<Algorithm> &engine_working_data,
+                 const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &facade,
+                 const std::vector<PhantomNode> &phantom_nodes,
+                 const std::vector<std::size_t> &source_indices,
+                 const std::vector<std::size_t> &target_indices,
+                 const unsigned max_threads,
+                 const bool calculate_distance)
+{
+    if (calculate_distance)
+    {
+        return searchWithBuckets<NodeBucketWithDistance>(engine_working_data,
+                                                         facade,
+                                                         phantom_nodes,
+                                                         source_indices,
+                                                         target_indices,
+                                                         max_threads,
+                                                         calculate_distance);
+    }
+    return searchWithBuckets<NodeBucket>(engine_working_data,
+                                         facade,
+                                         phantom_nodes,
+                                         source_indices,
+                                         target_indices,
+                                         max_threads,
+                                         calculate_distance);
+}
+
+} // namespace mld
 } // namespace routing_algorithms
 } // namespace engine
 } // namespace osrm
@@ -1,4 +1,5 @@
 #include "engine/routing_algorithms/map_matching.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
 #include "engine/routing_algorithms/routing_base_ch.hpp"
 #include "engine/routing_algorithms/routing_base_mld.hpp"
 
@@ -46,6 +47,32 @@ unsigned getMedianSampleTime(const std::vector<unsigned> &timestamps)
     std::nth_element(first_elem, median, sample_times.end());
     return *median;
 }
+
+// Network distances between the candidates of two timestamps in row-major order. An empty
+// table means that each transition is searched when it is needed.
+template <typename Algorithm>
+std::vector<double>
+getTransitionDistances(SearchEngineData<Algorithm> &,
+                       const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> &,
+                       const std::vector<PhantomNode> &,
+                       const std::vector<PhantomNode> &,
+                       const int)
+{
+    return {};
+}
+
+// With CH all transitions are computed by one bucket based search per candidate, so the
+// candidates share their search spaces
+std::vector<double>
+getTransitionDistances(SearchEngineData<ch::Algorithm> &engine_working_data,
+                       const datafacade::ContiguousInternalMemoryDataFacade<ch::Algorithm> &facade,
+                       const std::vector<PhantomNode> &source_phantoms,
+                       const std::vector<PhantomNode> &target_phantoms,
+                       const int duration_upper_bound)
+{
+    return ch::getNetworkDistances(
+        engine_working_data, facade, source_phantoms, target_phantoms, duration_upper_bound);
+}
 }
 
 template <typename Algorithm>
@@ -202,14 +229,32 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
             const int duration_upper_bound =
                 ((haversine_distance + max_distance_delta) * 0.25) * 10;
 
-            // compute d_t for this timestamp and the next one
+            std::vector<std::size_t> prev_candidates;
+            std::vector<PhantomNode> source_phantoms;
             for (const auto s : util::irange<std::size_t>(0UL, prev_viterbi.size()))
             {
-                if (prev_pruned[s])
+                if (!prev_pruned[s])
                 {
-                    continue;
+                    prev_candidates.push_back(s);
+                    source_phantoms.push_back(prev_unbroken_timestamps_list[s].phantom_node);
                 }
+            }
+            std::vector<PhantomNode> target_phantoms;
+            target_phantoms.reserve(current_timestamps_list.size());
+            for (const auto &candidate : current_timestamps_list)
+            {
+                target_phantoms.push_back(candidate.phantom_node);
+            }
+            const auto transition_distances = getTransitionDistances(engine_working_data,
+                                                                     facade,
+                                                                     source_phantoms,
+                                                                     target_phantoms,
+                                                                     duration_upper_bound);
 
+            // compute d_t for this timestamp and the next one
+            for (const auto row : util::irange<std::size_t>(0UL, prev_candidates.size()))
+            {
+                const auto s = prev_candidates[row];
                 for (const auto s_prime : util::irange<std::size_t>(0UL, current_viterbi.size()))
                 {
                     const double emission_pr = emission_log_probabilities[t][s_prime];
@@ -219,15 +264,17 @@ SubMatchingList mapMatching(SearchEngineData<Algorithm> &engine_working_data,
                         continue;
                     }
 
-                    double network_distance =
-                        getNetworkDistance(facade,
-                                           forward_heap,
-                                           reverse_heap,
-                                           forward_core_heap,
-                                           reverse_core_heap,
-                                           prev_unbroken_timestamps_list[s].phantom_node,
-                                           current_timestamps_list[s_prime].phantom_node,
-                                           duration_upper_bound);
+                    const double network_distance =
+                        transition_distances.empty()
+                            ? getNetworkDistance(facade,
+                                                 forward_heap,
+                                                 reverse_heap,
+                                                 forward_core_heap,
+                                                 reverse_core_heap,
+                                                 source_phantoms[row],
+                                                 target_phantoms[s_prime],
+                                                 duration_upper_bound)
+                            : transition_distances[row * target_phantoms.size() + s_prime];
 
                     // get distance diff between loc1/2 and locs/s_prime
                     const auto d_t = std::abs(network_distance - haversine_distance);
@@ -32,7 +32,7 @@ typename SearchEngineData<Algorithm>::ManyToManyHeapPtr
 template <typename Algorithm>
 void SearchEngineData<Algorithm>::InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_1.get())
+    if (forward_heap_1.get() && forward_heap_1->MaxID() == number_of_nodes)
     {
         forward_heap_1->Clear();
     }
@@ -41,7 +41,7 @@ void SearchEngineData<Algorithm>::InitializeOrClearFirstThreadLocalStorage(unsig
         forward_heap_1.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_1.get())
+    if (reverse_heap_1.get() && reverse_heap_1->MaxID() == number_of_nodes)
     {
         reverse_heap_1->Clear();
     }
@@ -55,7 +55,7 @@ template <typename Algorithm>
 void SearchEngineData<Algorithm>::InitializeOrClearSecondThreadLocalStorage(
     unsigned number_of_nodes)
 {
-    if (forward_heap_2.get())
+    if (forward_heap_2.get() && forward_heap_2->MaxID() == number_of_nodes)
     {
         forward_heap_2->Clear();
     }
@@ -64,7 +64,7 @@ void SearchEngineData<Algorithm>::InitializeOrClearSecondThreadLocalStorage(
         forward_heap_2.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_2.get())
+    if (reverse_heap_2.get() && reverse_heap_2->MaxID() == number_of_nodes)
     {
         reverse_heap_2->Clear();
     }
@@ -77,7 +77,7 @@ void SearchEngineData<Algorithm>::InitializeOrClearSecondThreadLocalStorage(
 template <typename Algorithm>
 void SearchEngineData<Algorithm>::InitializeOrClearThirdThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_3.get())
+    if (forward_heap_3.get() && forward_heap_3->MaxID() == number_of_nodes)
     {
         forward_heap_3->Clear();
     }
@@ -86,7 +86,7 @@ void SearchEngineData<Algorithm>::InitializeOrClearThirdThreadLocalStorage(unsig
         forward_heap_3.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_3.get())
+    if (reverse_heap_3.get() && reverse_heap_3->MaxID() == number_of_nodes)
     {
         reverse_heap_3->Clear();
     }
@@ -100,7 +100,7 @@ template <typename Algorithm>
 void SearchEngineData<Algorithm>::InitializeOrClearManyToManyThreadLocalStorage(
     unsigned number_of_nodes)
 {
-    if (many_to_many_heap.get())
+    if (many_to_many_heap.get() && many_to_many_heap->MaxID() == number_of_nodes)
     {
         many_to_many_heap->Clear();
     }
@@ -161,10 +161,11 @@ SearchEngineData<MLD>::SearchEngineHeapPtr SearchEngineData<MLD>::forward_heap_1
 SearchEngineData<MLD>::SearchEngineHeapPtr SearchEngineData<MLD>::reverse_heap_1;
 SearchEngineData<MLD>::SearchEngineHeapPtr SearchEngineData<MLD>::forward_heap_2;
 SearchEngineData<MLD>::SearchEngineHeapPtr SearchEngineData<MLD>::reverse_heap_2;
+SearchEngineData<MLD>::ManyToManyHeapPtr SearchEngineData<MLD>::many_to_many_heap;
 
 void SearchEngineData<MLD>::InitializeOrClearFirstThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_1.get())
+    if (forward_heap_1.get() && forward_heap_1->MaxID() == number_of_nodes)
     {
         forward_heap_1->Clear();
     }
@@ -173,7 +174,7 @@ void SearchEngineData<MLD>::InitializeOrClearFirstThreadLocalStorage(unsigned nu
         forward_heap_1.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_1.get())
+    if (reverse_heap_1.get() && reverse_heap_1->MaxID() == number_of_nodes)
     {
         reverse_heap_1->Clear();
     }
@@ -183,24 +184,36 @@ void SearchEngineData<MLD>::InitializeOrClearFirstThreadLocalStorage(unsigned nu
     }
 }
 
-void SearchEngineData<MLD>::InitializeOrClearSecondThreadLocalStorage(unsigned)
+void SearchEngineData<MLD>::InitializeOrClearSecondThreadLocalStorage(unsigned number_of_nodes)
 {
-    if (forward_heap_2.get())
+    if (forward_heap_2.get() && forward_heap_2->MaxID() == number_of_nodes)
     {
         forward_heap_2->Clear();
     }
     else
     {
-        forward_heap_2.reset(new QueryHeap(1));
+        forward_heap_2.reset(new QueryHeap(number_of_nodes));
     }
 
-    if (reverse_heap_2.get())
+    if (reverse_heap_2.get() && reverse_heap_2->MaxID() == number_of_nodes)
     {
         reverse_heap_2->Clear();
     }
     else
     {
-        reverse_heap_2.reset(new QueryHeap(1));
+        reverse_heap_2.reset(new QueryHeap(number_of_nodes));
+    }
+}
+
+void SearchEngineData<MLD>::InitializeOrClearManyToManyThreadLocalStorage(unsigned number_of_nodes)
+{
+    if (many_to_many_heap.get() && many_to_many_heap->MaxID() == number_of_nodes)
+    {
+        many_to_many_heap->Clear();
+    }
+    else
+    {
+        many_to_many_heap.reset(new ManyToManyQueryHeap(number_of_nodes));
     }
 }
 }
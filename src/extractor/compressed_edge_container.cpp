@@ -7,6 +7,7 @@
 
 #include <limits>
 #include <string>
+#include <utility>
 
 #include <iostream>
 
@@ -212,6 +213,27 @@ void CompressedEdgeContainer::AddUncompressedEdge(const EdgeID edge_id,
     }
 }
 
+void CompressedEdgeContainer::AddCompressedEdge(const EdgeID edge_id, OnewayEdgeBucket geometry)
+{
+    BOOST_ASSERT(SPECIAL_EDGEID != edge_id);
+    BOOST_ASSERT(!geometry.empty());
+    BOOST_ASSERT(!HasEntryForID(edge_id));
+
+    if (0 == m_free_list.size())
+    {
+        // make sure there is a place to put the entries
+        IncreaseFreeList();
+    }
+    BOOST_ASSERT(!m_free_list.empty());
+    const unsigned edge_bucket_id = m_free_list.back();
+    m_free_list.pop_back();
+    m_edge_id_to_list_index_map[edge_id] = edge_bucket_id;
+
+    BOOST_ASSERT(edge_bucket_id < m_compressed_oneway_geometries.size());
+    BOOST_ASSERT(m_compressed_oneway_geometries[edge_bucket_id].empty());
+    m_compressed_oneway_geometries[edge_bucket_id] = std::move(geometry);
+}
+
 void CompressedEdgeContainer::InitializeBothwayVector()
 {
     segment_data = std::make_unique<SegmentDataContainer>();
@@ -21,13 +21,19 @@
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/pipeline.h>
+#include <tbb/task_scheduler_init.h>
+
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
 namespace osrm
 {
@@ -338,9 +344,6 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     // Writes a dummy value at the front that is updated later with the total length
     edge_data_file.WriteElementCount64(0);
 
-    std::vector<OriginalEdgeData> original_edge_data_vector;
-    original_edge_data_vector.reserve(1024 * 1024);
-
     // Loop over all turns and generate new set of edges.
     // Three nested loop look super-linear, but we are dealing with a (kind of)
     // linear number of turns only.
@@ -355,12 +358,12 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                                          profile_properties);
 
     util::guidance::LaneDataIdMap lane_data_map;
-    guidance::lanes::TurnLaneHandler turn_lane_handler(*m_node_based_graph,
-                                                       turn_lane_offsets,
-                                                       turn_lane_masks,
-                                                       lane_description_map,
-                                                       turn_analysis,
-                                                       lane_data_map);
+    // lane descriptions combined for sliproads, numbered after the ones in lane_description_map
+    // which is only read while the blocks are processed
+    guidance::LaneDescriptionMap added_lane_descriptions;
+    const auto number_of_lane_descriptions = lane_description_map.size();
+    std::size_t handled_lanes = 0;
+    std::size_t called_lanes = 0;
 
     bearing_class_by_node_based_node.resize(m_node_based_graph->GetNumberOfNodes(),
                                             std::numeric_limits<std::uint32_t>::max());
@@ -372,17 +375,43 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     const auto weight_multiplier =
         scripting_environment.GetProfileProperties().GetWeightMultiplier();
 
+    // Output of a block of intersections. Entry classes, bearing classes, lane data and added
+    // lane descriptions are numbered locally in the order they are first seen inside the block,
+    // merging the blocks in order assigns the same global ids a single pass would.
+    struct ExpansionBlock
     {
-        util::UnbufferedLog log;
+        NodeID begin;
+        NodeID end;
+        std::size_t node_based_edges = 0;
+        std::vector<EdgeBasedEdge> edges;
+        std::vector<ExtractionTurn> turns;
+        std::vector<OriginalEdgeData> original_edge_data;
+        std::vector<TurnPenalty> weight_penalties;
+        std::vector<TurnPenalty> duration_penalties;
+        std::vector<lookup::TurnIndexBlock> turn_indexes;
+        std::vector<std::pair<NodeID, BearingClassID>> bearing_class_by_node;
+        std::unordered_map<util::guidance::EntryClass, EntryClassID> entry_classes;
+        std::unordered_map<util::guidance::BearingClass, BearingClassID> bearing_classes;
+        guidance::LaneDescriptionMap added_lane_descriptions;
+        util::guidance::LaneDataIdMap lane_data_map;
+        std::size_t handled_lanes = 0;
+        std::size_t called_lanes = 0;
+    };
+    using ExpansionBlockPtr = std::shared_ptr<ExpansionBlock>;
+
+    const auto process_block = [&](ExpansionBlockPtr block) {
+        guidance::lanes::TurnLaneHandler turn_lane_handler(*m_node_based_graph,
+                                                           turn_lane_offsets,
+                                                           turn_lane_masks,
+                                                           lane_description_map,
+                                                           block->added_lane_descriptions,
+                                                           turn_analysis,
+                                                           block->lane_data_map);
 
-        util::Percent progress(log, m_node_based_graph->GetNumberOfNodes());
         // going over all nodes (which form the center of an intersection), we compute all
         // possible turns along these intersections.
-        for (const auto node_at_center_of_intersection :
-             util::irange(0u, m_node_based_graph->GetNumberOfNodes()))
+        for (const auto node_at_center_of_intersection : util::irange(block->begin, block->end))
         {
-            progress.PrintStatus(node_at_center_of_intersection);
-
             const auto shape_result =
                 turn_analysis.ComputeIntersectionShapes(node_at_center_of_intersection);
 
@@ -417,7 +446,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 if (m_node_based_graph->GetEdgeData(incoming_edge).reversed)
                     continue;
 
-                ++node_based_edge_counter;
+                ++block->node_based_edges;
 
                 auto intersection_with_flags_and_angles =
                     turn_analysis.GetIntersectionGenerator().TransformIntersectionShapeIntoView(
@@ -440,32 +469,34 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 const auto turn_classification = classifyIntersection(intersection);
 
                 const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
-                    if (0 == entry_class_hash.count(entry_class))
+                    if (0 == block->entry_classes.count(entry_class))
                     {
-                        const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
-                        entry_class_hash[entry_class] = id;
+                        const auto id = static_cast<std::uint16_t>(block->entry_classes.size());
+                        block->entry_classes[entry_class] = id;
                         return id;
                     }
                     else
                     {
-                        return entry_class_hash.find(entry_class)->second;
+                        return block->entry_classes.find(entry_class)->second;
                     }
                 }(turn_classification.first);
 
                 const auto bearing_class_id =
                     [&](const util::guidance::BearingClass bearing_class) {
-                        if (0 == bearing_class_hash.count(bearing_class))
+                        if (0 == block->bearing_classes.count(bearing_class))
                         {
-                            const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
-                            bearing_class_hash[bearing_class] = id;
+                            const auto id =
+                                static_cast<std::uint32_t>(block->bearing_classes.size());
+                            block->bearing_classes[bearing_class] = id;
                             return id;
                         }
                         else
                         {
-                            return bearing_class_hash.find(bearing_class)->second;
+                            return block->bearing_classes.find(bearing_class)->second;
                         }
                     }(turn_classification.second);
-                bearing_class_by_node_based_node[node_at_center_of_intersection] = bearing_class_id;
+                block->bearing_class_by_node.emplace_back(node_at_center_of_intersection,
+                                                          bearing_class_id);
 
                 for (const auto &turn : intersection)
                 {
@@ -489,7 +520,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                     BOOST_ASSERT(is_encoded_forwards || is_encoded_backwards);
                     if (is_encoded_forwards)
                     {
-                        original_edge_data_vector.emplace_back(
+                        block->original_edge_data.emplace_back(
                             GeometryID{m_compressed_edge_container.GetZippedPositionForForwardID(
                                            incoming_edge),
                                        true},
@@ -503,7 +534,7 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                     }
                     else if (is_encoded_backwards)
                     {
-                        original_edge_data_vector.emplace_back(
+                        block->original_edge_data.emplace_back(
                             GeometryID{m_compressed_edge_container.GetZippedPositionForReverseID(
                                            incoming_edge),
                                        false},
@@ -516,50 +547,25 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                             util::guidance::TurnBearing(turn.bearing));
                     }
 
-                    ++original_edges_counter;
-                    if (original_edge_data_vector.size() > 1024 * 1024 * 10)
-                    {
-                        FlushVectorToStream(edge_data_file, original_edge_data_vector);
-                    }
-
-                    // compute weight and duration penalties
+                    // the weight and duration penalties are added once all turns of the block
+                    // went through the turn function
                     auto is_traffic_light = m_traffic_lights.count(node_at_center_of_intersection);
-                    ExtractionTurn extracted_turn(turn, is_traffic_light);
-                    extracted_turn.source_restricted = edge_data1.restricted;
-                    extracted_turn.target_restricted = edge_data2.restricted;
-                    scripting_environment.ProcessTurn(extracted_turn);
-
-                    // turn penalties are limited to [-2^15, 2^15) which roughly
-                    // translates to 54 minutes and fits signed 16bit deci-seconds
-                    auto weight_penalty =
-                        boost::numeric_cast<TurnPenalty>(extracted_turn.weight * weight_multiplier);
-                    auto duration_penalty =
-                        boost::numeric_cast<TurnPenalty>(extracted_turn.duration * 10.);
+                    block->turns.emplace_back(turn, is_traffic_light);
+                    block->turns.back().source_restricted = edge_data1.restricted;
+                    block->turns.back().target_restricted = edge_data2.restricted;
 
                     BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
                     BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
 
-                    // NOTE: potential overflow here if we hit 2^32 routable edges
-                    BOOST_ASSERT(m_edge_based_edge_list.size() <=
-                                 std::numeric_limits<NodeID>::max());
-                    auto turn_id = m_edge_based_edge_list.size();
-                    auto weight =
-                        boost::numeric_cast<EdgeWeight>(edge_data1.weight + weight_penalty);
-                    auto duration =
-                        boost::numeric_cast<EdgeWeight>(edge_data1.duration + duration_penalty);
-                    m_edge_based_edge_list.emplace_back(edge_data1.edge_id,
-                                                        edge_data2.edge_id,
-                                                        turn_id,
-                                                        weight,
-                                                        duration,
-                                                        true,
-                                                        false);
-                    BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
-
-                    BOOST_ASSERT(turn_weight_penalties.size() == turn_id);
-                    turn_weight_penalties.push_back(weight_penalty);
-                    BOOST_ASSERT(turn_duration_penalties.size() == turn_id);
-                    turn_duration_penalties.push_back(duration_penalty);
+                    // the turn id is relative to the block until it is merged
+                    auto turn_id = block->edges.size();
+                    block->edges.emplace_back(edge_data1.edge_id,
+                                              edge_data2.edge_id,
+                                              turn_id,
+                                              edge_data1.weight,
+                                              edge_data1.duration,
+                                              true,
+                                              false);
 
                     // We write out the mapping between the edge-expanded edges and the
                     // original nodes. Since each edge represents a possible maneuver, external
@@ -586,15 +592,177 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                         m_node_info_list[m_compressed_edge_container.GetFirstEdgeTargetID(
                             turn.eid)];
 
-                    lookup::TurnIndexBlock turn_index_block = {
-                        from_node.node_id, via_node.node_id, to_node.node_id};
-
-                    turn_penalties_index_file.WriteOne(turn_index_block);
+                    block->turn_indexes.push_back(
+                        {from_node.node_id, via_node.node_id, to_node.node_id});
                 }
             }
         }
+
+        // compute weight and duration penalties, one batch per block keeps the turn function
+        // calls on the per thread lua states
+        scripting_environment.ProcessTurns(block->turns);
+        BOOST_ASSERT(block->turns.size() == block->edges.size());
+        block->weight_penalties.reserve(block->turns.size());
+        block->duration_penalties.reserve(block->turns.size());
+        for (const auto index : util::irange<std::size_t>(0, block->turns.size()))
+        {
+            const auto &extracted_turn = block->turns[index];
+
+            // turn penalties are limited to [-2^15, 2^15) which roughly
+            // translates to 54 minutes and fits signed 16bit deci-seconds
+            auto weight_penalty =
+                boost::numeric_cast<TurnPenalty>(extracted_turn.weight * weight_multiplier);
+            auto duration_penalty =
+                boost::numeric_cast<TurnPenalty>(extracted_turn.duration * 10.);
+
+            auto &edge_data = block->edges[index].data;
+            edge_data.weight = boost::numeric_cast<EdgeWeight>(edge_data.weight + weight_penalty);
+            edge_data.duration =
+                boost::numeric_cast<EdgeWeight>(edge_data.duration + duration_penalty);
+
+            block->weight_penalties.push_back(weight_penalty);
+            block->duration_penalties.push_back(duration_penalty);
+        }
+        block->turns = std::vector<ExtractionTurn>();
+
+        block->handled_lanes = turn_lane_handler.GetNumberOfHandledLanes();
+        block->called_lanes = turn_lane_handler.GetNumberOfCalledLanes();
+        return block;
+    };
+
+    // Orders the keys of a map by their ids
+    const auto keys_by_id = [](const auto &ids, const std::size_t first_id) {
+        std::vector<const typename std::decay_t<decltype(ids)>::key_type *> keys(ids.size());
+        for (const auto &entry : ids)
+            keys[entry.second - first_id] = &entry.first;
+        return keys;
+    };
+
+    const auto merge_block = [&](ExpansionBlockPtr block) {
+        std::vector<EntryClassID> entry_class_ids;
+        for (const auto entry_class : keys_by_id(block->entry_classes, 0))
+        {
+            const auto inserted = entry_class_hash.insert(
+                {*entry_class, static_cast<std::uint16_t>(entry_class_hash.size())});
+            entry_class_ids.push_back(inserted.first->second);
+        }
+
+        std::vector<BearingClassID> bearing_class_ids;
+        for (const auto bearing_class : keys_by_id(block->bearing_classes, 0))
+        {
+            const auto inserted = bearing_class_hash.insert(
+                {*bearing_class, static_cast<std::uint32_t>(bearing_class_hash.size())});
+            bearing_class_ids.push_back(inserted.first->second);
+        }
+        for (const auto &node_and_class : block->bearing_class_by_node)
+        {
+            bearing_class_by_node_based_node[node_and_class.first] =
+                bearing_class_ids[node_and_class.second];
+        }
+
+        std::vector<LaneDescriptionID> lane_description_ids;
+        for (const auto description :
+             keys_by_id(block->added_lane_descriptions, number_of_lane_descriptions))
+        {
+            const auto inserted = added_lane_descriptions.insert(
+                {*description,
+                 boost::numeric_cast<LaneDescriptionID>(number_of_lane_descriptions +
+                                                        added_lane_descriptions.size())});
+            lane_description_ids.push_back(inserted.first->second);
+        }
+
+        std::vector<LaneDataID> lane_data_ids;
+        for (const auto lane_data : keys_by_id(block->lane_data_map, 0))
+        {
+            auto key = *lane_data;
+            if (key.second != INVALID_LANE_DESCRIPTIONID &&
+                key.second >= number_of_lane_descriptions)
+                key.second = lane_description_ids[key.second - number_of_lane_descriptions];
+
+            const auto inserted = lane_data_map.insert(
+                {key, boost::numeric_cast<LaneDataID>(lane_data_map.size())});
+            lane_data_ids.push_back(inserted.first->second);
+        }
+
+        for (auto &data : block->original_edge_data)
+        {
+            data.entry_classid = entry_class_ids[data.entry_classid];
+            if (data.lane_data_id != INVALID_LANE_DATAID)
+                data.lane_data_id = lane_data_ids[data.lane_data_id];
+        }
+
+        // NOTE: potential overflow here if we hit 2^32 routable edges
+        BOOST_ASSERT(m_edge_based_edge_list.size() + block->edges.size() <=
+                     std::numeric_limits<NodeID>::max());
+        const auto first_turn_id = m_edge_based_edge_list.size();
+        for (auto &edge : block->edges)
+        {
+            edge.data.turn_id += first_turn_id;
+            m_edge_based_edge_list.push_back(edge);
+        }
+
+        turn_weight_penalties.insert(turn_weight_penalties.end(),
+                                     block->weight_penalties.begin(),
+                                     block->weight_penalties.end());
+        turn_duration_penalties.insert(turn_duration_penalties.end(),
+                                       block->duration_penalties.begin(),
+                                       block->duration_penalties.end());
+
+        node_based_edge_counter += block->node_based_edges;
+        original_edges_counter += block->original_edge_data.size();
+        FlushVectorToStream(edge_data_file, block->original_edge_data);
+        turn_penalties_index_file.WriteFrom(block->turn_indexes);
+
+        handled_lanes += block->handled_lanes;
+        called_lanes += block->called_lanes;
+        BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
+        BOOST_ASSERT(turn_weight_penalties.size() == m_edge_based_edge_list.size());
+    };
+
+    {
+        util::UnbufferedLog log;
+
+        const NodeID number_of_nodes = m_node_based_graph->GetNumberOfNodes();
+        util::Percent progress(log, number_of_nodes);
+
+        // Intersections are expanded in parallel blocks, the blocks are merged in order so
+        // edge ids and all written files are the same as for a single thread.
+        const constexpr NodeID BLOCK_SIZE = 1024;
+        NodeID next_block = 0;
+
+        const auto make_blocks = tbb::make_filter<void, ExpansionBlockPtr>(
+            tbb::filter::serial_in_order, [&](tbb::flow_control &control) {
+                if (next_block >= number_of_nodes)
+                {
+                    control.stop();
+                    return ExpansionBlockPtr{};
+                }
+                auto block = std::make_shared<ExpansionBlock>();
+                block->begin = next_block;
+                block->end = std::min(number_of_nodes, next_block + BLOCK_SIZE);
+                next_block = block->end;
+                return block;
+            });
+
+        const auto expand_blocks = tbb::make_filter<ExpansionBlockPtr, ExpansionBlockPtr>(
+            tbb::filter::parallel, process_block);
+
+        const auto merge_blocks = tbb::make_filter<ExpansionBlockPtr, void>(
+            tbb::filter::serial_in_order, [&](ExpansionBlockPtr block) {
+                merge_block(block);
+                progress.PrintStatus(block->end);
+            });
+
+        tbb::parallel_pipeline(tbb::task_scheduler_init::default_num_threads() * 4,
+                               make_blocks & expand_blocks & merge_blocks);
     }
 
+    for (const auto &description : added_lane_descriptions)
+        lane_description_map.insert(description);
+
+    util::Log() << "Handled: " << handled_lanes << " of " << called_lanes
+                << " lanes: " << (double)(handled_lanes * 100) / (called_lanes) << " %.";
+
     // write weight penalties per turn
     BOOST_ASSERT(turn_weight_penalties.size() == turn_duration_penalties.size());
     {
@@ -626,8 +794,6 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
     util::Log() << "done.";
 
-    FlushVectorToStream(edge_data_file, original_edge_data_vector);
-
     // Finally jump back to the empty space at the beginning and write length prefix
     edge_data_file.SkipToBeginning();
 
@@ -8,6 +8,7 @@
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
 #include "util/io.hpp"
+#include "util/integer_range.hpp"
 #include "util/log.hpp"
 #include "util/name_table.hpp"
 #include "util/timing_util.hpp"
@@ -21,6 +22,9 @@
 #include <boost/ref.hpp>
 
 #include <stxxl/sort>
+#include <stxxl/stats>
+
+#include <tbb/parallel_sort.h>
 
 #include <chrono>
 #include <limits>
@@ -65,6 +69,7 @@ struct CmpEdgeByOSMTargetID
     value_type min_value() { return value_type::min_osm_value(); }
 };
 
+template <typename Mutex, typename NameCharData, typename NameOffsets>
 struct CmpEdgeByInternalSourceTargetAndName
 {
     using value_type = oe::InternalExtractorEdge;
@@ -91,9 +96,9 @@ struct CmpEdgeByInternalSourceTargetAndName
         if (rhs.result.name_id == EMPTY_NAMEID)
             return true;
 
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<Mutex> lock(mutex);
         BOOST_ASSERT(!name_offsets.empty() && name_offsets.back() == name_data.size());
-        const oe::ExtractionContainers::STXXLNameCharData::const_iterator data = name_data.begin();
+        const typename NameCharData::const_iterator data = name_data.begin();
         return std::lexicographical_compare(data + name_offsets[lhs.result.name_id],
                                             data + name_offsets[lhs.result.name_id + 1],
                                             data + name_offsets[rhs.result.name_id],
@@ -103,9 +108,98 @@ struct CmpEdgeByInternalSourceTargetAndName
     value_type max_value() { return value_type::max_internal_value(); }
     value_type min_value() { return value_type::min_internal_value(); }
 
-    std::mutex &mutex;
-    const oe::ExtractionContainers::STXXLNameCharData &name_data;
-    const oe::ExtractionContainers::STXXLNameOffsets &name_offsets;
+    Mutex &mutex;
+    const NameCharData &name_data;
+    const NameOffsets &name_offsets;
+};
+
+template <typename Mutex, typename NameCharData, typename NameOffsets>
+auto makeCmpEdgeByInternalSourceTargetAndName(Mutex &mutex,
+                                              const NameCharData &name_data,
+                                              const NameOffsets &name_offsets)
+{
+    return CmpEdgeByInternalSourceTargetAndName<Mutex, NameCharData, NameOffsets>{
+        mutex, name_data, name_offsets};
+}
+
+// Concurrent reads from std::vector need no lock
+struct NoMutex
+{
+    void lock() {}
+    void unlock() {}
+};
+
+#ifndef _MSC_VER
+constexpr static unsigned stxxl_memory =
+    ((sizeof(std::size_t) == 4) ? std::numeric_limits<int>::max()
+                                : std::numeric_limits<unsigned>::max());
+#else
+const static unsigned stxxl_memory = ((sizeof(std::size_t) == 4) ? INT_MAX : UINT_MAX);
+#endif
+
+// number of segments passed to the segment function at once
+const constexpr std::size_t SEGMENT_BATCH_SIZE = 64 * 1024;
+
+std::uint64_t getBytesWrittenToDisk()
+{
+#if STXXL_VERSION_MAJOR > 1 || (STXXL_VERSION_MAJOR == 1 && STXXL_VERSION_MINOR >= 4)
+    return stxxl::stats::get_instance()->get_written_volume();
+#else
+    return 0;
+#endif
+}
+
+// Containers that fit into RAM, sorted in parallel
+struct InMemoryStorage
+{
+    using Mutex = NoMutex;
+
+    template <typename T> static auto &Get(oe::ExtractionVector<T> &vector)
+    {
+        return vector.Internal();
+    }
+
+    template <typename T> static const auto &Get(const oe::ExtractionVector<T> &vector)
+    {
+        return vector.Internal();
+    }
+
+    template <typename Iterator, typename Compare>
+    static void Sort(osrm::util::UnbufferedLog &log, Iterator begin, Iterator end, Compare compare)
+    {
+        TIMER_START(sorting);
+        tbb::parallel_sort(begin, end, compare);
+        TIMER_STOP(sorting);
+        log << "ok, after " << TIMER_SEC(sorting) << "s in memory";
+    }
+};
+
+// Containers in stxxl's external memory, sorted out of core
+struct ExternalStorage
+{
+    // reading from stxxl vectors swaps blocks and is not thread-safe
+    using Mutex = std::mutex;
+
+    template <typename T> static auto &Get(oe::ExtractionVector<T> &vector)
+    {
+        return vector.External();
+    }
+
+    template <typename T> static const auto &Get(const oe::ExtractionVector<T> &vector)
+    {
+        return vector.External();
+    }
+
+    template <typename Iterator, typename Compare>
+    static void Sort(osrm::util::UnbufferedLog &log, Iterator begin, Iterator end, Compare compare)
+    {
+        const auto bytes_written_before = getBytesWrittenToDisk();
+        TIMER_START(sorting);
+        stxxl::sort(begin, end, compare, stxxl_memory);
+        TIMER_STOP(sorting);
+        log << "ok, after " << TIMER_SEC(sorting) << "s, "
+            << getBytesWrittenToDisk() - bytes_written_before << " bytes spilled to disk";
+    }
 };
 }
 
@@ -114,10 +208,13 @@ namespace osrm
 namespace extractor
 {
 
-ExtractionContainers::ExtractionContainers()
+ExtractionContainers::ExtractionContainers(const std::uint64_t memory_budget)
+    : memory_budget(memory_budget)
 {
-    // Check if stxxl can be instantiated
-    stxxl::vector<unsigned> dummy_vector;
+    if (memory_budget == 0)
+    {
+        MoveToExternalMemory();
+    }
 
     // Insert four empty strings offsets for name, ref, destination and pronunciation
     name_offsets.push_back(0);
@@ -128,6 +225,48 @@ ExtractionContainers::ExtractionContainers()
     name_offsets.push_back(0);
 }
 
+std::uint64_t ExtractionContainers::EstimateMemoryUsage() const
+{
+    // the collected data plus what is allocated on top of it while preparing it for writing:
+    // the map of used node ids and the copy of the edges that are written
+    const std::uint64_t node_id_map_entry_size =
+        sizeof(std::pair<const OSMNodeID, NodeID>) + 2 * sizeof(void *);
+    return used_node_id_list.GetSizeInBytes() + all_nodes_list.GetSizeInBytes() +
+           all_edges_list.GetSizeInBytes() + name_char_data.GetSizeInBytes() +
+           name_offsets.GetSizeInBytes() + restrictions_list.GetSizeInBytes() +
+           way_start_end_id_list.GetSizeInBytes() +
+           used_node_id_list.size() * node_id_map_entry_size +
+           all_edges_list.size() * sizeof(NodeBasedEdge);
+}
+
+void ExtractionContainers::MoveToExternalMemory()
+{
+    used_node_id_list.MoveToExternalMemory();
+    all_nodes_list.MoveToExternalMemory();
+    all_edges_list.MoveToExternalMemory();
+    name_char_data.MoveToExternalMemory();
+    name_offsets.MoveToExternalMemory();
+    restrictions_list.MoveToExternalMemory();
+    way_start_end_id_list.MoveToExternalMemory();
+}
+
+void ExtractionContainers::CheckMemoryBudget()
+{
+    if (!IsInMemory())
+    {
+        return;
+    }
+
+    const auto estimated_memory_usage = EstimateMemoryUsage();
+    if (estimated_memory_usage > memory_budget)
+    {
+        util::Log() << "Extracted data needs an estimated " << estimated_memory_usage
+                    << " bytes, more than the memory budget of " << memory_budget
+                    << " bytes. Moving it to external memory.";
+        MoveToExternalMemory();
+    }
+}
+
 void ExtractionContainers::FlushVectors()
 {
     used_node_id_list.flush();
@@ -153,54 +292,76 @@ void ExtractionContainers::PrepareData(ScriptingEnvironment &scripting_environme
                                        const std::string &output_file_name,
                                        const std::string &restrictions_file_name,
                                        const std::string &name_file_name)
+{
+    FlushVectors();
+
+    if (IsInMemory())
+    {
+        util::Log() << "Preparing " << EstimateMemoryUsage() << " bytes of data in memory";
+        PrepareAndWriteData<InMemoryStorage>(
+            scripting_environment, output_file_name, restrictions_file_name, name_file_name);
+    }
+    else
+    {
+        PrepareAndWriteData<ExternalStorage>(
+            scripting_environment, output_file_name, restrictions_file_name, name_file_name);
+    }
+}
+
+template <typename Storage>
+void ExtractionContainers::PrepareAndWriteData(ScriptingEnvironment &scripting_environment,
+                                               const std::string &output_file_name,
+                                               const std::string &restrictions_file_name,
+                                               const std::string &name_file_name)
 {
     storage::io::FileWriter file_out(output_file_name,
                                      storage::io::FileWriter::GenerateFingerprint);
 
-    FlushVectors();
-
-    PrepareNodes();
-    WriteNodes(file_out);
-    PrepareEdges(scripting_environment);
-    WriteEdges(file_out);
+    PrepareNodes<Storage>();
+    WriteNodes<Storage>(file_out);
+    PrepareEdges<Storage>(scripting_environment);
+    WriteEdges<Storage>(file_out);
 
-    PrepareRestrictions();
-    WriteRestrictions(restrictions_file_name);
-    WriteCharData(name_file_name);
+    PrepareRestrictions<Storage>();
+    WriteRestrictions<Storage>(restrictions_file_name);
+    WriteCharData<Storage>(name_file_name);
 }
 
+template <typename Storage>
 void ExtractionContainers::WriteCharData(const std::string &file_name)
 {
+    const auto &offsets = Storage::Get(name_offsets);
+    const auto &char_data = Storage::Get(name_char_data);
+
     util::UnbufferedLog log;
     log << "writing street name index ... ";
     TIMER_START(write_index);
     boost::filesystem::ofstream file(file_name, std::ios::binary);
 
     const util::NameTable::IndexedData indexed_data;
-    indexed_data.write(file, name_offsets.begin(), name_offsets.end(), name_char_data.begin());
+    indexed_data.write(file, offsets.begin(), offsets.end(), char_data.begin());
 
     TIMER_STOP(write_index);
     log << "ok, after " << TIMER_SEC(write_index) << "s";
 }
 
-void ExtractionContainers::PrepareNodes()
+template <typename Storage> void ExtractionContainers::PrepareNodes()
 {
+    auto &used_node_ids = Storage::Get(used_node_id_list);
+    auto &all_nodes = Storage::Get(all_nodes_list);
+
     {
         util::UnbufferedLog log;
         log << "Sorting used nodes        ... " << std::flush;
-        TIMER_START(sorting_used_nodes);
-        stxxl::sort(
-            used_node_id_list.begin(), used_node_id_list.end(), OSMNodeIDSTXXLLess(), stxxl_memory);
-        TIMER_STOP(sorting_used_nodes);
-        log << "ok, after " << TIMER_SEC(sorting_used_nodes) << "s";
+        Storage::Sort(log, used_node_ids.begin(), used_node_ids.end(), OSMNodeIDSTXXLLess());
     }
 
     {
         util::UnbufferedLog log;
         log << "Erasing duplicate nodes   ... " << std::flush;
         TIMER_START(erasing_dups);
-        auto new_end = std::unique(used_node_id_list.begin(), used_node_id_list.end());
-        used_node_id_list.resize(new_end - used_node_id_list.begin());
+        auto new_end = std::unique(used_node_ids.begin(), used_node_ids.end());
+        used_node_ids.resize(new_end - used_node_ids.begin());
         TIMER_STOP(erasing_dups);
         log << "ok, after " << TIMER_SEC(erasing_dups) << "s";
     }
@@ -208,24 +369,19 @@ void ExtractionContainers::PrepareNodes()
     {
         util::UnbufferedLog log;
         log << "Sorting all nodes         ... " << std::flush;
-        TIMER_START(sorting_nodes);
-        stxxl::sort(all_nodes_list.begin(),
-                    all_nodes_list.end(),
-                    ExternalMemoryNodeSTXXLCompare(),
-                    stxxl_memory);
-        TIMER_STOP(sorting_nodes);
-        log << "ok, after " << TIMER_SEC(sorting_nodes) << "s";
+        Storage::Sort(
+            log, all_nodes.begin(), all_nodes.end(), ExternalMemoryNodeSTXXLCompare());
     }
 
     {
         util::UnbufferedLog log;
         log << "Building node id map      ... " << std::flush;
         TIMER_START(id_map);
-        external_to_internal_node_id_map.reserve(used_node_id_list.size());
-        auto node_iter = all_nodes_list.begin();
-        auto ref_iter = used_node_id_list.begin();
-        const auto all_nodes_list_end = all_nodes_list.end();
-        const auto used_node_id_list_end = used_node_id_list.end();
+        external_to_internal_node_id_map.reserve(used_node_ids.size());
+        auto node_iter = all_nodes.begin();
+        auto ref_iter = used_node_ids.begin();
+        const auto all_nodes_end = all_nodes.end();
+        const auto used_node_ids_end = used_node_ids.end();
         // Note: despite being able to handle 64 bit OSM node ids, we can't
         // handle > uint32_t actual usable nodes.  This should be OK for a while
         // because we usually route on a *lot* less than 2^32 of the OSM
@@ -233,7 +389,7 @@ void ExtractionContainers::PrepareNodes()
         std::uint64_t internal_id = 0;
 
         // compute the intersection of nodes that were referenced and nodes we actually have
-        while (node_iter != all_nodes_list_end && ref_iter != used_node_id_list_end)
+        while (node_iter != all_nodes_end && ref_iter != used_node_ids_end)
         {
             if (node_iter->node_id < *ref_iter)
             {
@@ -262,17 +418,17 @@ void ExtractionContainers::PrepareNodes()
     }
 }
 
+template <typename Storage>
 void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environment)
 {
+    auto &all_nodes = Storage::Get(all_nodes_list);
+    auto &all_edges = Storage::Get(all_edges_list);
+
     // Sort edges by start.
     {
         util::UnbufferedLog log;
         log << "Sorting edges by start    ... " << std::flush;
-        TIMER_START(sort_edges_by_start);
-        stxxl::sort(
-            all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMStartID(), stxxl_memory);
-        TIMER_STOP(sort_edges_by_start);
-        log << "ok, after " << TIMER_SEC(sort_edges_by_start) << "s";
+        Storage::Sort(log, all_edges.begin(), all_edges.end(), CmpEdgeByOSMStartID());
     }
 
     {
@@ -280,13 +436,13 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         log << "Setting start coords      ... " << std::flush;
         TIMER_START(set_start_coords);
         // Traverse list of edges and nodes in parallel and set start coord
-        auto node_iterator = all_nodes_list.begin();
-        auto edge_iterator = all_edges_list.begin();
+        auto node_iterator = all_nodes.begin();
+        auto edge_iterator = all_edges.begin();
 
-        const auto all_edges_list_end = all_edges_list.end();
-        const auto all_nodes_list_end = all_nodes_list.end();
+        const auto all_edges_end = all_edges.end();
+        const auto all_nodes_end = all_nodes.end();
 
-        while (edge_iterator != all_edges_list_end && node_iterator != all_nodes_list_end)
+        while (edge_iterator != all_edges_end && node_iterator != all_nodes_end)
         {
             if (edge_iterator->result.osm_source_id < node_iterator->node_id)
             {
@@ -330,7 +486,7 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
             edge.result.source = SPECIAL_NODEID;
             edge.result.osm_source_id = SPECIAL_OSM_NODEID;
         };
-        std::for_each(edge_iterator, all_edges_list_end, markSourcesInvalid);
+        std::for_each(edge_iterator, all_edges_end, markSourcesInvalid);
         TIMER_STOP(set_start_coords);
         log << "ok, after " << TIMER_SEC(set_start_coords) << "s";
     }
@@ -339,11 +495,7 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         // Sort Edges by target
         util::UnbufferedLog log;
         log << "Sorting edges by target   ... " << std::flush;
-        TIMER_START(sort_edges_by_target);
-        stxxl::sort(
-            all_edges_list.begin(), all_edges_list.end(), CmpEdgeByOSMTargetID(), stxxl_memory);
-        TIMER_STOP(sort_edges_by_target);
-        log << "ok, after " << TIMER_SEC(sort_edges_by_target) << "s";
+        Storage::Sort(log, all_edges.begin(), all_edges.end(), CmpEdgeByOSMTargetID());
     }
 
     {
@@ -351,15 +503,52 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         util::UnbufferedLog log;
         log << "Computing edge weights    ... " << std::flush;
         TIMER_START(compute_weights);
-        auto node_iterator = all_nodes_list.begin();
-        auto edge_iterator = all_edges_list.begin();
-        const auto all_edges_list_end_ = all_edges_list.end();
-        const auto all_nodes_list_end_ = all_nodes_list.end();
+        auto node_iterator = all_nodes.begin();
+        auto edge_iterator = all_edges.begin();
+        const auto all_edges_end_ = all_edges.end();
+        const auto all_nodes_end_ = all_nodes.end();
 
         const auto weight_multiplier =
             scripting_environment.GetProfileProperties().GetWeightMultiplier();
 
-        while (edge_iterator != all_edges_list_end_ && node_iterator != all_nodes_list_end_)
+        // The segment function runs on batches of segments, the edges are finished once their
+        // batch has been processed
+        std::vector<ExtractionSegment> segments;
+        std::vector<std::pair<std::size_t, NodeID>> segment_edges;
+        segments.reserve(SEGMENT_BATCH_SIZE);
+        segment_edges.reserve(SEGMENT_BATCH_SIZE);
+        const auto process_segments = [&] {
+            scripting_environment.ProcessSegments(segments);
+
+            for (const auto index : util::irange<std::size_t>(0, segments.size()))
+            {
+                const auto &segment = segments[index];
+                auto &edge = all_edges[segment_edges[index].first].result;
+                edge.weight =
+                    std::max<EdgeWeight>(1, std::round(segment.weight * weight_multiplier));
+                edge.duration = std::max<EdgeWeight>(1, std::round(segment.duration * 10.));
+
+                // assign new node id
+                edge.target = segment_edges[index].second;
+
+                // orient edges consistently: source id < target id
+                // important for multi-edge removal
+                if (edge.source > edge.target)
+                {
+                    std::swap(edge.source, edge.target);
+
+                    // std::swap does not work with bit-fields
+                    bool temp = edge.forward;
+                    edge.forward = edge.backward;
+                    edge.backward = temp;
+                }
+            }
+
+            segments.clear();
+            segment_edges.clear();
+        };
+
+        while (edge_iterator != all_edges_end_ && node_iterator != all_nodes_end_)
         {
             // skip all invalid edges
             if (edge_iterator->result.source == SPECIAL_NODEID)
@@ -400,31 +589,17 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
             const auto weight = edge_iterator->weight_data(distance);
             const auto duration = edge_iterator->duration_data(distance);
 
-            ExtractionSegment segment(source_coord, target_coord, distance, weight, duration);
-            scripting_environment.ProcessSegment(segment);
-
-            auto &edge = edge_iterator->result;
-            edge.weight = std::max<EdgeWeight>(1, std::round(segment.weight * weight_multiplier));
-            edge.duration = std::max<EdgeWeight>(1, std::round(segment.duration * 10.));
-
-            // assign new node id
             auto id_iter = external_to_internal_node_id_map.find(node_iterator->node_id);
             BOOST_ASSERT(id_iter != external_to_internal_node_id_map.end());
-            edge.target = id_iter->second;
 
-            // orient edges consistently: source id < target id
-            // important for multi-edge removal
-            if (edge.source > edge.target)
-            {
-                std::swap(edge.source, edge.target);
+            segments.emplace_back(source_coord, target_coord, distance, weight, duration);
+            segment_edges.emplace_back(edge_iterator - all_edges.begin(), id_iter->second);
+            if (segments.size() == SEGMENT_BATCH_SIZE)
+                process_segments();
 
-                // std::swap does not work with bit-fields
-                bool temp = edge.forward;
-                edge.forward = edge.backward;
-                edge.backward = temp;
-            }
             ++edge_iterator;
         }
+        process_segments();
 
         // Remove all remaining edges. They are invalid because there are no corresponding nodes for
         // them. This happens when using osmosis with bbox or polygon to extract smaller areas.
@@ -432,7 +607,7 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
             util::Log(logDEBUG) << "Found invalid node reference " << edge.result.target;
             edge.result.target = SPECIAL_NODEID;
         };
-        std::for_each(edge_iterator, all_edges_list_end_, markTargetsInvalid);
+        std::for_each(edge_iterator, all_edges_end_, markTargetsInvalid);
         TIMER_STOP(compute_weights);
         log << "ok, after " << TIMER_SEC(compute_weights) << "s";
     }
@@ -441,35 +616,33 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
     {
         util::UnbufferedLog log;
         log << "Sorting edges by renumbered start ... ";
-        TIMER_START(sort_edges_by_renumbered_start);
-        std::mutex name_data_mutex;
-        stxxl::sort(
-            all_edges_list.begin(),
-            all_edges_list.end(),
-            CmpEdgeByInternalSourceTargetAndName{name_data_mutex, name_char_data, name_offsets},
-            stxxl_memory);
-        TIMER_STOP(sort_edges_by_renumbered_start);
-        log << "ok, after " << TIMER_SEC(sort_edges_by_renumbered_start) << "s";
+        typename Storage::Mutex name_data_mutex;
+        Storage::Sort(log,
+                      all_edges.begin(),
+                      all_edges.end(),
+                      makeCmpEdgeByInternalSourceTargetAndName(name_data_mutex,
+                                                               Storage::Get(name_char_data),
+                                                               Storage::Get(name_offsets)));
     }
 
-    BOOST_ASSERT(all_edges_list.size() > 0);
-    for (std::size_t i = 0; i < all_edges_list.size();)
+    BOOST_ASSERT(all_edges.size() > 0);
+    for (std::size_t i = 0; i < all_edges.size();)
     {
         // only invalid edges left
-        if (all_edges_list[i].result.source == SPECIAL_NODEID)
+        if (all_edges[i].result.source == SPECIAL_NODEID)
         {
             break;
         }
         // skip invalid edges
-        if (all_edges_list[i].result.target == SPECIAL_NODEID)
+        if (all_edges[i].result.target == SPECIAL_NODEID)
         {
             ++i;
             continue;
         }
 
         std::size_t start_idx = i;
-        NodeID source = all_edges_list[i].result.source;
-        NodeID target = all_edges_list[i].result.target;
+        NodeID source = all_edges[i].result.source;
+        NodeID target = all_edges[i].result.target;
 
         auto min_forward = std::make_pair(std::numeric_limits<EdgeWeight>::max(),
                                           std::numeric_limits<EdgeWeight>::max());
@@ -479,10 +652,10 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
         std::size_t min_backward_idx = std::numeric_limits<std::size_t>::max();
 
         // find minimal edge in both directions
-        while (i < all_edges_list.size() && all_edges_list[i].result.source == source &&
-               all_edges_list[i].result.target == target)
+        while (i < all_edges.size() && all_edges[i].result.source == source &&
+               all_edges[i].result.target == target)
         {
-            const auto &result = all_edges_list[i].result;
+            const auto &result = all_edges[i].result;
             const auto value = std::make_pair(result.weight, result.duration);
             if (result.forward && value < min_forward)
             {
@@ -508,9 +681,9 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
 
         if (min_backward_idx == min_forward_idx)
         {
-            all_edges_list[min_forward_idx].result.is_split = false;
-            all_edges_list[min_forward_idx].result.forward = true;
-            all_edges_list[min_forward_idx].result.backward = true;
+            all_edges[min_forward_idx].result.is_split = false;
+            all_edges[min_forward_idx].result.forward = true;
+            all_edges[min_forward_idx].result.backward = true;
         }
         else
         {
@@ -518,17 +691,17 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
             bool has_backward = min_backward_idx != std::numeric_limits<std::size_t>::max();
             if (has_forward)
             {
-                all_edges_list[min_forward_idx].result.forward = true;
-                all_edges_list[min_forward_idx].result.backward = false;
-                all_edges_list[min_forward_idx].result.is_split = has_backward;
+                all_edges[min_forward_idx].result.forward = true;
+                all_edges[min_forward_idx].result.backward = false;
+                all_edges[min_forward_idx].result.is_split = has_backward;
             }
             if (has_backward)
             {
-                std::swap(all_edges_list[min_backward_idx].result.source,
-                          all_edges_list[min_backward_idx].result.target);
-                all_edges_list[min_backward_idx].result.forward = true;
-                all_edges_list[min_backward_idx].result.backward = false;
-                all_edges_list[min_backward_idx].result.is_split = has_forward;
+                std::swap(all_edges[min_backward_idx].result.source,
+                          all_edges[min_backward_idx].result.target);
+                all_edges[min_backward_idx].result.forward = true;
+                all_edges[min_backward_idx].result.backward = false;
+                all_edges[min_backward_idx].result.is_split = has_forward;
             }
         }
 
@@ -539,23 +712,26 @@ void ExtractionContainers::PrepareEdges(ScriptingEnvironment &scripting_environm
             {
                 continue;
             }
-            all_edges_list[j].result.source = SPECIAL_NODEID;
-            all_edges_list[j].result.target = SPECIAL_NODEID;
+            all_edges[j].result.source = SPECIAL_NODEID;
+            all_edges[j].result.target = SPECIAL_NODEID;
         }
     }
 }
 
+template <typename Storage>
 void ExtractionContainers::WriteEdges(storage::io::FileWriter &file_out) const
 {
+    const auto &all_edges = Storage::Get(all_edges_list);
+
     std::vector<NodeBasedEdge> normal_edges;
-    normal_edges.reserve(all_edges_list.size());
+    normal_edges.reserve(all_edges.size());
     {
         util::UnbufferedLog log;
         log << "Writing used edges       ... " << std::flush;
         TIMER_START(write_edges);
         // Traverse list of edges and nodes in parallel and set target coord
 
-        for (const auto &edge : all_edges_list)
+        for (const auto &edge : all_edges)
         {
             if (edge.result.source == SPECIAL_NODEID || edge.result.target == SPECIAL_NODEID)
             {
@@ -581,8 +757,12 @@ void ExtractionContainers::WriteEdges(storage::io::FileWriter &file_out) const
     }
 }
 
+template <typename Storage>
 void ExtractionContainers::WriteNodes(storage::io::FileWriter &file_out) const
 {
+    const auto &used_node_ids = Storage::Get(used_node_id_list);
+    const auto &all_nodes = Storage::Get(all_nodes_list);
+
     {
         // write dummy value, will be overwritten later
         util::UnbufferedLog log;
@@ -596,12 +776,12 @@ void ExtractionContainers::WriteNodes(storage::io::FileWriter &file_out) const
         log << "Confirming/Writing used nodes     ... ";
         TIMER_START(write_nodes);
         // identify all used nodes by a merging step of two sorted lists
-        auto node_iterator = all_nodes_list.begin();
-        auto node_id_iterator = used_node_id_list.begin();
-        const auto used_node_id_list_end = used_node_id_list.end();
-        const auto all_nodes_list_end = all_nodes_list.end();
+        auto node_iterator = all_nodes.begin();
+        auto node_id_iterator = used_node_ids.begin();
+        const auto used_node_ids_end = used_node_ids.end();
+        const auto all_nodes_end = all_nodes.end();
 
-        while (node_id_iterator != used_node_id_list_end && node_iterator != all_nodes_list_end)
+        while (node_id_iterator != used_node_ids_end && node_iterator != all_nodes_end)
         {
             if (*node_id_iterator < node_iterator->node_id)
             {
@@ -627,8 +807,11 @@ void ExtractionContainers::WriteNodes(storage::io::FileWriter &file_out) const
     util::Log() << "Processed " << max_internal_node_id << " nodes";
 }
 
+template <typename Storage>
 void ExtractionContainers::WriteRestrictions(const std::string &path) const
 {
+    const auto &restrictions = Storage::Get(restrictions_list);
+
     // serialize restrictions
     unsigned written_restriction_count = 0;
     storage::io::FileWriter restrictions_out_file(path,
@@ -636,7 +819,7 @@ void ExtractionContainers::WriteRestrictions(const std::string &path) const
 
     restrictions_out_file.WriteElementCount32(written_restriction_count);
 
-    for (const auto &restriction_container : restrictions_list)
+    for (const auto &restriction_container : restrictions)
     {
         if (SPECIAL_NODEID != restriction_container.restriction.from.node &&
             SPECIAL_NODEID != restriction_container.restriction.via.node &&
@@ -651,43 +834,38 @@ void ExtractionContainers::WriteRestrictions(const std::string &path) const
     util::Log() << "usable restrictions: " << written_restriction_count;
 }
 
-void ExtractionContainers::PrepareRestrictions()
+template <typename Storage> void ExtractionContainers::PrepareRestrictions()
 {
+    auto &restrictions = Storage::Get(restrictions_list);
+    auto &way_start_end_ids = Storage::Get(way_start_end_id_list);
+
     {
         util::UnbufferedLog log;
         log << "Sorting used ways         ... ";
-        TIMER_START(sort_ways);
-        stxxl::sort(way_start_end_id_list.begin(),
-                    way_start_end_id_list.end(),
-                    FirstAndLastSegmentOfWayStxxlCompare(),
-                    stxxl_memory);
-        TIMER_STOP(sort_ways);
-        log << "ok, after " << TIMER_SEC(sort_ways) << "s";
+        Storage::Sort(log,
+                      way_start_end_ids.begin(),
+                      way_start_end_ids.end(),
+                      FirstAndLastSegmentOfWayStxxlCompare());
     }
 
     {
         util::UnbufferedLog log;
-        log << "Sorting " << restrictions_list.size() << " restriction. by from... ";
-        TIMER_START(sort_restrictions);
-        stxxl::sort(restrictions_list.begin(),
-                    restrictions_list.end(),
-                    CmpRestrictionContainerByFrom(),
-                    stxxl_memory);
-        TIMER_STOP(sort_restrictions);
-        log << "ok, after " << TIMER_SEC(sort_restrictions) << "s";
+        log << "Sorting " << restrictions.size() << " restriction. by from... ";
+        Storage::Sort(
+            log, restrictions.begin(), restrictions.end(), CmpRestrictionContainerByFrom());
     }
 
     {
         util::UnbufferedLog log;
         log << "Fixing restriction starts ... " << std::flush;
         TIMER_START(fix_restriction_starts);
-        auto restrictions_iterator = restrictions_list.begin();
-        auto way_start_and_end_iterator = way_start_end_id_list.cbegin();
-        const auto restrictions_list_end = restrictions_list.end();
-        const auto way_start_end_id_list_end = way_start_end_id_list.cend();
+        auto restrictions_iterator = restrictions.begin();
+        auto way_start_and_end_iterator = way_start_end_ids.cbegin();
+        const auto restrictions_end = restrictions.end();
+        const auto way_start_end_ids_end = way_start_end_ids.cend();
 
-        while (way_start_and_end_iterator != way_start_end_id_list_end &&
-               restrictions_iterator != restrictions_list_end)
+        while (way_start_and_end_iterator != way_start_end_ids_end &&
+               restrictions_iterator != restrictions_end)
         {
             if (way_start_and_end_iterator->way_id <
                 OSMWayID{static_cast<std::uint32_t>(restrictions_iterator->restriction.from.way)})
@@ -765,26 +943,21 @@ void ExtractionContainers::PrepareRestrictions()
     {
         util::UnbufferedLog log;
         log << "Sorting restrictions. by to  ... " << std::flush;
-        TIMER_START(sort_restrictions_to);
-        stxxl::sort(restrictions_list.begin(),
-                    restrictions_list.end(),
-                    CmpRestrictionContainerByTo(),
-                    stxxl_memory);
-        TIMER_STOP(sort_restrictions_to);
-        log << "ok, after " << TIMER_SEC(sort_restrictions_to) << "s";
+        Storage::Sort(
+            log, restrictions.begin(), restrictions.end(), CmpRestrictionContainerByTo());
     }
 
     {
         util::UnbufferedLog log;
         log << "Fixing restriction ends   ... " << std::flush;
         TIMER_START(fix_restriction_ends);
-        auto restrictions_iterator = restrictions_list.begin();
-        auto way_start_and_end_iterator = way_start_end_id_list.cbegin();
-        const auto way_start_end_id_list_end_ = way_start_end_id_list.cend();
-        const auto restrictions_list_end_ = restrictions_list.end();
+        auto restrictions_iterator = restrictions.begin();
+        auto way_start_and_end_iterator = way_start_end_ids.cbegin();
+        const auto way_start_end_ids_end_ = way_start_end_ids.cend();
+        const auto restrictions_end_ = restrictions.end();
 
-        while (way_start_and_end_iterator != way_start_end_id_list_end_ &&
-               restrictions_iterator != restrictions_list_end_)
+        while (way_start_and_end_iterator != way_start_end_ids_end_ &&
+               restrictions_iterator != restrictions_end_)
         {
             if (way_start_and_end_iterator->way_id <
                 OSMWayID{static_cast<std::uint32_t>(restrictions_iterator->restriction.to.way)})
@@ -29,7 +29,7 @@
 // Keep debug include to make sure the debug header is in sync with types.
 #include "util/debug.hpp"
 
-#include "extractor/tarjan_scc.hpp"
+#include "extractor/parallel_scc.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
@@ -39,6 +39,7 @@
 #include <osmium/io/any_input.hpp>
 
 #include <tbb/concurrent_vector.h>
+#include <tbb/pipeline.h>
 #include <tbb/task_scheduler_init.h>
 
 #include <cstdlib>
@@ -65,6 +66,19 @@ namespace extractor
 
 namespace
 {
+// A buffer read from the input file and the profile results for its entities, passed between
+// the stages of the parsing pipeline
+struct ParsedBuffer
+{
+    explicit ParsedBuffer(osmium::memory::Buffer buffer_) : buffer(std::move(buffer_)) {}
+
+    osmium::memory::Buffer buffer;
+    std::vector<osmium::memory::Buffer::const_iterator> osm_elements;
+    tbb::concurrent_vector<std::pair<std::size_t, ExtractionNode>> resulting_nodes;
+    tbb::concurrent_vector<std::pair<std::size_t, ExtractionWay>> resulting_ways;
+    tbb::concurrent_vector<boost::optional<InputRestrictionContainer>> resulting_restrictions;
+};
+
 std::tuple<std::vector<std::uint32_t>, std::vector<guidance::TurnLaneType::Mask>>
 transformTurnLaneMapIntoArrays(const guidance::LaneDescriptionMap &turn_lane_map)
 {
@@ -145,7 +159,8 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
         util::Log() << "Parsing in progress..";
         TIMER_START(parsing);
 
-        ExtractionContainers extraction_containers;
+        ExtractionContainers extraction_containers(std::uint64_t{config.memory_budget} * 1024 *
+                                                   1024 * 1024);
         auto extractor_callbacks = std::make_unique<ExtractorCallbacks>(
             extraction_containers, scripting_environment.GetProfileProperties());
 
@@ -172,55 +187,75 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
         timestamp_file.WriteFrom(timestamp.c_str(), timestamp.length());
 
-        // initialize vectors holding parsed objects
-        tbb::concurrent_vector<std::pair<std::size_t, ExtractionNode>> resulting_nodes;
-        tbb::concurrent_vector<std::pair<std::size_t, ExtractionWay>> resulting_ways;
-        tbb::concurrent_vector<boost::optional<InputRestrictionContainer>> resulting_restrictions;
-
         // setup restriction parser
         const RestrictionParser restriction_parser(scripting_environment);
 
-        // create a vector of iterators into the buffer
-        for (std::vector<osmium::memory::Buffer::const_iterator> osm_elements;
-             const osmium::memory::Buffer buffer = reader.read();
-             osm_elements.clear())
-        {
-            for (auto iter = std::begin(buffer), end = std::end(buffer); iter != end; ++iter)
-            {
-                osm_elements.push_back(iter);
-            }
-
-            // clear resulting vectors
-            resulting_nodes.clear();
-            resulting_ways.clear();
-            resulting_restrictions.clear();
-
-            scripting_environment.ProcessElements(osm_elements,
-                                                  restriction_parser,
-                                                  resulting_nodes,
-                                                  resulting_ways,
-                                                  resulting_restrictions);
-
-            number_of_nodes += resulting_nodes.size();
-            // put parsed objects thru extractor callbacks
-            for (const auto &result : resulting_nodes)
-            {
-                extractor_callbacks->ProcessNode(
-                    static_cast<const osmium::Node &>(*(osm_elements[result.first])),
-                    result.second);
-            }
-            number_of_ways += resulting_ways.size();
-            for (const auto &result : resulting_ways)
-            {
-                extractor_callbacks->ProcessWay(
-                    static_cast<const osmium::Way &>(*(osm_elements[result.first])), result.second);
-            }
-            number_of_relations += resulting_restrictions.size();
-            for (const auto &result : resulting_restrictions)
-            {
-                extractor_callbacks->ProcessRestriction(result);
-            }
-        }
+        // Reading and decoding the next buffers, running the profile on several buffers and
+        // passing the results of the previous ones through the extractor callbacks overlap.
+        // Buffers leave the pipeline in input order, so the callbacks see the same sequence as
+        // when processing one buffer after another.
+        using ParsedBufferPtr = std::shared_ptr<ParsedBuffer>;
+        const auto max_buffers_in_flight = 2 * (number_of_threads ? number_of_threads
+                                                                  : recommended_num_threads);
+
+        const auto read_buffer = tbb::make_filter<void, ParsedBufferPtr>(
+            tbb::filter::serial_in_order, [&](tbb::flow_control &control) {
+                osmium::memory::Buffer buffer = reader.read();
+                if (!buffer)
+                {
+                    control.stop();
+                    return ParsedBufferPtr{};
+                }
+                return std::make_shared<ParsedBuffer>(std::move(buffer));
+            });
+
+        const auto process_buffer = tbb::make_filter<ParsedBufferPtr, ParsedBufferPtr>(
+            tbb::filter::parallel, [&](ParsedBufferPtr parsed) {
+                // create a vector of iterators into the buffer
+                const auto &buffer = parsed->buffer;
+                for (auto iter = std::begin(buffer), end = std::end(buffer); iter != end; ++iter)
+                {
+                    parsed->osm_elements.push_back(iter);
+                }
+
+                scripting_environment.ProcessElements(parsed->osm_elements,
+                                                      restriction_parser,
+                                                      parsed->resulting_nodes,
+                                                      parsed->resulting_ways,
+                                                      parsed->resulting_restrictions);
+                return parsed;
+            });
+
+        const auto extract_buffer = tbb::make_filter<ParsedBufferPtr, void>(
+            tbb::filter::serial_in_order, [&](ParsedBufferPtr parsed) {
+                const auto &osm_elements = parsed->osm_elements;
+
+                number_of_nodes += parsed->resulting_nodes.size();
+                // put parsed objects thru extractor callbacks
+                for (const auto &result : parsed->resulting_nodes)
+                {
+                    extractor_callbacks->ProcessNode(
+                        static_cast<const osmium::Node &>(*(osm_elements[result.first])),
+                        result.second);
+                }
+                number_of_ways += parsed->resulting_ways.size();
+                for (const auto &result : parsed->resulting_ways)
+                {
+                    extractor_callbacks->ProcessWay(
+                        static_cast<const osmium::Way &>(*(osm_elements[result.first])),
+                        result.second);
+                }
+                number_of_relations += parsed->resulting_restrictions.size();
+                for (const auto &result : parsed->resulting_restrictions)
+                {
+                    extractor_callbacks->ProcessRestriction(result);
+                }
+
+                extraction_containers.CheckMemoryBudget();
+            });
+
+        tbb::parallel_pipeline(max_buffers_in_flight,
+                               read_buffer & process_buffer & extract_buffer);
         TIMER_STOP(parsing);
         util::Log() << "Parsing finished after " << TIMER_SEC(parsing) << " seconds";
 
@@ -368,7 +403,7 @@ void Extractor::FindComponents(unsigned max_edge_id,
 
     auto uncontracted_graph = UncontractedGraph(max_edge_id + 1, edges);
 
-    TarjanSCC<UncontractedGraph> component_search(uncontracted_graph);
+    ParallelSCC<UncontractedGraph> component_search(uncontracted_graph);
     component_search.Run();
 
     for (auto &node : input_nodes)
@@ -453,11 +488,25 @@ Extractor::BuildEdgeExpandedGraph(ScriptingEnvironment &scripting_environment,
 
     CompressedEdgeContainer compressed_edge_container;
     GraphCompressor graph_compressor;
-    graph_compressor.Compress(barrier_nodes,
-                              traffic_lights,
-                              *restriction_map,
-                              *node_based_graph,
-                              compressed_edge_container);
+    TIMER_START(compression);
+    if (config.use_parallel_compression)
+    {
+        graph_compressor.CompressParallel(barrier_nodes,
+                                          traffic_lights,
+                                          *restriction_map,
+                                          *node_based_graph,
+                                          compressed_edge_container);
+    }
+    else
+    {
+        graph_compressor.Compress(barrier_nodes,
+                                  traffic_lights,
+                                  *restriction_map,
+                                  *node_based_graph,
+                                  compressed_edge_container);
+    }
+    TIMER_STOP(compression);
+    util::Log() << "Graph compression took " << TIMER_SEC(compression) << " seconds";
 
     util::NameTable name_table(config.names_file_name);
 
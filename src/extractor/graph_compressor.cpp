@@ -8,11 +8,206 @@
 
 #include "util/log.hpp"
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace osrm
 {
 namespace extractor
 {
 
+namespace
+{
+LaneDescriptionID selectLaneID(const LaneDescriptionID front, const LaneDescriptionID back)
+{
+    // A lane has tags: u - (front) - v - (back) - w
+    // During contraction, we keep only one of the tags. Usually the one closer to the
+    // intersection is preferred. If its empty, however, we keep the non-empty one
+    if (back == INVALID_LANE_DESCRIPTIONID)
+        return front;
+    return back;
+}
+
+// Path n_0, n_1, ..., n_k+1 through compressible nodes. forward_edges[i] is the edge n_i -> n_i+1
+// and reverse_edges[i] the edge n_i+1 -> n_i.
+struct ChainPath
+{
+    std::vector<NodeID> nodes;
+    std::vector<EdgeID> forward_edges;
+    std::vector<EdgeID> reverse_edges;
+};
+
+// The part nodes[first] ... nodes[last] of a path that is replaced by a single edge in each
+// direction, together with the geometry and the data of these edges
+struct CompressedChain
+{
+    ChainPath path;
+    std::size_t first;
+    std::size_t last;
+
+    EdgeWeight forward_weight;
+    EdgeWeight forward_duration;
+    LaneDescriptionID forward_lane_id;
+    CompressedEdgeContainer::OnewayEdgeBucket forward_geometry;
+
+    EdgeWeight reverse_weight;
+    EdgeWeight reverse_duration;
+    LaneDescriptionID reverse_lane_id;
+    CompressedEdgeContainer::OnewayEdgeBucket reverse_geometry;
+
+    NodeID Source() const { return path.nodes[first]; }
+    NodeID Target() const { return path.nodes[last]; }
+    EdgeID ForwardEdge() const { return path.forward_edges[first]; }
+    EdgeID ReverseEdge() const { return path.reverse_edges[last - 1]; }
+};
+
+// Mirrors the checks Compress does for node_v. None of them depend on earlier compressions:
+// CanCombineWith does not look at the lanes, the only data that changes along a chain.
+bool isCompressible(const NodeID node_v,
+                    const std::unordered_set<NodeID> &barrier_nodes,
+                    const std::unordered_set<NodeID> &traffic_lights,
+                    const RestrictionMap &restriction_map,
+                    const util::NodeBasedDynamicGraph &graph)
+{
+    if (2 != graph.GetOutDegree(node_v) || barrier_nodes.count(node_v) > 0 ||
+        traffic_lights.count(node_v) > 0 || restriction_map.IsViaNode(node_v))
+    {
+        return false;
+    }
+
+    const EdgeID reverse_e2 = graph.BeginEdges(node_v);
+    const EdgeID forward_e2 = reverse_e2 + 1;
+    const NodeID node_u = graph.GetTarget(reverse_e2);
+    const NodeID node_w = graph.GetTarget(forward_e2);
+    if (node_u == node_w || node_u == node_v || node_w == node_v)
+    {
+        return false;
+    }
+
+    const EdgeID forward_e1 = graph.FindEdge(node_u, node_v);
+    const EdgeID reverse_e1 = graph.FindEdge(node_w, node_v);
+    if (SPECIAL_EDGEID == forward_e1 || SPECIAL_EDGEID == reverse_e1)
+    {
+        return false;
+    }
+
+    const auto &fwd_edge_data1 = graph.GetEdgeData(forward_e1);
+    const auto &rev_edge_data1 = graph.GetEdgeData(reverse_e1);
+    const auto &fwd_edge_data2 = graph.GetEdgeData(forward_e2);
+    const auto &rev_edge_data2 = graph.GetEdgeData(reverse_e2);
+
+    return fwd_edge_data1.name_id == rev_edge_data1.name_id &&
+           fwd_edge_data2.name_id == rev_edge_data2.name_id &&
+           fwd_edge_data1.CanCombineWith(fwd_edge_data2) &&
+           rev_edge_data1.CanCombineWith(rev_edge_data2);
+}
+
+// Follows start_edge and all compressible nodes behind it, until it reaches a node that can not
+// be compressed or gets back to the start.
+ChainPath walkChain(const NodeID start,
+                    const EdgeID start_edge,
+                    const std::vector<std::uint8_t> &compressible,
+                    const util::NodeBasedDynamicGraph &graph)
+{
+    ChainPath path;
+    path.nodes.push_back(start);
+    path.forward_edges.push_back(start_edge);
+
+    NodeID previous = start;
+    NodeID current = graph.GetTarget(start_edge);
+    while (current != start && compressible[current])
+    {
+        const EdgeID begin = graph.BeginEdges(current);
+        const bool begin_is_back = graph.GetTarget(begin) == previous;
+        const EdgeID back_edge = begin_is_back ? begin : begin + 1;
+        const EdgeID next_edge = begin_is_back ? begin + 1 : begin;
+
+        path.nodes.push_back(current);
+        path.reverse_edges.push_back(back_edge);
+        path.forward_edges.push_back(next_edge);
+
+        previous = current;
+        current = graph.GetTarget(next_edge);
+    }
+    path.nodes.push_back(current);
+    path.reverse_edges.push_back(graph.FindEdge(current, previous));
+
+    BOOST_ASSERT(path.forward_edges.size() + 1 == path.nodes.size());
+    BOOST_ASSERT(path.reverse_edges.size() + 1 == path.nodes.size());
+    return path;
+}
+
+// Sums up the segments between first and last and collects their geometry in the same order
+// Compress builds it by repeated calls to CompressEdge.
+void buildChain(CompressedChain &chain, const util::NodeBasedDynamicGraph &graph)
+{
+    BOOST_ASSERT(chain.first + 1 < chain.last);
+    BOOST_ASSERT(chain.last < chain.path.nodes.size());
+
+    chain.forward_weight = chain.forward_duration = 0;
+    chain.forward_lane_id = INVALID_LANE_DESCRIPTIONID;
+    chain.forward_geometry.clear();
+    for (const auto index : util::irange(chain.first, chain.last))
+    {
+        const auto &data = graph.GetEdgeData(chain.path.forward_edges[index]);
+        chain.forward_weight += data.weight;
+        chain.forward_duration += data.duration;
+        chain.forward_lane_id = selectLaneID(chain.forward_lane_id, data.lane_description_id);
+        chain.forward_geometry.push_back(CompressedEdgeContainer::OnewayCompressedEdge{
+            chain.path.nodes[index + 1], data.weight, data.duration});
+    }
+
+    chain.reverse_weight = chain.reverse_duration = 0;
+    chain.reverse_lane_id = INVALID_LANE_DESCRIPTIONID;
+    chain.reverse_geometry.clear();
+    for (auto index = chain.last; index > chain.first; --index)
+    {
+        const auto &data = graph.GetEdgeData(chain.path.reverse_edges[index - 1]);
+        chain.reverse_weight += data.weight;
+        chain.reverse_duration += data.duration;
+        chain.reverse_lane_id = selectLaneID(chain.reverse_lane_id, data.lane_description_id);
+        chain.reverse_geometry.push_back(CompressedEdgeContainer::OnewayCompressedEdge{
+            chain.path.nodes[index - 1], data.weight, data.duration});
+    }
+}
+
+// Chooses the part of a path that can be replaced without creating a loop edge or an edge
+// parallel to an existing one. Returns false if nothing of it can be compressed.
+bool selectCompressedPart(CompressedChain &chain, const util::NodeBasedDynamicGraph &graph)
+{
+    const auto &nodes = chain.path.nodes;
+    // number of compressible nodes between the two ends
+    const auto inner_nodes = nodes.size() - 2;
+
+    if (nodes.front() == nodes.back())
+    {
+        // u - v_1 - ... - v_k - u: keep the first and the last node to get a triangle
+        chain.first = 1;
+        chain.last = inner_nodes;
+        return inner_nodes >= 3;
+    }
+
+    chain.first = 0;
+    if (graph.FindEdgeInEitherDirection(nodes.front(), nodes.back()) != SPECIAL_EDGEID)
+    {
+        // u - v_1 - ... - v_k - w and u - w: keep v_k
+        chain.last = inner_nodes;
+        return inner_nodes >= 2;
+    }
+
+    chain.last = inner_nodes + 1;
+    return true;
+}
+}
+
 void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
                                const std::unordered_set<NodeID> &traffic_lights,
                                RestrictionMap &restriction_map,
@@ -175,16 +370,6 @@ void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
                  * just
                  * like a barrier.
                  */
-                const auto selectLaneID = [](const LaneDescriptionID front,
-                                             const LaneDescriptionID back) {
-                    // A lane has tags: u - (front) - v - (back) - w
-                    // During contraction, we keep only one of the tags. Usually the one closer to
-                    // the
-                    // intersection is preferred. If its empty, however, we keep the non-empty one
-                    if (back == INVALID_LANE_DESCRIPTIONID)
-                        return front;
-                    return back;
-                };
                 graph.GetEdgeData(forward_e1).lane_description_id =
                     selectLaneID(graph.GetEdgeData(forward_e1).lane_description_id,
                                  fwd_edge_data2.lane_description_id);
@@ -226,6 +411,192 @@ void GraphCompressor::Compress(const std::unordered_set<NodeID> &barrier_nodes,
 
     PrintStatistics(original_number_of_nodes, original_number_of_edges, graph);
 
+    AddUncompressedEdges(original_number_of_nodes, graph, geometry_compressor);
+}
+
+void GraphCompressor::CompressParallel(const std::unordered_set<NodeID> &barrier_nodes,
+                                       const std::unordered_set<NodeID> &traffic_lights,
+                                       RestrictionMap &restriction_map,
+                                       util::NodeBasedDynamicGraph &graph,
+                                       CompressedEdgeContainer &geometry_compressor)
+{
+    const unsigned original_number_of_nodes = graph.GetNumberOfNodes();
+    const unsigned original_number_of_edges = graph.GetNumberOfEdges();
+
+    std::vector<std::uint8_t> compressible(original_number_of_nodes, false);
+    tbb::parallel_for(tbb::blocked_range<NodeID>(0, original_number_of_nodes),
+                      [&](const tbb::blocked_range<NodeID> &range) {
+                          for (auto node = range.begin(); node != range.end(); ++node)
+                          {
+                              compressible[node] = isCompressible(
+                                  node, barrier_nodes, traffic_lights, restriction_map, graph);
+                          }
+                      });
+
+    // Every chain is found from both of its ends, the one with the smaller start edge keeps it
+    std::vector<std::uint8_t> visited(original_number_of_nodes, false);
+    tbb::enumerable_thread_specific<std::vector<CompressedChain>> thread_chains;
+    tbb::parallel_for(tbb::blocked_range<NodeID>(0, original_number_of_nodes),
+                      [&](const tbb::blocked_range<NodeID> &range) {
+                          auto &chains = thread_chains.local();
+                          for (auto node = range.begin(); node != range.end(); ++node)
+                          {
+                              if (compressible[node])
+                                  continue;
+
+                              for (const auto edge : graph.GetAdjacentEdgeRange(node))
+                              {
+                                  if (!compressible[graph.GetTarget(edge)])
+                                      continue;
+
+                                  CompressedChain chain;
+                                  chain.path = walkChain(node, edge, compressible, graph);
+                                  const auto &nodes = chain.path.nodes;
+                                  if (chain.path.reverse_edges.back() < edge)
+                                      continue;
+
+                                  std::for_each(nodes.begin() + 1,
+                                                nodes.end() - 1,
+                                                [&](const NodeID inner) { visited[inner] = true; });
+
+                                  if (selectCompressedPart(chain, graph))
+                                  {
+                                      buildChain(chain, graph);
+                                      chains.push_back(std::move(chain));
+                                  }
+                              }
+                          }
+                      });
+
+    std::vector<CompressedChain> chains;
+    for (auto &local_chains : thread_chains)
+    {
+        std::move(local_chains.begin(), local_chains.end(), std::back_inserter(chains));
+    }
+
+    // What is left are cycles that only consist of compressible nodes, e.g. a roundabout
+    // without any exits. They are cut open at their smallest node.
+    for (const NodeID node : util::irange(0u, original_number_of_nodes))
+    {
+        if (!compressible[node] || visited[node])
+            continue;
+
+        CompressedChain chain;
+        chain.path = walkChain(node, graph.BeginEdges(node), compressible, graph);
+        for (const auto cycle_node : chain.path.nodes)
+            visited[cycle_node] = true;
+
+        if (selectCompressedPart(chain, graph))
+        {
+            buildChain(chain, graph);
+            chains.push_back(std::move(chain));
+        }
+    }
+
+    // The order in which the chains are applied determines the order of the geometries
+    std::sort(chains.begin(), chains.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.ForwardEdge() < rhs.ForwardEdge();
+    });
+
+    // Two chains between the same nodes would become parallel edges, all but the first
+    // keep their last node
+    std::vector<std::tuple<NodeID, NodeID, std::size_t>> chain_ends;
+    chain_ends.reserve(chains.size());
+    for (const auto index : util::irange<std::size_t>(0, chains.size()))
+    {
+        const auto source = chains[index].Source();
+        const auto target = chains[index].Target();
+        chain_ends.emplace_back(std::min(source, target), std::max(source, target), index);
+    }
+    std::sort(chain_ends.begin(), chain_ends.end());
+
+    std::vector<std::uint8_t> removed_chains(chains.size(), false);
+    for (const auto index : util::irange<std::size_t>(1, chain_ends.size()))
+    {
+        if (std::get<0>(chain_ends[index - 1]) != std::get<0>(chain_ends[index]) ||
+            std::get<1>(chain_ends[index - 1]) != std::get<1>(chain_ends[index]))
+            continue;
+
+        auto &chain = chains[std::get<2>(chain_ends[index])];
+        if (chain.last - chain.first > 2)
+        {
+            --chain.last;
+            buildChain(chain, graph);
+        }
+        else
+        {
+            removed_chains[std::get<2>(chain_ends[index])] = true;
+        }
+    }
+
+    std::size_t number_of_chains = 0;
+    for (const auto index : util::irange<std::size_t>(0, chains.size()))
+    {
+        if (removed_chains[index])
+            continue;
+        if (number_of_chains != index)
+            chains[number_of_chains] = std::move(chains[index]);
+        ++number_of_chains;
+    }
+    chains.resize(number_of_chains);
+
+    // Restrictions starting at the last segment of a chain have to be moved first, so the
+    // arriving ones below find them under the new start node
+    for (const auto &chain : chains)
+    {
+        const auto &nodes = chain.path.nodes;
+        restriction_map.FixupStartingTurnRestriction(
+            chain.Source(), nodes[chain.last - 1], chain.Target());
+        restriction_map.FixupStartingTurnRestriction(
+            chain.Target(), nodes[chain.first + 1], chain.Source());
+    }
+
+    for (auto &chain : chains)
+    {
+        auto &forward_data = graph.GetEdgeData(chain.ForwardEdge());
+        forward_data.weight = chain.forward_weight;
+        forward_data.duration = chain.forward_duration;
+        forward_data.lane_description_id = chain.forward_lane_id;
+        graph.SetTarget(chain.ForwardEdge(), chain.Target());
+
+        auto &reverse_data = graph.GetEdgeData(chain.ReverseEdge());
+        reverse_data.weight = chain.reverse_weight;
+        reverse_data.duration = chain.reverse_duration;
+        reverse_data.lane_description_id = chain.reverse_lane_id;
+        graph.SetTarget(chain.ReverseEdge(), chain.Source());
+
+        for (const auto index : util::irange(chain.first + 1, chain.last))
+        {
+            const auto node = chain.path.nodes[index];
+            while (graph.GetOutDegree(node) > 0)
+                graph.DeleteEdge(node, graph.EndEdges(node) - 1);
+        }
+
+        geometry_compressor.AddCompressedEdge(chain.ForwardEdge(),
+                                              std::move(chain.forward_geometry));
+        geometry_compressor.AddCompressedEdge(chain.ReverseEdge(),
+                                              std::move(chain.reverse_geometry));
+    }
+
+    for (const auto &chain : chains)
+    {
+        const auto &nodes = chain.path.nodes;
+        restriction_map.FixupArrivingTurnRestriction(
+            chain.Source(), nodes[chain.first + 1], chain.Target(), graph);
+        restriction_map.FixupArrivingTurnRestriction(
+            chain.Target(), nodes[chain.last - 1], chain.Source(), graph);
+    }
+
+    util::Log() << "Compressed " << chains.size() << " chains of degree 2 nodes";
+    PrintStatistics(original_number_of_nodes, original_number_of_edges, graph);
+
+    AddUncompressedEdges(original_number_of_nodes, graph, geometry_compressor);
+}
+
+void GraphCompressor::AddUncompressedEdges(const unsigned original_number_of_nodes,
+                                           const util::NodeBasedDynamicGraph &graph,
+                                           CompressedEdgeContainer &geometry_compressor) const
+{
     // Repeate the loop, but now add all edges as uncompressed values.
     // The function AddUncompressedEdge does nothing if the edge is already
     // in the CompressedEdgeContainer.
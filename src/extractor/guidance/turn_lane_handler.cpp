@@ -4,7 +4,6 @@
 #include "extractor/guidance/turn_lane_augmentation.hpp"
 #include "extractor/guidance/turn_lane_matcher.hpp"
 #include "util/bearing.hpp"
-#include "util/log.hpp"
 #include "util/typedefs.hpp"
 
 #include <cstddef>
@@ -36,22 +35,18 @@ std::size_t getNumberOfTurns(const Intersection &intersection)
 TurnLaneHandler::TurnLaneHandler(const util::NodeBasedDynamicGraph &node_based_graph,
                                  std::vector<std::uint32_t> &turn_lane_offsets,
                                  std::vector<TurnLaneType::Mask> &turn_lane_masks,
-                                 LaneDescriptionMap &lane_description_map,
+                                 const LaneDescriptionMap &lane_description_map,
+                                 LaneDescriptionMap &added_lane_descriptions,
                                  const TurnAnalysis &turn_analysis,
                                  util::guidance::LaneDataIdMap &id_map)
     : node_based_graph(node_based_graph), turn_lane_offsets(turn_lane_offsets),
       turn_lane_masks(turn_lane_masks), lane_description_map(lane_description_map),
-      turn_analysis(turn_analysis), id_map(id_map)
+      added_lane_descriptions(added_lane_descriptions), turn_analysis(turn_analysis),
+      id_map(id_map)
 {
     count_handled = count_called = 0;
 }
 
-TurnLaneHandler::~TurnLaneHandler()
-{
-    util::Log() << "Handled: " << count_handled << " of " << count_called
-                << " lanes: " << (double)(count_handled * 100) / (count_called) << " %.";
-}
-
 /*
    Turn lanes are given in the form of strings that closely correspond to the direction modifiers
    we use for our turn types. However, we still cannot simply perform a 1:1 assignment.
@@ -782,17 +777,18 @@ Intersection TurnLaneHandler::handleSliproadTurn(Intersection intersection,
     }
 
     const auto combined_id = [&]() {
-        auto itr = lane_description_map.find(combined_description);
-        if (lane_description_map.find(combined_description) == lane_description_map.end())
-        {
-            const auto new_id = boost::numeric_cast<LaneDescriptionID>(lane_description_map.size());
-            lane_description_map[combined_description] = new_id;
-            return new_id;
-        }
-        else
-        {
+        const auto itr = lane_description_map.find(combined_description);
+        if (itr != lane_description_map.end())
             return itr->second;
-        }
+
+        const auto added_itr = added_lane_descriptions.find(combined_description);
+        if (added_itr != added_lane_descriptions.end())
+            return added_itr->second;
+
+        const auto new_id = boost::numeric_cast<LaneDescriptionID>(
+            lane_description_map.size() + added_lane_descriptions.size());
+        added_lane_descriptions[combined_description] = new_id;
+        return new_id;
     }();
     return simpleMatchTuplesToTurns(std::move(intersection), lane_data, combined_id);
 }
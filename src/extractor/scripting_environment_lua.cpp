@@ -427,15 +427,15 @@ void Sol2ScriptingEnvironment::InitContext(LuaScriptingContext &context)
 
     context.state.script_file(file_name);
 
-    sol::function turn_function = context.state["turn_function"];
+    context.turn_function = context.state.get<sol::function>("turn_function");
     sol::function node_function = context.state["node_function"];
     sol::function way_function = context.state["way_function"];
-    sol::function segment_function = context.state["segment_function"];
+    context.segment_function = context.state.get<sol::function>("segment_function");
 
-    context.has_turn_penalty_function = turn_function.valid();
+    context.has_turn_penalty_function = context.turn_function.valid();
     context.has_node_function = node_function.valid();
     context.has_way_function = way_function.valid();
-    context.has_segment_function = segment_function.valid();
+    context.has_segment_function = context.segment_function.valid();
 
     // Check profile API version
     auto maybe_version = context.state.get<sol::optional<int>>("api_version");
@@ -582,25 +582,76 @@ void Sol2ScriptingEnvironment::SetupSources()
 
 void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
 {
-    auto &context = GetSol2Context();
+    GetSol2Context().ProcessTurn(turn);
+}
 
-    sol::function turn_function = context.state["turn_function"];
-    switch (context.api_version)
+void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
+{
+    GetSol2Context().ProcessSegment(segment);
+}
+
+void Sol2ScriptingEnvironment::ProcessTurns(std::vector<ExtractionTurn> &turns)
+{
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, turns.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          auto &local_context = this->GetSol2Context();
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              local_context.ProcessTurn(turns[index]);
+                          }
+                      });
+}
+
+void Sol2ScriptingEnvironment::ProcessSegments(std::vector<ExtractionSegment> &segments)
+{
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, segments.size()),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          auto &local_context = this->GetSol2Context();
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              local_context.ProcessSegment(segments[index]);
+                          }
+                      });
+}
+
+void LuaScriptingContext::ProcessNode(const osmium::Node &node, ExtractionNode &result)
+{
+    BOOST_ASSERT(state.lua_state() != nullptr);
+
+    sol::function node_function = state["node_function"];
+
+    node_function(node, result);
+}
+
+void LuaScriptingContext::ProcessWay(const osmium::Way &way, ExtractionWay &result)
+{
+    BOOST_ASSERT(state.lua_state() != nullptr);
+
+    sol::function way_function = state["way_function"];
+
+    way_function(way, result);
+}
+
+void LuaScriptingContext::ProcessTurn(ExtractionTurn &turn)
+{
+    BOOST_ASSERT(state.lua_state() != nullptr);
+
+    switch (api_version)
     {
     case 1:
-        if (context.has_turn_penalty_function)
+        if (has_turn_penalty_function)
         {
             turn_function(turn);
 
             // Turn weight falls back to the duration value in deciseconds
             // or uses the extracted unit-less weight value
-            if (context.properties.fallback_to_duration)
+            if (properties.fallback_to_duration)
                 turn.weight = turn.duration;
         }
 
         break;
     case 0:
-        if (context.has_turn_penalty_function)
+        if (has_turn_penalty_function)
         {
             if (turn.turn_type != guidance::TurnType::NoTurn)
             {
@@ -610,7 +661,7 @@ void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
 
                 // add U-turn penalty
                 if (turn.direction_modifier == guidance::DirectionModifier::UTurn)
-                    turn.duration += context.properties.GetUturnPenalty();
+                    turn.duration += properties.GetUturnPenalty();
             }
             else
             {
@@ -622,7 +673,7 @@ void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
 
         // Add traffic light penalty, back-compatibility of api_version=0
         if (turn.has_traffic_light)
-            turn.duration += context.properties.GetTrafficSignalPenalty();
+            turn.duration += properties.GetTrafficSignalPenalty();
 
         // Turn weight falls back to the duration value in deciseconds
         turn.weight = turn.duration;
@@ -630,14 +681,13 @@ void Sol2ScriptingEnvironment::ProcessTurn(ExtractionTurn &turn)
     }
 }
 
-void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
+void LuaScriptingContext::ProcessSegment(ExtractionSegment &segment)
 {
-    auto &context = GetSol2Context();
+    BOOST_ASSERT(state.lua_state() != nullptr);
 
-    if (context.has_segment_function)
+    if (has_segment_function)
     {
-        sol::function segment_function = context.state["segment_function"];
-        switch (context.api_version)
+        switch (api_version)
         {
         case 1:
             segment_function(segment);
@@ -649,23 +699,5 @@ void Sol2ScriptingEnvironment::ProcessSegment(ExtractionSegment &segment)
         }
     }
 }
-
-void LuaScriptingContext::ProcessNode(const osmium::Node &node, ExtractionNode &result)
-{
-    BOOST_ASSERT(state.lua_state() != nullptr);
-
-    sol::function node_function = state["node_function"];
-
-    node_function(node, result);
-}
-
-void LuaScriptingContext::ProcessWay(const osmium::Way &way, ExtractionWay &result)
-{
-    BOOST_ASSERT(state.lua_state() != nullptr);
-
-    sol::function way_function = state["way_function"];
-
-    way_function(way, result);
-}
 }
 }
@@ -266,11 +266,15 @@ NAN_METHOD(Engine::nearest) //
  * location with given index as source. Default is to use all.
  * @param {Array} [options.destinations] An array of `index` elements (`0 <= integer <
  * #coordinates`) to use location with given index as destination. Default is to use all.
+ * @param {Array} [options.annotations] An array of the tables to return, containing `duration` and/or `distance`.
+ * Default is `['duration']`.
  * @param {Function} callback
  *
- * @returns {Object} containing `durations`, `sources`, and `destinations`.
+ * @returns {Object} containing `durations`, `distances`, `sources`, and `destinations`.
  * **`durations`**: array of arrays that stores the matrix in row-major order. `durations[i][j]` gives the travel time from the i-th waypoint to the j-th waypoint.
  *                  Values are given in seconds.
+ * **`distances`**: array of arrays that stores the matrix in row-major order. `distances[i][j]` gives the distance of the fastest route from the i-th waypoint to the j-th waypoint.
+ *                  Values are given in meters. Only present if requested with `annotations`.
  * **`sources`**: array of [`Ẁaypoint`](#waypoint) objects describing all sources in order.
  * **`destinations`**: array of [`Ẁaypoint`](#waypoint) objects describing all destinations in order.
  *
@@ -1,5 +1,6 @@
 #include "osrm/osrm.hpp"
 #include "engine/algorithm.hpp"
+#include "engine/api/batch_route_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -8,6 +9,7 @@
 #include "engine/engine.hpp"
 #include "engine/engine_config.hpp"
 #include "engine/status.hpp"
+#include "util/json_writer.hpp"
 
 #include <memory>
 
@@ -67,30 +69,96 @@ engine::Status OSRM::Route(const engine::api::RouteParameters &params,
     return engine_->Route(params, result);
 }
 
+engine::Status OSRM::RouteProtobuf(const engine::api::RouteParameters &params,
+                                   std::string &result) const
+{
+    return engine_->Route(params, result);
+}
+
+engine::Status OSRM::RouteJSON(const engine::api::RouteParameters &params,
+                               std::vector<char> &result) const
+{
+    util::json::Writer writer(result);
+    return engine_->Route(params, writer);
+}
+
 engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Object &result) const
 {
     return engine_->Table(params, result);
 }
 
+engine::Status OSRM::TableProtobuf(const engine::api::TableParameters &params,
+                                   std::string &result) const
+{
+    return engine_->Table(params, result);
+}
+
+engine::Status OSRM::TableJSON(const engine::api::TableParameters &params,
+                               std::vector<char> &result) const
+{
+    util::json::Writer writer(result);
+    return engine_->Table(params, writer);
+}
+
 engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
                              json::Object &result) const
 {
     return engine_->Nearest(params, result);
 }
 
+engine::Status OSRM::NearestProtobuf(const engine::api::NearestParameters &params,
+                             std::string &result) const
+{
+    return engine_->Nearest(params, result);
+}
+
 engine::Status OSRM::Trip(const engine::api::TripParameters &params, json::Object &result) const
 {
     return engine_->Trip(params, result);
 }
 
+engine::Status OSRM::TripProtobuf(const engine::api::TripParameters &params,
+                                  std::string &result) const
+{
+    return engine_->Trip(params, result);
+}
+
 engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Object &result) const
 {
     return engine_->Match(params, result);
 }
 
+engine::Status OSRM::MatchProtobuf(const engine::api::MatchParameters &params,
+                                   std::string &result) const
+{
+    return engine_->Match(params, result);
+}
+
+engine::Status OSRM::MatchJSON(const engine::api::MatchParameters &params,
+                               std::vector<char> &result) const
+{
+    util::json::Writer writer(result);
+    return engine_->Match(params, writer);
+}
+
 engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string &result) const
 {
     return engine_->Tile(params, result);
 }
 
+engine::Status OSRM::BatchRoute(const engine::api::BatchRouteParameters &params,
+                                json::Object &result) const
+{
+    return engine_->BatchRoute(params, result);
+}
+
+engine::Status OSRM::BatchRouteJSON(const engine::api::BatchRouteParameters &params,
+                                    std::vector<char> &result) const
+{
+    util::json::Writer writer(result);
+    return engine_->BatchRoute(params, writer);
+}
+
+bool OSRM::Reload() { return engine_->Reload(); }
+
 } // ns osrm
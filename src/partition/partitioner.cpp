@@ -185,7 +185,9 @@ int Partitioner::Run(const PartitionConfig &config)
 
     TIMER_START(writing_mld_data);
     io::write(config.mld_partition_path, mlp);
-    io::write(config.mld_storage_path, storage);
+    io::CellStorageHeader cells_header;
+    cells_header.partition_checksum = io::checksum(config.mld_partition_path);
+    io::write(config.mld_storage_path, storage, cells_header);
     TIMER_STOP(writing_mld_data);
     util::Log() << "MLD data writing took " << TIMER_SEC(writing_mld_data) << " seconds";
 
@@ -0,0 +1,80 @@
+#include "server/api/body_parser.hpp"
+#include "engine/polyline_compressor.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+namespace
+{
+const constexpr std::size_t PACKED_COORDINATE_SIZE = 2 * sizeof(std::int32_t);
+
+std::int32_t readInt32(const char *data)
+{
+    const auto bytes = reinterpret_cast<const unsigned char *>(data);
+    const std::uint32_t value = static_cast<std::uint32_t>(bytes[0]) |
+                                static_cast<std::uint32_t>(bytes[1]) << 8 |
+                                static_cast<std::uint32_t>(bytes[2]) << 16 |
+                                static_cast<std::uint32_t>(bytes[3]) << 24;
+    return static_cast<std::int32_t>(value);
+}
+
+boost::optional<std::vector<util::Coordinate>> parsePackedCoordinates(const std::string &body)
+{
+    if (body.size() % PACKED_COORDINATE_SIZE != 0)
+    {
+        return boost::none;
+    }
+
+    std::vector<util::Coordinate> coordinates;
+    coordinates.reserve(body.size() / PACKED_COORDINATE_SIZE);
+    for (auto data = body.data(); data != body.data() + body.size();
+         data += PACKED_COORDINATE_SIZE)
+    {
+        coordinates.emplace_back(util::FixedLongitude{readInt32(data)},
+                                 util::FixedLatitude{readInt32(data + sizeof(std::int32_t))});
+    }
+    return coordinates;
+}
+
+boost::optional<std::vector<util::Coordinate>> parsePolylineCoordinates(const std::string &body)
+{
+    // decodePolyline does not validate its input, only accept the polyline alphabet
+    const auto is_polyline_char = [](const char character) {
+        return character >= '?' && character <= '~';
+    };
+    if (!std::all_of(body.begin(), body.end(), is_polyline_char))
+    {
+        return boost::none;
+    }
+
+    return engine::decodePolyline(body);
+}
+}
+
+boost::optional<std::vector<util::Coordinate>> parseCoordinates(const std::string &content_type,
+                                                                const std::string &body)
+{
+    if (boost::istarts_with(content_type, "application/octet-stream"))
+    {
+        return parsePackedCoordinates(body);
+    }
+
+    if (boost::istarts_with(content_type, "application/x-polyline"))
+    {
+        return parsePolylineCoordinates(body);
+    }
+
+    return boost::none;
+}
+}
+}
+}
@@ -1,5 +1,6 @@
 #include "server/api/parameters_parser.hpp"
 
+#include "server/api/batch_route_parameters_grammar.hpp"
 #include "server/api/match_parameter_grammar.hpp"
 #include "server/api/nearest_parameter_grammar.hpp"
 #include "server/api/route_parameters_grammar.hpp"
@@ -8,6 +9,7 @@
 #include "server/api/trip_parameter_grammar.hpp"
 
 #include <type_traits>
+#include <utility>
 
 namespace osrm
 {
@@ -26,19 +28,16 @@ using is_grammar_t =
                                std::is_same<NearestParametersGrammar<>, T>::value ||
                                std::is_same<TripParametersGrammar<>, T>::value ||
                                std::is_same<MatchParametersGrammar<>, T>::value ||
-                               std::is_same<TileParametersGrammar<>, T>::value>;
+                               std::is_same<TileParametersGrammar<>, T>::value ||
+                               std::is_same<BatchRouteParametersGrammar<>, T>::value>;
 
-template <typename ParameterT,
-          typename GrammarT,
-          typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0,
-          typename std::enable_if<detail::is_grammar_t<GrammarT>::value, int>::type = 0>
-boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
-                                            const std::string::iterator end)
+template <typename ParameterT, typename GrammarT>
+boost::optional<ParameterT> parseWithGrammar(std::string::iterator &iter,
+                                             const std::string::iterator end,
+                                             const GrammarT &grammar)
 {
     using It = std::decay<decltype(iter)>::type;
 
-    static const GrammarT grammar;
-
     try
     {
         ParameterT parameters;
@@ -63,6 +62,34 @@ boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
 
     return boost::none;
 }
+
+template <typename ParameterT,
+          typename GrammarT,
+          typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0,
+          typename std::enable_if<detail::is_grammar_t<GrammarT>::value, int>::type = 0>
+boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
+                                            const std::string::iterator end)
+{
+    static const GrammarT grammar;
+    return parseWithGrammar<ParameterT>(iter, end, grammar);
+}
+
+template <typename ParameterT,
+          typename GrammarT,
+          typename std::enable_if<detail::has_coordinates_t<ParameterT>::value, int>::type = 0,
+          typename std::enable_if<detail::is_grammar_t<GrammarT>::value, int>::type = 0>
+boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
+                                            const std::string::iterator end,
+                                            std::vector<util::Coordinate> coordinates)
+{
+    static const GrammarT grammar(true);
+    auto parameters = parseWithGrammar<ParameterT>(iter, end, grammar);
+    if (parameters)
+    {
+        parameters->coordinates = std::move(coordinates);
+    }
+    return parameters;
+}
 } // ns detail
 
 template <>
@@ -111,6 +138,75 @@ boost::optional<engine::api::TileParameters> parseParameters(std::string::iterat
     return detail::parseParameters<engine::api::TileParameters, TileParametersGrammar<>>(iter, end);
 }
 
+template <>
+boost::optional<engine::api::BatchRouteParameters> parseParameters(std::string::iterator &iter,
+                                                                   const std::string::iterator end)
+{
+    return detail::parseParameters<engine::api::BatchRouteParameters,
+                                   BatchRouteParametersGrammar<>>(iter, end);
+}
+
+template <>
+boost::optional<engine::api::RouteParameters>
+parseParameters(std::string::iterator &iter,
+                const std::string::iterator end,
+                std::vector<util::Coordinate> coordinates)
+{
+    return detail::parseParameters<engine::api::RouteParameters, RouteParametersGrammar<>>(
+        iter, end, std::move(coordinates));
+}
+
+template <>
+boost::optional<engine::api::TableParameters>
+parseParameters(std::string::iterator &iter,
+                const std::string::iterator end,
+                std::vector<util::Coordinate> coordinates)
+{
+    return detail::parseParameters<engine::api::TableParameters, TableParametersGrammar<>>(
+        iter, end, std::move(coordinates));
+}
+
+template <>
+boost::optional<engine::api::NearestParameters>
+parseParameters(std::string::iterator &iter,
+                const std::string::iterator end,
+                std::vector<util::Coordinate> coordinates)
+{
+    return detail::parseParameters<engine::api::NearestParameters, NearestParametersGrammar<>>(
+        iter, end, std::move(coordinates));
+}
+
+template <>
+boost::optional<engine::api::TripParameters>
+parseParameters(std::string::iterator &iter,
+                const std::string::iterator end,
+                std::vector<util::Coordinate> coordinates)
+{
+    return detail::parseParameters<engine::api::TripParameters, TripParametersGrammar<>>(
+        iter, end, std::move(coordinates));
+}
+
+template <>
+boost::optional<engine::api::MatchParameters>
+parseParameters(std::string::iterator &iter,
+                const std::string::iterator end,
+                std::vector<util::Coordinate> coordinates)
+{
+    return detail::parseParameters<engine::api::MatchParameters, MatchParametersGrammar<>>(
+        iter, end, std::move(coordinates));
+}
+
+template <>
+boost::optional<engine::api::BatchRouteParameters>
+parseParameters(std::string::iterator &iter,
+                const std::string::iterator end,
+                std::vector<util::Coordinate> coordinates)
+{
+    return detail::parseParameters<engine::api::BatchRouteParameters,
+                                   BatchRouteParametersGrammar<>>(
+        iter, end, std::move(coordinates));
+}
+
 } // ns api
 } // ns server
 } // ns osrm
@@ -22,7 +22,7 @@ namespace qi = boost::spirit::qi;
 template <typename Iterator, typename Into> //
 struct URLParser final : qi::grammar<Iterator, Into>
 {
-    URLParser() : URLParser::base_type(start)
+    URLParser(const bool coordinates_in_body) : URLParser::base_type(start)
     {
         using boost::spirit::repository::qi::iter_pos;
 
@@ -34,9 +34,14 @@ struct URLParser final : qi::grammar<Iterator, Into>
         service = +alpha_numeral;
         version = qi::uint_;
         profile = +alpha_numeral;
-        query = +all_chars;
+        // without coordinates the query can be empty or only hold the format and options
+        if (coordinates_in_body)
+            query = *all_chars;
+        else
+            query = +all_chars;
 
         // Example input: /route/v1/driving/7.416351,43.731205;7.420363,43.736189
+        // or for POST requests with the coordinates in the body: /table/v1/driving/?sources=0
 
         start = qi::lit('/') > service > qi::lit('/') > qi::lit('v') > version > qi::lit('/') >
                 profile > qi::lit('/') >
@@ -68,16 +73,21 @@ namespace server
 namespace api
 {
 
-boost::optional<ParsedURL> parseURL(std::string::iterator &iter, const std::string::iterator end)
+boost::optional<ParsedURL> parseURL(std::string::iterator &iter,
+                                    const std::string::iterator end,
+                                    const bool coordinates_in_body)
 {
     using It = std::decay<decltype(iter)>::type;
 
-    static URLParser<It, ParsedURL(It)> const parser;
+    static URLParser<It, ParsedURL(It)> const parser(false);
+    static URLParser<It, ParsedURL(It)> const body_parser(true);
+    const auto &selected_parser = coordinates_in_body ? body_parser : parser;
     ParsedURL out;
 
     try
     {
-        const auto ok = boost::spirit::qi::parse(iter, end, parser(boost::phoenix::val(iter)), out);
+        const auto ok = boost::spirit::qi::parse(
+            iter, end, selected_parser(boost::phoenix::val(iter)), out);
 
         if (ok && iter == end)
             return boost::make_optional(out);
@@ -2,6 +2,7 @@
 #include "server/request_handler.hpp"
 #include "server/request_parser.hpp"
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/assert.hpp>
 #include <boost/bind.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
@@ -16,16 +17,41 @@ namespace osrm
 namespace server
 {
 
-Connection::Connection(boost::asio::io_service &io_service, RequestHandler &handler)
-    : strand(io_service), TCP_socket(io_service), request_handler(handler)
+namespace
+{
+// upper bound of requests answered on one persistent connection before it is closed
+const constexpr unsigned MAX_REQUESTS_PER_CONNECTION = 512;
+
+const constexpr char CONTINUE_RESPONSE[] = "HTTP/1.1 100 Continue\r\n\r\n";
+}
+
+Connection::Connection(boost::asio::io_service &io_service,
+                       RequestHandler &handler,
+                       WorkerPool &worker_pool,
+                       const unsigned keepalive_timeout)
+    : strand(io_service), TCP_socket(io_service), timer(io_service), request_handler(handler),
+      worker_pool(worker_pool), pending_begin(nullptr), pending_end(nullptr),
+      keepalive_timeout(keepalive_timeout), remaining_requests(MAX_REQUESTS_PER_CONNECTION),
+      keep_alive(false), current_compression(http::no_compression)
 {
 }
 
 boost::asio::ip::tcp::socket &Connection::socket() { return TCP_socket; }
 
 /// Start the first asynchronous operation for the connection.
-void Connection::start()
+void Connection::start() { read_more(); }
+
+void Connection::read_more()
 {
+    if (keep_alive)
+    {
+        // close idle persistent connections after the timeout
+        timer.expires_from_now(boost::posix_time::seconds(keepalive_timeout));
+        timer.async_wait(strand.wrap(boost::bind(&Connection::handle_timeout,
+                                                 this->shared_from_this(),
+                                                 boost::asio::placeholders::error)));
+    }
+
     TCP_socket.async_read_some(
         boost::asio::buffer(incoming_data_buffer),
         strand.wrap(boost::bind(&Connection::handle_read,
@@ -36,62 +62,64 @@ void Connection::start()
 
 void Connection::handle_read(const boost::system::error_code &error, std::size_t bytes_transferred)
 {
+    if (keep_alive)
+    {
+        // disarm the idle timer, a pending handler will notice the reset expiry time
+        timer.expires_at(boost::posix_time::pos_infin);
+    }
+
     if (error)
     {
         return;
     }
 
+    process_data(incoming_data_buffer.data(), incoming_data_buffer.data() + bytes_transferred);
+}
+
+void Connection::process_data(char *begin, char *end)
+{
     // no error detected, let's parse the request
-    http::compression_type compression_type(http::no_compression);
     RequestParser::RequestStatus result;
-    std::tie(result, compression_type) =
-        request_parser.parse(current_request,
-                             incoming_data_buffer.data(),
-                             incoming_data_buffer.data() + bytes_transferred);
+    char *parsed_end;
+    std::tie(result, current_compression, parsed_end) =
+        request_parser.parse(current_request, begin, end);
 
     // the request has been parsed
     if (result == RequestParser::RequestStatus::valid)
     {
-        current_request.endpoint = TCP_socket.remote_endpoint().address();
-        request_handler.HandleRequest(current_request, current_reply);
+        pending_begin = parsed_end;
+        pending_end = end;
+
+        boost::system::error_code ignore_error;
+        current_request.endpoint = TCP_socket.remote_endpoint(ignore_error).address();
 
-        // compress the result w/ gzip/deflate if requested
-        switch (compression_type)
+        // no further reads are issued until the reply is written, so the worker owns the
+        // request and reply until it hands them back to the strand
+        if (!worker_pool.Post(boost::bind(&Connection::compute_reply, this->shared_from_this())))
         {
-        case http::deflate_rfc1951:
-            // use deflate for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "deflate"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::gzip_rfc1952:
-            // use gzip for compression
-            current_reply.headers.insert(current_reply.headers.begin(),
-                                         {"Content-Encoding", "gzip"});
-            compressed_output = compress_buffers(current_reply.content, compression_type);
-            current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
-            output_buffer = current_reply.headers_to_buffers();
-            output_buffer.push_back(boost::asio::buffer(compressed_output));
-            break;
-        case http::no_compression:
-            // don't use any compression
-            current_reply.set_uncompressed_size();
-            output_buffer = current_reply.to_buffers();
-            break;
+            current_reply = http::reply::stock_reply(http::reply::service_unavailable);
+            send_reply();
         }
-        // write result to stream
-        boost::asio::async_write(TCP_socket,
-                                 output_buffer,
-                                 strand.wrap(boost::bind(&Connection::handle_write,
-                                                         this->shared_from_this(),
-                                                         boost::asio::placeholders::error)));
+    }
+    else if (result == RequestParser::RequestStatus::expect_continue)
+    {
+        // the rest of the buffer is parsed once the interim response is written, clients
+        // may send the body without waiting for it
+        pending_begin = parsed_end;
+        pending_end = end;
+
+        boost::asio::async_write(
+            TCP_socket,
+            boost::asio::buffer(CONTINUE_RESPONSE, sizeof(CONTINUE_RESPONSE) - 1),
+            strand.wrap(boost::bind(&Connection::handle_continue_write,
+                                    this->shared_from_this(),
+                                    boost::asio::placeholders::error)));
     }
     else if (result == RequestParser::RequestStatus::invalid)
     { // request is not parseable
+        keep_alive = false;
         current_reply = http::reply::stock_reply(http::reply::bad_request);
+        current_reply.headers.emplace_back("Connection", "close");
 
         boost::asio::async_write(TCP_socket,
                                  current_reply.to_buffers(),
@@ -101,27 +129,161 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     }
     else
     {
-        // we don't have a result yet, so continue reading
-        TCP_socket.async_read_some(
-            boost::asio::buffer(incoming_data_buffer),
-            strand.wrap(boost::bind(&Connection::handle_read,
-                                    this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred)));
+        // we don't have a result yet, so continue reading. all input was consumed by the
+        // parser, so the whole buffer is free to receive the rest of the request.
+        read_more();
+    }
+}
+
+void Connection::compute_reply()
+{
+    request_handler.HandleRequest(current_request, current_reply);
+    strand.dispatch(boost::bind(&Connection::send_reply, this->shared_from_this()));
+}
+
+void Connection::send_reply()
+{
+    keep_alive = wants_keep_alive();
+    if (keep_alive)
+    {
+        current_reply.headers.emplace_back("Connection", "keep-alive");
+        current_reply.headers.emplace_back("Keep-Alive",
+                                           "timeout=" + std::to_string(keepalive_timeout) +
+                                               ", max=" + std::to_string(remaining_requests));
+    }
+    else
+    {
+        current_reply.headers.emplace_back("Connection", "close");
+    }
+
+    // compress the result w/ gzip/deflate if requested
+    switch (current_compression)
+    {
+    case http::deflate_rfc1951:
+        // use deflate for compression
+        current_reply.headers.insert(current_reply.headers.begin(),
+                                     {"Content-Encoding", "deflate"});
+        compressed_output = compress_buffers(current_reply.content, current_compression);
+        current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
+        output_buffer = current_reply.headers_to_buffers();
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
+        break;
+    case http::gzip_rfc1952:
+        // use gzip for compression
+        current_reply.headers.insert(current_reply.headers.begin(),
+                                     {"Content-Encoding", "gzip"});
+        compressed_output = compress_buffers(current_reply.content, current_compression);
+        current_reply.set_size(static_cast<unsigned>(compressed_output.size()));
+        output_buffer = current_reply.headers_to_buffers();
+        output_buffer.push_back(boost::asio::buffer(compressed_output));
+        break;
+    case http::no_compression:
+        // don't use any compression
+        current_reply.set_uncompressed_size();
+        output_buffer = current_reply.to_buffers();
+        break;
+    }
+    // write result to stream
+    boost::asio::async_write(TCP_socket,
+                             output_buffer,
+                             strand.wrap(boost::bind(&Connection::handle_write,
+                                                     this->shared_from_this(),
+                                                     boost::asio::placeholders::error)));
+}
+
+bool Connection::wants_keep_alive() const
+{
+    if (keepalive_timeout == 0 || remaining_requests <= 1)
+    {
+        return false;
+    }
+
+    // HTTP/1.1 connections are persistent by default, HTTP/1.0 clients have to opt in
+    if (current_request.http_version_major > 1 ||
+        (current_request.http_version_major == 1 && current_request.http_version_minor >= 1))
+    {
+        return !boost::icontains(current_request.connection, "close");
     }
+    return boost::icontains(current_request.connection, "keep-alive");
 }
 
 /// Handle completion of a write operation.
 void Connection::handle_write(const boost::system::error_code &error)
 {
-    if (!error)
+    if (error)
     {
-        // Initiate graceful connection closure.
-        boost::system::error_code ignore_error;
-        TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+        return;
+    }
+
+    if (!keep_alive)
+    {
+        graceful_shutdown();
+        return;
+    }
+
+    // reuse parser, request and reply buffers for the next request on this connection
+    --remaining_requests;
+    request_parser.reset();
+    current_request = http::request();
+    current_reply.reset();
+    compressed_output.clear();
+    output_buffer.clear();
+
+    if (pending_begin != pending_end)
+    {
+        // answer pipelined requests that have already been received
+        const auto begin = pending_begin;
+        const auto end = pending_end;
+        pending_begin = pending_end = nullptr;
+        process_data(begin, end);
+    }
+    else
+    {
+        read_more();
+    }
+}
+
+void Connection::handle_continue_write(const boost::system::error_code &error)
+{
+    if (error)
+    {
+        return;
+    }
+
+    if (pending_begin != pending_end)
+    {
+        const auto begin = pending_begin;
+        const auto end = pending_end;
+        pending_begin = pending_end = nullptr;
+        process_data(begin, end);
+    }
+    else
+    {
+        read_more();
     }
 }
 
+void Connection::handle_timeout(const boost::system::error_code &error)
+{
+    // the timer was disarmed or re-armed because a new request arrived in time
+    if (error == boost::asio::error::operation_aborted ||
+        timer.expires_at() > boost::asio::deadline_timer::traits_type::now())
+    {
+        return;
+    }
+
+    // no request arrived during the idle period, close the persistent connection
+    boost::system::error_code ignore_error;
+    TCP_socket.cancel(ignore_error);
+    graceful_shutdown();
+}
+
+void Connection::graceful_shutdown()
+{
+    boost::system::error_code ignore_error;
+    TCP_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignore_error);
+}
+
 std::vector<char> Connection::compress_buffers(const std::vector<char> &uncompressed_data,
                                                const http::compression_type compression_type)
 {
@@ -1,6 +1,7 @@
 #include "server/request_handler.hpp"
 #include "server/service_handler.hpp"
 
+#include "server/api/body_parser.hpp"
 #include "server/api/url_parser.hpp"
 #include "server/http/reply.hpp"
 #include "server/http/request.hpp"
@@ -26,6 +27,7 @@
 #include <iterator>
 #include <string>
 #include <thread>
+#include <utility>
 
 namespace osrm
 {
@@ -58,12 +60,32 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
         util::Log(logDEBUG) << "[req][" << tid << "] " << request_string;
 
+        // POST requests send the coordinates in the body and leave them out of the URL
+        const bool coordinates_in_body = current_request.method == "POST";
+
         auto api_iterator = request_string.begin();
-        auto maybe_parsed_url = api::parseURL(api_iterator, request_string.end());
+        auto maybe_parsed_url =
+            api::parseURL(api_iterator, request_string.end(), coordinates_in_body);
         ServiceHandler::ResultT result;
 
+        if (maybe_parsed_url && coordinates_in_body)
+        {
+            maybe_parsed_url->coordinates =
+                api::parseCoordinates(current_request.content_type, current_request.body);
+        }
+
         // check if the was an error with the request
-        if (maybe_parsed_url && api_iterator == request_string.end())
+        if (maybe_parsed_url && coordinates_in_body && !maybe_parsed_url->coordinates)
+        {
+            current_reply.status = http::reply::bad_request;
+            result = util::json::Object();
+            auto &json_result = result.get<util::json::Object>();
+            json_result.values["code"] = "InvalidBody";
+            json_result.values["message"] =
+                "Request body must be packed coordinates (application/octet-stream) or a "
+                "polyline (application/x-polyline)";
+        }
+        else if (maybe_parsed_url && api_iterator == request_string.end())
         {
 
             const engine::Status status =
@@ -99,7 +121,7 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         }
 
         current_reply.headers.emplace_back("Access-Control-Allow-Origin", "*");
-        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET");
+        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET, POST");
         current_reply.headers.emplace_back("Access-Control-Allow-Headers",
                                            "X-Requested-With, Content-Type");
         if (result.is<util::json::Object>())
@@ -110,6 +132,14 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
             util::json::render(current_reply.content, result.get<util::json::Object>());
         }
+        else if (result.is<std::vector<char>>())
+        {
+            current_reply.headers.emplace_back("Content-Type", "application/json; charset=UTF-8");
+            current_reply.headers.emplace_back("Content-Disposition",
+                                               "inline; filename=\"response.json\"");
+
+            current_reply.content = std::move(result.get<std::vector<char>>());
+        }
         else
         {
             BOOST_ASSERT(result.is<std::string>());
@@ -5,7 +5,9 @@
 #include "server/http/request.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/assert.hpp>
 
+#include <algorithm>
 #include <string>
 
 namespace osrm
@@ -13,26 +15,79 @@ namespace osrm
 namespace server
 {
 
+namespace
+{
+// upper bound for POST bodies, about two million packed coordinates
+const constexpr std::size_t MAX_CONTENT_LENGTH = 16 * 1024 * 1024;
+
+bool parseContentLength(const std::string &value, std::size_t &length)
+{
+    if (value.empty())
+    {
+        return false;
+    }
+
+    length = 0;
+    for (const char character : value)
+    {
+        if (character < '0' || character > '9')
+        {
+            return false;
+        }
+        length = length * 10 + (character - '0');
+        if (length > MAX_CONTENT_LENGTH)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
 RequestParser::RequestParser()
     : state(internal_state::method_start), current_header({"", ""}),
-      selected_compression(http::no_compression)
+      selected_compression(http::no_compression), content_length(0), expect_continue(false)
 {
 }
 
-std::tuple<RequestParser::RequestStatus, http::compression_type>
+std::tuple<RequestParser::RequestStatus, http::compression_type, char *>
 RequestParser::parse(http::request &current_request, char *begin, char *end)
 {
     while (begin != end)
     {
-        RequestStatus result = consume(current_request, *begin++);
+        RequestStatus result = state == internal_state::body
+                                   ? consume_body(current_request, begin, end)
+                                   : consume(current_request, *begin++);
         if (result != RequestStatus::indeterminate)
         {
-            return std::make_tuple(result, selected_compression);
+            return std::make_tuple(result, selected_compression, begin);
         }
     }
     RequestStatus result = RequestStatus::indeterminate;
 
-    return std::make_tuple(result, selected_compression);
+    return std::make_tuple(result, selected_compression, end);
+}
+
+void RequestParser::reset()
+{
+    state = internal_state::method_start;
+    current_header.clear();
+    selected_compression = http::no_compression;
+    content_length = 0;
+    expect_continue = false;
+}
+
+RequestParser::RequestStatus
+RequestParser::consume_body(http::request &current_request, char *&begin, char *end)
+{
+    BOOST_ASSERT(current_request.body.size() < content_length);
+    const auto remaining = content_length - current_request.body.size();
+    const auto available = std::min<std::size_t>(remaining, end - begin);
+    current_request.body.append(begin, available);
+    begin += available;
+
+    return current_request.body.size() == content_length ? RequestStatus::valid
+                                                         : RequestStatus::indeterminate;
 }
 
 RequestParser::RequestStatus RequestParser::consume(http::request &current_request,
@@ -46,6 +101,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::invalid;
         }
         state = internal_state::method;
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::method:
         if (input == ' ')
@@ -57,6 +113,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         {
             return RequestStatus::invalid;
         }
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::uri_start:
         if (is_CTL(input))
@@ -116,6 +173,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
     case internal_state::http_version_major_start:
         if (is_digit(input))
         {
+            current_request.http_version_major = input - '0';
             state = internal_state::http_version_major;
             return RequestStatus::indeterminate;
         }
@@ -128,12 +186,15 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            current_request.http_version_major =
+                current_request.http_version_major * 10 + (input - '0');
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
     case internal_state::http_version_minor_start:
         if (is_digit(input))
         {
+            current_request.http_version_minor = input - '0';
             state = internal_state::http_version_minor;
             return RequestStatus::indeterminate;
         }
@@ -146,6 +207,8 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         }
         if (is_digit(input))
         {
+            current_request.http_version_minor =
+                current_request.http_version_minor * 10 + (input - '0');
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
@@ -180,6 +243,37 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             current_request.agent = current_header.value;
         }
 
+        if (boost::iequals(current_header.name, "Connection"))
+        {
+            current_request.connection = current_header.value;
+        }
+
+        if (boost::iequals(current_header.name, "Content-Type"))
+        {
+            current_request.content_type = current_header.value;
+        }
+
+        if (boost::iequals(current_header.name, "Content-Length") &&
+            !parseContentLength(current_header.value, content_length))
+        {
+            return RequestStatus::invalid;
+        }
+
+        // HTTP/1.0 clients don't know the interim response and send the body right away
+        if (boost::iequals(current_header.name, "Expect") &&
+            boost::iequals(current_header.value, "100-continue"))
+        {
+            expect_continue = current_request.http_version_major > 1 ||
+                              (current_request.http_version_major == 1 &&
+                               current_request.http_version_minor >= 1);
+        }
+
+        // only bodies with a known length are supported, chunked ones can't be delimited
+        if (boost::iequals(current_header.name, "Transfer-Encoding"))
+        {
+            return RequestStatus::invalid;
+        }
+
         if (input == '\r')
         {
             state = internal_state::expecting_newline_3;
@@ -247,8 +341,22 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
-    default: // expecting_newline_3
-        return input == '\n' ? RequestStatus::valid : RequestStatus::invalid;
+    case internal_state::expecting_newline_3:
+        if (input != '\n')
+        {
+            return RequestStatus::invalid;
+        }
+        if (content_length > 0)
+        {
+            state = internal_state::body;
+            current_request.body.reserve(content_length);
+            return expect_continue ? RequestStatus::expect_continue
+                                   : RequestStatus::indeterminate;
+        }
+        return RequestStatus::valid;
+    default: // body is consumed in bulk by consume_body
+        BOOST_ASSERT(false);
+        return RequestStatus::invalid;
     }
 }
 
@@ -0,0 +1,86 @@
+#include "server/service/batch_route_service.hpp"
+#include "server/service/utils.hpp"
+
+#include "server/api/parameters_parser.hpp"
+#include "engine/api/batch_route_parameters.hpp"
+
+#include "util/json_container.hpp"
+
+namespace osrm
+{
+namespace server
+{
+namespace service
+{
+namespace
+{
+std::string getWrongOptionHelp(const engine::api::BatchRouteParameters &parameters)
+{
+    std::string help;
+
+    const auto coord_size = parameters.coordinates.size();
+
+    const bool param_size_mismatch =
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "hints", parameters.hints, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "bearings", parameters.bearings, coord_size, help) ||
+        constrainParamSize(
+            PARAMETER_SIZE_MISMATCH_MSG, "radiuses", parameters.radiuses, coord_size, help);
+
+    if (!param_size_mismatch)
+    {
+        if (coord_size < 2 || coord_size % 2 != 0)
+        {
+            help = "Number of coordinates needs to be a positive multiple of two.";
+        }
+        else if (parameters.steps)
+        {
+            help = "Steps are not supported by the batch service.";
+        }
+    }
+
+    return help;
+}
+} // anon. ns
+
+engine::Status BatchRouteService::RunQuery(std::size_t prefix_length,
+                                           std::string &query,
+                                           CoordinatesT coordinates,
+                                           ResultT &result)
+{
+    result = util::json::Object();
+    auto &json_result = result.get<util::json::Object>();
+
+    auto query_iterator = query.begin();
+    auto parameters =
+        coordinates
+            ? api::parseParameters<engine::api::BatchRouteParameters>(
+                  query_iterator, query.end(), std::move(*coordinates))
+            : api::parseParameters<engine::api::BatchRouteParameters>(query_iterator, query.end());
+    if (!parameters || query_iterator != query.end())
+    {
+        const auto position = std::distance(query.begin(), query_iterator);
+        json_result.values["code"] = "InvalidQuery";
+        json_result.values["message"] =
+            "Query string malformed close to position " + std::to_string(prefix_length + position);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters);
+
+    if (!parameters->IsValid())
+    {
+        json_result.values["code"] = "InvalidOptions";
+        json_result.values["message"] = getWrongOptionHelp(*parameters);
+        return engine::Status::Error;
+    }
+    BOOST_ASSERT(parameters->IsValid());
+
+    // successful responses are rendered straight into the reply buffer
+    result = std::vector<char>();
+    return BaseService::routing_machine.BatchRouteJSON(*parameters,
+                                                       result.get<std::vector<char>>());
+}
+}
+}
+}
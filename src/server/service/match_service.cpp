@@ -41,15 +41,20 @@ std::string getWrongOptionHelp(const engine::api::MatchParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-MatchService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status MatchService::RunQuery(std::size_t prefix_length,
+                                      std::string &query,
+                                      CoordinatesT coordinates,
+                                      ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
 
     auto query_iterator = query.begin();
     auto parameters =
-        api::parseParameters<engine::api::MatchParameters>(query_iterator, query.end());
+        coordinates
+            ? api::parseParameters<engine::api::MatchParameters>(
+                  query_iterator, query.end(), std::move(*coordinates))
+            : api::parseParameters<engine::api::MatchParameters>(query_iterator, query.end());
     if (!parameters || query_iterator != query.end())
     {
         const auto position = std::distance(query.begin(), query_iterator);
@@ -68,7 +73,22 @@ MatchService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Match(*parameters, json_result);
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::PROTOBUF)
+    {
+        if (parameters->steps)
+        {
+            json_result.values["code"] = "InvalidOptions";
+            json_result.values["message"] = "Steps are not supported by the pbf format";
+            return engine::Status::Error;
+        }
+
+        result = std::string();
+        return BaseService::routing_machine.MatchProtobuf(*parameters, result.get<std::string>());
+    }
+
+    // successful responses are rendered straight into the reply buffer
+    result = std::vector<char>();
+    return BaseService::routing_machine.MatchJSON(*parameters, result.get<std::vector<char>>());
 }
 }
 }
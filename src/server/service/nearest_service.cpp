@@ -33,15 +33,20 @@ std::string getWrongOptionHelp(const engine::api::NearestParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status NearestService::RunQuery(std::size_t prefix_length,
+                                        std::string &query,
+                                        CoordinatesT coordinates,
+                                        ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
 
     auto query_iterator = query.begin();
     auto parameters =
-        api::parseParameters<engine::api::NearestParameters>(query_iterator, query.end());
+        coordinates
+            ? api::parseParameters<engine::api::NearestParameters>(
+                  query_iterator, query.end(), std::move(*coordinates))
+            : api::parseParameters<engine::api::NearestParameters>(query_iterator, query.end());
     if (!parameters || query_iterator != query.end())
     {
         const auto position = std::distance(query.begin(), query_iterator);
@@ -60,6 +65,12 @@ NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::PROTOBUF)
+    {
+        result = std::string();
+        return BaseService::routing_machine.NearestProtobuf(*parameters, result.get<std::string>());
+    }
+
     return BaseService::routing_machine.Nearest(*parameters, json_result);
 }
 }
@@ -58,15 +58,20 @@ std::string getWrongOptionHelp(const engine::api::TableParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TableService::RunQuery(std::size_t prefix_length,
+                                      std::string &query,
+                                      CoordinatesT coordinates,
+                                      ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
 
     auto query_iterator = query.begin();
     auto parameters =
-        api::parseParameters<engine::api::TableParameters>(query_iterator, query.end());
+        coordinates
+            ? api::parseParameters<engine::api::TableParameters>(
+                  query_iterator, query.end(), std::move(*coordinates))
+            : api::parseParameters<engine::api::TableParameters>(query_iterator, query.end());
     if (!parameters || query_iterator != query.end())
     {
         const auto position = std::distance(query.begin(), query_iterator);
@@ -85,7 +90,15 @@ TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Table(*parameters, json_result);
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::PROTOBUF)
+    {
+        result = std::string();
+        return BaseService::routing_machine.TableProtobuf(*parameters, result.get<std::string>());
+    }
+
+    // successful responses are rendered straight into the reply buffer
+    result = std::vector<char>();
+    return BaseService::routing_machine.TableJSON(*parameters, result.get<std::vector<char>>());
 }
 }
 }
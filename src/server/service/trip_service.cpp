@@ -39,14 +39,20 @@ std::string getWrongOptionHelp(const engine::api::TripParameters &parameters)
 }
 } // anon. ns
 
-engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TripService::RunQuery(std::size_t prefix_length,
+                                     std::string &query,
+                                     CoordinatesT coordinates,
+                                     ResultT &result)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
 
     auto query_iterator = query.begin();
     auto parameters =
-        api::parseParameters<engine::api::TripParameters>(query_iterator, query.end());
+        coordinates
+            ? api::parseParameters<engine::api::TripParameters>(
+                  query_iterator, query.end(), std::move(*coordinates))
+            : api::parseParameters<engine::api::TripParameters>(query_iterator, query.end());
     if (!parameters || query_iterator != query.end())
     {
         const auto position = std::distance(query.begin(), query_iterator);
@@ -67,6 +73,19 @@ engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &que
     }
     BOOST_ASSERT(parameters->IsValid());
 
+    if (parameters->format == engine::api::BaseParameters::OutputFormatType::PROTOBUF)
+    {
+        if (parameters->steps)
+        {
+            json_result.values["code"] = "InvalidOptions";
+            json_result.values["message"] = "Steps are not supported by the pbf format";
+            return engine::Status::Error;
+        }
+
+        result = std::string();
+        return BaseService::routing_machine.TripProtobuf(*parameters, result.get<std::string>());
+    }
+
     return BaseService::routing_machine.Trip(*parameters, json_result);
 }
 }
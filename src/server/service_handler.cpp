@@ -1,5 +1,6 @@
 #include "server/service_handler.hpp"
 
+#include "server/service/batch_route_service.hpp"
 #include "server/service/match_service.hpp"
 #include "server/service/nearest_service.hpp"
 #include "server/service/route_service.hpp"
@@ -11,6 +12,7 @@
 #include "util/json_util.hpp"
 
 #include <memory>
+#include <utility>
 
 namespace osrm
 {
@@ -24,6 +26,7 @@ ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(con
     service_map["trip"] = std::make_unique<service::TripService>(routing_machine);
     service_map["match"] = std::make_unique<service::MatchService>(routing_machine);
     service_map["tile"] = std::make_unique<service::TileService>(routing_machine);
+    service_map["batch"] = std::make_unique<service::BatchRouteService>(routing_machine);
 }
 
 engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
@@ -49,7 +52,12 @@ engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
         return engine::Status::Error;
     }
 
-    return service->RunQuery(parsed_url.prefix_length, parsed_url.query, result);
+    return service->RunQuery(parsed_url.prefix_length,
+                             parsed_url.query,
+                             std::move(parsed_url.coordinates),
+                             result);
 }
+
+bool ServiceHandler::Reload() { return routing_machine.Reload(); }
 }
 }
@@ -11,7 +11,9 @@
 #include "extractor/travel_mode.hpp"
 #include "partition/cell_storage.hpp"
 #include "partition/edge_based_graph_reader.hpp"
+#include "partition/io.hpp"
 #include "partition/multi_level_partition.hpp"
+#include "storage/dataset_image.hpp"
 #include "storage/io.hpp"
 #include "storage/serialization.hpp"
 #include "storage/shared_datatype.hpp"
@@ -25,26 +27,38 @@
 #include "util/fingerprint.hpp"
 #include "util/io.hpp"
 #include "util/log.hpp"
+#include "util/memory_placement.hpp"
 #include "util/packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/shared_memory_vector_wrapper.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
+#include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 
 #ifdef __linux__
+#include <fcntl.h>
 #include <sys/mman.h>
+#include <unistd.h>
 #endif
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 
+#include <tbb/task_group.h>
+
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <new>
@@ -64,9 +78,28 @@ using EdgeBasedGraph = util::StaticGraph<extractor::EdgeBasedEdge::EdgeData>;
 
 using Monitor = SharedMonitor<SharedDataTimestamp>;
 
+namespace
+{
+// Starts the kernel readahead of the whole file so the blocking reads of the loader tasks mostly
+// hit the page cache instead of waiting on every buffer refill
+void adviseWillNeed(const boost::filesystem::path &path)
+{
+#ifdef __linux__
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+}
+
 Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
 
-int Storage::Run(int max_wait)
+int Storage::Run(int max_wait, bool only_metric, bool use_huge_pages)
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -103,37 +136,108 @@ int Storage::Run(int max_wait)
     // Because of datastore_lock the only write operation can occur sequentially later.
     Monitor monitor(SharedDataTimestamp{REGION_NONE, 0});
     auto in_use_region = monitor.data().region;
+    auto in_use_updatable_region = monitor.data().updatable_region;
     auto next_timestamp = monitor.data().timestamp + 1;
-    auto next_region =
-        in_use_region == REGION_2 || in_use_region == REGION_NONE ? REGION_1 : REGION_2;
+
+    if (only_metric && (in_use_region == REGION_NONE ||
+                        !storage::SharedMemory::RegionExists(in_use_region)))
+    {
+        util::Log(logERROR) << "No dataset in shared memory to update the metric of, "
+                               "load the complete dataset first";
+        return EXIT_FAILURE;
+    }
+
+    // A metric update keeps the current dataset region and only replaces the updatable region
+    auto next_region = in_use_region;
+    auto next_updatable_region = REGION_NONE;
+    if (only_metric)
+    {
+        next_updatable_region = in_use_updatable_region == REGION_3 ? REGION_4 : REGION_3;
+    }
+    else
+    {
+        next_region =
+            in_use_region == REGION_2 || in_use_region == REGION_NONE ? REGION_1 : REGION_2;
+    }
+    const auto load_region = only_metric ? next_updatable_region : next_region;
 
     // ensure that the shared memory region we want to write to is really removed
     // this is only needef for failure recovery because we actually wait for all clients
     // to detach at the end of the function
-    if (storage::SharedMemory::RegionExists(next_region))
+    if (storage::SharedMemory::RegionExists(load_region))
     {
-        util::Log(logWARNING) << "Old shared memory region " << regionToString(next_region)
+        util::Log(logWARNING) << "Old shared memory region " << regionToString(load_region)
                               << " still exists.";
         util::UnbufferedLog() << "Retrying removal... ";
-        storage::SharedMemory::Remove(next_region);
+        storage::SharedMemory::Remove(load_region);
         util::UnbufferedLog() << "ok.";
     }
 
-    util::Log() << "Loading data into " << regionToString(next_region);
+    util::Log() << "Loading " << (only_metric ? "metric" : "data") << " into "
+                << regionToString(load_region);
 
     // Populate a memory layout into stack memory
     DataLayout layout;
     PopulateLayout(layout);
 
+    if (only_metric)
+    {
+        // All other blocks stay in the current region, so they need to be unchanged
+        auto in_use_memory = makeSharedMemory(in_use_region);
+        const auto &in_use_layout = *static_cast<const DataLayout *>(in_use_memory->Ptr());
+        for (auto i = 0; i < DataLayout::NUM_BLOCKS; ++i)
+        {
+            const auto bid = static_cast<DataLayout::BlockID>(i);
+            if (isUpdatableBlock(bid))
+                continue;
+
+            if (layout.num_entries[bid] != in_use_layout.num_entries[bid])
+            {
+                throw util::exception(std::string(block_id_to_name[bid]) +
+                                      " differs from the dataset in " +
+                                      regionToString(in_use_region) +
+                                      ", only the metric can be updated" + SOURCE_REF);
+            }
+            layout.num_entries[bid] = 0;
+        }
+
+        // Equal sizes don't prove equal data. The timestamp and the profile properties are
+        // small enough to be compared by content, checksums of the other files would read the
+        // whole dataset which a metric update is meant to avoid.
+        const auto in_use_data = static_cast<char *>(in_use_memory->Ptr()) + sizeof(DataLayout);
+        const auto check_content = [&](const DataLayout::BlockID bid,
+                                       const boost::filesystem::path &path) {
+            io::FileReader reader(path, io::FileReader::HasNoFingerprint);
+            std::vector<char> content(in_use_layout.GetBlockSize(bid));
+            reader.ReadInto(content.data(), content.size());
+            const auto in_use_ptr = in_use_layout.GetBlockPtr<char>(in_use_data, bid);
+            if (!std::equal(content.begin(), content.end(), in_use_ptr))
+            {
+                throw util::exception(path.string() + " differs from the dataset in " +
+                                      regionToString(in_use_region) +
+                                      ", only the metric can be updated" + SOURCE_REF);
+            }
+        };
+        check_content(DataLayout::TIMESTAMP, config.timestamp_path);
+        check_content(DataLayout::PROPERTIES, config.properties_path);
+    }
+
     // Allocate shared memory block
     auto regions_size = sizeof(layout) + layout.GetSizeOfLayout();
     util::Log() << "Allocating shared memory of " << regions_size << " bytes";
-    auto data_memory = makeSharedMemory(next_region, regions_size);
+    auto data_memory = makeSharedMemory(load_region, regions_size);
+
+    // Has to happen before the pages are touched. Only effective with shmem_enabled=advise in
+    // /sys/kernel/mm/transparent_hugepage, the default of most distributions is never.
+    if (use_huge_pages && !util::AdviseHugePages(data_memory->Ptr(), regions_size))
+    {
+        util::Log(logWARNING) << "Could not advise huge pages for the shared memory region";
+    }
 
     // Copy memory layout to shared memory and populate data
     char *shared_memory_ptr = static_cast<char *>(data_memory->Ptr());
     memcpy(shared_memory_ptr, &layout, sizeof(layout));
-    PopulateData(layout, shared_memory_ptr + sizeof(layout));
+    PopulateData(layout, shared_memory_ptr + sizeof(layout), only_metric);
 
     { // Lock for write access shared region mutex
         boost::interprocess::scoped_lock<Monitor::mutex_type> lock(monitor.get_mutex(),
@@ -150,6 +254,7 @@ int Storage::Run(int max_wait)
                        "attached processes will not receive notifications and must be restarted";
                 Monitor::remove();
                 in_use_region = REGION_NONE;
+                in_use_updatable_region = REGION_NONE;
                 monitor = Monitor(SharedDataTimestamp{REGION_NONE, 0});
             }
         }
@@ -158,32 +263,42 @@ int Storage::Run(int max_wait)
             lock.lock();
         }
 
-        // Update the current region ID and timestamp
+        // Update the current region IDs and timestamp
         monitor.data().region = next_region;
+        monitor.data().updatable_region = next_updatable_region;
         monitor.data().timestamp = next_timestamp;
     }
 
     util::Log() << "All data loaded. Notify all client about new data in "
-                << regionToString(next_region) << " with timestamp " << next_timestamp;
+                << regionToString(next_region) << " and " << regionToString(next_updatable_region)
+                << " with timestamp " << next_timestamp;
     monitor.notify_all();
 
     // SHMCTL(2): Mark the segment to be destroyed. The segment will actually be destroyed
     // only after the last process detaches it.
-    if (in_use_region != REGION_NONE && storage::SharedMemory::RegionExists(in_use_region))
-    {
-        util::UnbufferedLog() << "Marking old shared memory region "
-                              << regionToString(in_use_region) << " for removal... ";
+    const auto remove_region = [](const SharedDataType region) {
+        if (region == REGION_NONE || !storage::SharedMemory::RegionExists(region))
+            return;
+
+        util::UnbufferedLog() << "Marking old shared memory region " << regionToString(region)
+                              << " for removal... ";
 
         // aquire a handle for the old shared memory region before we mark it for deletion
         // we will need this to wait for all users to detach
-        auto in_use_shared_memory = makeSharedMemory(in_use_region);
+        auto in_use_shared_memory = makeSharedMemory(region);
 
-        storage::SharedMemory::Remove(in_use_region);
+        storage::SharedMemory::Remove(region);
         util::UnbufferedLog() << "ok.";
 
         util::UnbufferedLog() << "Waiting for clients to detach... ";
         in_use_shared_memory->WaitForDetach();
         util::UnbufferedLog() << " ok.";
+    };
+
+    remove_region(in_use_updatable_region);
+    if (!only_metric)
+    {
+        remove_region(in_use_region);
     }
 
     util::Log() << "All clients switched.";
@@ -191,6 +306,43 @@ int Storage::Run(int max_wait)
     return EXIT_SUCCESS;
 }
 
+void Storage::WriteImage(const boost::filesystem::path &image_path)
+{
+    DatasetImageHeader header;
+    std::copy(DATASET_IMAGE_MAGIC, DATASET_IMAGE_MAGIC + sizeof(DATASET_IMAGE_MAGIC), header.magic);
+    header.fingerprint = util::FingerPrint::GetValid();
+    PopulateLayout(header.layout);
+    header.data_offset = DatasetImageHeader::GetDataOffset();
+    header.data_size = header.layout.GetSizeOfLayout();
+
+    // Write into a temporary file and rename it so processes that still map the previous
+    // image keep their consistent copy
+    const boost::filesystem::path temporary_path = image_path.string() + ".tmp";
+    const auto image_size = header.data_offset + header.data_size;
+    util::Log() << "Writing dataset image of " << image_size << " bytes to " << image_path;
+    {
+        boost::filesystem::ofstream create(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!create)
+        {
+            throw util::exception("Could not create " + temporary_path.string() + SOURCE_REF);
+        }
+    }
+    boost::filesystem::resize_file(temporary_path, image_size);
+
+    {
+        boost::interprocess::file_mapping file(temporary_path.string().c_str(),
+                                               boost::interprocess::read_write);
+        boost::interprocess::mapped_region region(file, boost::interprocess::read_write);
+        char *image_ptr = static_cast<char *>(region.get_address());
+
+        std::memcpy(image_ptr, &header, sizeof(header));
+        PopulateData(header.layout, image_ptr + header.data_offset);
+        region.flush();
+    }
+
+    boost::filesystem::rename(temporary_path, image_path);
+}
+
 /**
  * This function examines all our data files and figures out how much
  * memory needs to be allocated, and the position of each data structure
@@ -421,9 +573,12 @@ void Storage::PopulateLayout(DataLayout &layout)
         if (boost::filesystem::exists(config.mld_storage_path))
         {
             io::FileReader reader(config.mld_storage_path, io::FileReader::VerifyFingerprint);
+            partition::io::readCellStorageHeader(reader, config.mld_storage_path);
 
             const auto weights_count = reader.ReadVectorSize<EdgeWeight>();
             layout.SetBlockSize<EdgeWeight>(DataLayout::MLD_CELL_WEIGHTS, weights_count);
+            const auto durations_count = reader.ReadVectorSize<EdgeWeight>();
+            layout.SetBlockSize<EdgeWeight>(DataLayout::MLD_CELL_DURATIONS, durations_count);
             const auto source_node_count = reader.ReadVectorSize<NodeID>();
             layout.SetBlockSize<NodeID>(DataLayout::MLD_CELL_SOURCE_BOUNDARY, source_node_count);
             const auto destination_node_count = reader.ReadVectorSize<NodeID>();
@@ -439,6 +594,7 @@ void Storage::PopulateLayout(DataLayout &layout)
         else
         {
             layout.SetBlockSize<char>(DataLayout::MLD_CELL_WEIGHTS, 0);
+            layout.SetBlockSize<char>(DataLayout::MLD_CELL_DURATIONS, 0);
             layout.SetBlockSize<char>(DataLayout::MLD_CELL_SOURCE_BOUNDARY, 0);
             layout.SetBlockSize<char>(DataLayout::MLD_CELL_DESTINATION_BOUNDARY, 0);
             layout.SetBlockSize<char>(DataLayout::MLD_CELLS, 0);
@@ -475,36 +631,71 @@ void Storage::PopulateLayout(DataLayout &layout)
     }
 }
 
-void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
+void Storage::PopulateData(const DataLayout &layout, char *memory_ptr, bool only_updatable)
 {
     BOOST_ASSERT(memory_ptr != nullptr);
 
     // read actual data into shared memory object //
 
+    // Every file is read by its own task: the blocks are disjoint ranges of memory_ptr and
+    // GetBlockPtr only writes the canaries of the block it is asked for.
+    tbb::task_group loaders;
+    const auto load_updatable = [&loaders](const char *name,
+                                           const boost::filesystem::path &path,
+                                           std::function<void()> populate) {
+        loaders.run([name, path, populate] {
+            adviseWillNeed(path);
+
+            TIMER_START(load_block);
+            populate();
+            TIMER_STOP(load_block);
+
+            boost::system::error_code error;
+            const auto bytes = boost::filesystem::file_size(path, error);
+            const auto megabytes = error ? 0. : bytes / (1024. * 1024.);
+            util::Log() << "Loaded " << name << ": " << megabytes << " MiB in "
+                        << TIMER_MSEC(load_block) << "ms ("
+                        << megabytes / std::max(TIMER_SEC(load_block), 0.001) << " MiB/s)";
+        });
+    };
+    // only called for files without updatable blocks, they are skipped for metric updates
+    const auto load = [&](const char *name,
+                          const boost::filesystem::path &path,
+                          std::function<void()> populate) {
+        if (!only_updatable)
+        {
+            load_updatable(name, path, std::move(populate));
+        }
+    };
+
+    TIMER_START(load_data);
+
     // Load the HSGR file
     if (boost::filesystem::exists(config.hsgr_data_path))
     {
-        io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::VerifyFingerprint);
-        auto hsgr_header = serialization::readHSGRHeader(hsgr_file);
-        unsigned *checksum_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::HSGR_CHECKSUM);
-        *checksum_ptr = hsgr_header.checksum;
-
-        // load the nodes of the search graph
-        QueryGraph::NodeArrayEntry *graph_node_list_ptr =
-            layout.GetBlockPtr<QueryGraph::NodeArrayEntry, true>(memory_ptr,
-                                                                 DataLayout::CH_GRAPH_NODE_LIST);
-
-        // load the edges of the search graph
-        QueryGraph::EdgeArrayEntry *graph_edge_list_ptr =
-            layout.GetBlockPtr<QueryGraph::EdgeArrayEntry, true>(memory_ptr,
-                                                                 DataLayout::CH_GRAPH_EDGE_LIST);
-
-        serialization::readHSGR(hsgr_file,
-                                graph_node_list_ptr,
-                                hsgr_header.number_of_nodes,
-                                graph_edge_list_ptr,
-                                hsgr_header.number_of_edges);
+        load_updatable("CH graph", config.hsgr_data_path, [&] {
+            io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::VerifyFingerprint);
+            auto hsgr_header = serialization::readHSGRHeader(hsgr_file);
+            unsigned *checksum_ptr =
+                layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::HSGR_CHECKSUM);
+            *checksum_ptr = hsgr_header.checksum;
+
+            // load the nodes of the search graph
+            QueryGraph::NodeArrayEntry *graph_node_list_ptr =
+                layout.GetBlockPtr<QueryGraph::NodeArrayEntry, true>(
+                    memory_ptr, DataLayout::CH_GRAPH_NODE_LIST);
+
+            // load the edges of the search graph
+            QueryGraph::EdgeArrayEntry *graph_edge_list_ptr =
+                layout.GetBlockPtr<QueryGraph::EdgeArrayEntry, true>(
+                    memory_ptr, DataLayout::CH_GRAPH_EDGE_LIST);
+
+            serialization::readHSGR(hsgr_file,
+                                    graph_node_list_ptr,
+                                    hsgr_header.number_of_nodes,
+                                    graph_edge_list_ptr,
+                                    hsgr_header.number_of_edges);
+        });
     }
     else
     {
@@ -516,6 +707,7 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
     }
 
     // store the filename of the on-disk portion of the RTree
+    if (!only_updatable)
     {
         const auto file_index_path_ptr =
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::FILE_INDEX_PATH);
@@ -532,7 +724,7 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
     }
 
     // Name data
-    {
+    load("names", config.names_data_path, [&] {
         io::FileReader name_file(config.names_data_path, io::FileReader::HasNoFingerprint);
         std::size_t name_file_size = name_file.GetSize();
 
@@ -541,10 +733,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::NAME_CHAR_DATA);
 
         name_file.ReadInto<char>(name_char_ptr, name_file_size);
-    }
+    });
 
     // Turn lane data
-    {
+    load("turn lane data", config.turn_lane_data_path, [&] {
         io::FileReader lane_data_file(config.turn_lane_data_path, io::FileReader::HasNoFingerprint);
 
         const auto lane_tuple_count = lane_data_file.ReadElementCount64();
@@ -556,10 +748,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(lane_tuple_count * sizeof(util::guidance::LaneTupleIdPair) ==
                      layout.GetBlockSize(DataLayout::TURN_LANE_DATA));
         lane_data_file.ReadInto(turn_lane_data_ptr, lane_tuple_count);
-    }
+    });
 
     // Turn lane descriptions
-    {
+    load("turn lane descriptions", config.turn_lane_description_path, [&] {
         std::vector<std::uint32_t> lane_description_offsets;
         std::vector<extractor::guidance::TurnLaneType::Mask> lane_description_masks;
         util::deserializeAdjacencyArray(config.turn_lane_description_path.string(),
@@ -592,10 +784,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             std::copy(
                 lane_description_masks.begin(), lane_description_masks.end(), turn_lane_mask_ptr);
         }
-    }
+    });
 
     // Load original edge data
-    {
+    load("edges", config.edges_data_path, [&] {
         io::FileReader edges_input_file(config.edges_data_path, io::FileReader::HasNoFingerprint);
 
         const auto number_of_original_edges = edges_input_file.ReadElementCount64();
@@ -633,25 +825,39 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                  pre_turn_bearing_ptr,
                                  post_turn_bearing_ptr,
                                  number_of_original_edges);
-    }
+    });
 
     // load compressed geometry
-    {
+    load_updatable("geometries", config.geometries_path, [&] {
         io::FileReader geometry_input_file(config.geometries_path,
                                            io::FileReader::HasNoFingerprint);
 
         const auto geometry_index_count = geometry_input_file.ReadElementCount32();
-        const auto geometries_index_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::GEOMETRIES_INDEX);
-        BOOST_ASSERT(geometry_index_count == layout.num_entries[DataLayout::GEOMETRIES_INDEX]);
-        geometry_input_file.ReadInto(geometries_index_ptr, geometry_index_count);
+        if (only_updatable)
+        {
+            geometry_input_file.Skip<unsigned>(geometry_index_count);
+        }
+        else
+        {
+            const auto geometries_index_ptr =
+                layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::GEOMETRIES_INDEX);
+            BOOST_ASSERT(geometry_index_count == layout.num_entries[DataLayout::GEOMETRIES_INDEX]);
+            geometry_input_file.ReadInto(geometries_index_ptr, geometry_index_count);
+        }
 
-        const auto geometries_node_id_list_ptr =
-            layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::GEOMETRIES_NODE_LIST);
         const auto geometry_node_lists_count = geometry_input_file.ReadElementCount32();
-        BOOST_ASSERT(geometry_node_lists_count ==
-                     layout.num_entries[DataLayout::GEOMETRIES_NODE_LIST]);
-        geometry_input_file.ReadInto(geometries_node_id_list_ptr, geometry_node_lists_count);
+        if (only_updatable)
+        {
+            geometry_input_file.Skip<NodeID>(geometry_node_lists_count);
+        }
+        else
+        {
+            const auto geometries_node_id_list_ptr =
+                layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::GEOMETRIES_NODE_LIST);
+            BOOST_ASSERT(geometry_node_lists_count ==
+                         layout.num_entries[DataLayout::GEOMETRIES_NODE_LIST]);
+            geometry_input_file.ReadInto(geometries_node_id_list_ptr, geometry_node_lists_count);
+        }
 
         const auto geometries_fwd_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
             memory_ptr, DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
@@ -681,16 +887,16 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<DatasourceID, true>(memory_ptr, DataLayout::DATASOURCES_LIST);
         BOOST_ASSERT(geometry_node_lists_count == layout.num_entries[DataLayout::DATASOURCES_LIST]);
         geometry_input_file.ReadInto(datasource_list_ptr, geometry_node_lists_count);
-    }
+    });
 
-    {
+    load_updatable("datasource names", config.datasource_names_path, [&] {
         const auto datasources_names_ptr = layout.GetBlockPtr<extractor::Datasources, true>(
             memory_ptr, DataLayout::DATASOURCES_NAMES);
         extractor::io::read(config.datasource_names_path, *datasources_names_ptr);
-    }
+    });
 
     // Loading list of coordinates
-    {
+    load("nodes", config.nodes_data_path, [&] {
         io::FileReader nodes_file(config.nodes_data_path, io::FileReader::HasNoFingerprint);
         nodes_file.Skip<std::uint64_t>(1); // node_count
         const auto coordinates_ptr =
@@ -705,30 +911,30 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                  coordinates_ptr,
                                  osmnodeid_list,
                                  layout.num_entries[DataLayout::COORDINATE_LIST]);
-    }
+    });
 
     // load turn weight penalties
-    {
+    load_updatable("turn weight penalties", config.turn_weight_penalties_path, [&] {
         io::FileReader turn_weight_penalties_file(config.turn_weight_penalties_path,
                                                   io::FileReader::HasNoFingerprint);
         const auto number_of_penalties = turn_weight_penalties_file.ReadElementCount64();
         const auto turn_weight_penalties_ptr =
             layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_WEIGHT_PENALTIES);
         turn_weight_penalties_file.ReadInto(turn_weight_penalties_ptr, number_of_penalties);
-    }
+    });
 
     // load turn duration penalties
-    {
+    load_updatable("turn duration penalties", config.turn_duration_penalties_path, [&] {
         io::FileReader turn_duration_penalties_file(config.turn_duration_penalties_path,
                                                     io::FileReader::HasNoFingerprint);
         const auto number_of_penalties = turn_duration_penalties_file.ReadElementCount64();
         const auto turn_duration_penalties_ptr =
             layout.GetBlockPtr<TurnPenalty, true>(memory_ptr, DataLayout::TURN_DURATION_PENALTIES);
         turn_duration_penalties_file.ReadInto(turn_duration_penalties_ptr, number_of_penalties);
-    }
+    });
 
     // store timestamp
-    {
+    load("timestamp", config.timestamp_path, [&] {
         io::FileReader timestamp_file(config.timestamp_path, io::FileReader::HasNoFingerprint);
         const auto timestamp_size = timestamp_file.Size();
 
@@ -736,10 +942,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::TIMESTAMP);
         BOOST_ASSERT(timestamp_size == layout.num_entries[DataLayout::TIMESTAMP]);
         timestamp_file.ReadInto(timestamp_ptr, timestamp_size);
-    }
+    });
 
     // store search tree portion of rtree
-    {
+    load("rtree", config.ram_index_path, [&] {
         io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
         // perform this read so that we're at the right stream position for the next
         // read.
@@ -748,54 +954,57 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<RTreeNode, true>(memory_ptr, DataLayout::R_SEARCH_TREE);
 
         tree_node_file.ReadInto(rtree_ptr, layout.num_entries[DataLayout::R_SEARCH_TREE]);
-    }
+    });
 
     if (boost::filesystem::exists(config.core_data_path))
     {
-        io::FileReader core_marker_file(config.core_data_path, io::FileReader::HasNoFingerprint);
-        const auto number_of_core_markers = core_marker_file.ReadElementCount32();
-
-        // load core markers
-        std::vector<char> unpacked_core_markers(number_of_core_markers);
-        core_marker_file.ReadInto(unpacked_core_markers.data(), number_of_core_markers);
+        load_updatable("core markers", config.core_data_path, [&] {
+            io::FileReader core_marker_file(config.core_data_path,
+                                            io::FileReader::HasNoFingerprint);
+            const auto number_of_core_markers = core_marker_file.ReadElementCount32();
 
-        const auto core_marker_ptr =
-            layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::CH_CORE_MARKER);
+            // load core markers
+            std::vector<char> unpacked_core_markers(number_of_core_markers);
+            core_marker_file.ReadInto(unpacked_core_markers.data(), number_of_core_markers);
 
-        for (auto i = 0u; i < number_of_core_markers; ++i)
-        {
-            BOOST_ASSERT(unpacked_core_markers[i] == 0 || unpacked_core_markers[i] == 1);
+            const auto core_marker_ptr =
+                layout.GetBlockPtr<unsigned, true>(memory_ptr, DataLayout::CH_CORE_MARKER);
 
-            if (unpacked_core_markers[i] == 1)
+            for (auto i = 0u; i < number_of_core_markers; ++i)
             {
-                const unsigned bucket = i / 32;
-                const unsigned offset = i % 32;
-                const unsigned value = [&] {
-                    unsigned return_value = 0;
-                    if (0 != offset)
-                    {
-                        return_value = core_marker_ptr[bucket];
-                    }
-                    return return_value;
-                }();
-
-                core_marker_ptr[bucket] = (value | (1u << offset));
+                BOOST_ASSERT(unpacked_core_markers[i] == 0 || unpacked_core_markers[i] == 1);
+
+                if (unpacked_core_markers[i] == 1)
+                {
+                    const unsigned bucket = i / 32;
+                    const unsigned offset = i % 32;
+                    const unsigned value = [&] {
+                        unsigned return_value = 0;
+                        if (0 != offset)
+                        {
+                            return_value = core_marker_ptr[bucket];
+                        }
+                        return return_value;
+                    }();
+
+                    core_marker_ptr[bucket] = (value | (1u << offset));
+                }
             }
-        }
+        });
     }
 
     // load profile properties
-    {
+    load("properties", config.properties_path, [&] {
         io::FileReader profile_properties_file(config.properties_path,
                                                io::FileReader::HasNoFingerprint);
         const auto profile_properties_ptr = layout.GetBlockPtr<extractor::ProfileProperties, true>(
             memory_ptr, DataLayout::PROPERTIES);
         profile_properties_file.ReadInto(profile_properties_ptr,
                                          layout.num_entries[DataLayout::PROPERTIES]);
-    }
+    });
 
     // Load intersection data
-    {
+    load("intersections", config.intersection_class_path, [&] {
         io::FileReader intersection_file(config.intersection_class_path,
                                          io::FileReader::VerifyFingerprint);
 
@@ -876,12 +1085,12 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                              sizeof(decltype(entry_class_table)::value_type));
             std::copy(entry_class_table.begin(), entry_class_table.end(), entry_class_ptr);
         }
-    }
+    });
 
+    // Loading MLD Data
+    if (boost::filesystem::exists(config.mld_partition_path))
     {
-        // Loading MLD Data
-        if (boost::filesystem::exists(config.mld_partition_path))
-        {
+        load("MLD partition", config.mld_partition_path, [&] {
             auto mld_level_data_ptr =
                 layout.GetBlockPtr<partition::MultiLevelPartition::LevelData, true>(
                     memory_ptr, DataLayout::MLD_LEVEL_DATA);
@@ -903,13 +1112,17 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             reader.ReadInto(size);
             BOOST_ASSERT(size == layout.GetBlockEntries(DataLayout::MLD_CELL_TO_CHILDREN));
             reader.ReadInto(mld_chilren_ptr, size);
-        }
+        });
+    }
 
-        if (boost::filesystem::exists(config.mld_storage_path))
-        {
+    if (boost::filesystem::exists(config.mld_storage_path))
+    {
+        load_updatable("MLD cells", config.mld_storage_path, [&] {
             io::FileReader reader(config.mld_storage_path, io::FileReader::VerifyFingerprint);
             auto mld_cell_weights_ptr =
                 layout.GetBlockPtr<EdgeWeight, true>(memory_ptr, DataLayout::MLD_CELL_WEIGHTS);
+            auto mld_cell_durations_ptr =
+                layout.GetBlockPtr<EdgeWeight, true>(memory_ptr, DataLayout::MLD_CELL_DURATIONS);
             auto mld_source_boundary_ptr =
                 layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::MLD_CELL_SOURCE_BOUNDARY);
             auto mld_destination_boundary_ptr = layout.GetBlockPtr<NodeID, true>(
@@ -919,12 +1132,22 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             auto mld_cell_level_offsets_ptr = layout.GetBlockPtr<std::uint64_t, true>(
                 memory_ptr, DataLayout::MLD_CELL_LEVEL_OFFSETS);
 
+            partition::io::readCellStorageHeader(reader, config.mld_storage_path);
+
             std::uint64_t size;
 
             reader.ReadInto(size);
             BOOST_ASSERT(size == layout.GetBlockEntries(DataLayout::MLD_CELL_WEIGHTS));
             reader.ReadInto(mld_cell_weights_ptr, size);
 
+            reader.ReadInto(size);
+            BOOST_ASSERT(size == layout.GetBlockEntries(DataLayout::MLD_CELL_DURATIONS));
+            reader.ReadInto(mld_cell_durations_ptr, size);
+
+            // the remaining arrays only depend on the partition
+            if (only_updatable)
+                return;
+
             reader.ReadInto(size);
             BOOST_ASSERT(size == layout.GetBlockEntries(DataLayout::MLD_CELL_SOURCE_BOUNDARY));
             reader.ReadInto(mld_source_boundary_ptr, size);
@@ -940,10 +1163,12 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             reader.ReadInto(size);
             BOOST_ASSERT(size == layout.GetBlockEntries(DataLayout::MLD_CELL_LEVEL_OFFSETS));
             reader.ReadInto(mld_cell_level_offsets_ptr, size);
-        }
+        });
+    }
 
-        if (boost::filesystem::exists(config.mld_graph_path))
-        {
+    if (boost::filesystem::exists(config.mld_graph_path))
+    {
+        load_updatable("MLD graph", config.mld_graph_path, [&] {
             io::FileReader reader(config.mld_graph_path, io::FileReader::VerifyFingerprint);
 
             auto nodes_ptr =
@@ -962,8 +1187,14 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             reader.ReadInto(edges_ptr, num_edges);
             auto num_node_to_offset = reader.ReadElementCount64();
             reader.ReadInto(node_to_offset_ptr, num_node_to_offset);
-        }
+        });
     }
+
+    // rethrows the first exception of a failed task
+    loaders.wait();
+
+    TIMER_STOP(load_data);
+    util::Log() << "Loaded all blocks in " << TIMER_MSEC(load_data) << "ms";
 }
 }
 }
@@ -1,4 +1,4 @@
-#include "extractor/tarjan_scc.hpp"
+#include "extractor/parallel_scc.hpp"
 #include "util/coordinate.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/dynamic_graph.hpp"
@@ -147,11 +147,11 @@ int main(int argc, char *argv[])
 
     util::Log() << "Starting SCC graph traversal";
 
-    extractor::TarjanSCC<tools::TarjanGraph> tarjan{*graph};
-    tarjan.Run();
+    extractor::ParallelSCC<tools::TarjanGraph> scc{*graph};
+    scc.Run();
 
-    util::Log() << "Identified: " << tarjan.GetNumberOfComponents() << " components";
-    util::Log() << "Identified " << tarjan.GetSizeOneCount() << " size one components";
+    util::Log() << "Identified: " << scc.GetNumberOfComponents() << " components";
+    util::Log() << "Identified " << scc.GetSizeOneCount() << " size one components";
 
     std::uint64_t total_network_length = 0;
 
@@ -172,11 +172,11 @@ int main(int argc, char *argv[])
                 total_network_length += 100 * util::coordinate_calculation::greatCircleDistance(
                                                   coordinate_list[source], coordinate_list[target]);
 
-                auto source_component_id = tarjan.GetComponentID(source);
-                auto target_component_id = tarjan.GetComponentID(target);
+                auto source_component_id = scc.GetComponentID(source);
+                auto target_component_id = scc.GetComponentID(target);
 
-                auto source_component_size = tarjan.GetComponentSize(source_component_id);
-                auto target_component_size = tarjan.GetComponentSize(target_component_id);
+                auto source_component_size = scc.GetComponentSize(source_component_id);
+                auto target_component_size = scc.GetComponentSize(target_component_id);
 
                 const auto smallest = std::min(source_component_size, target_component_size);
 
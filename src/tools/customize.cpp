@@ -51,7 +51,12 @@ parseArguments(int argc, char *argv[], customizer::CustomizationConfig &customiz
                            ->default_value(0.0),
                        "Use with `--segment-speed-file`. Provide an `x` factor, by which Extractor "
                        "will log edge "
-                       "weights updated by more than this factor");
+                       "weights updated by more than this factor")(
+            "incremental",
+            boost::program_options::bool_switch(&customization_config.incremental)
+                ->default_value(false),
+            "Only re-customize cells that contain edges with weights different from the last "
+            "customization run");
 
     // hidden options, will be allowed on command line, but will not be
     // shown to the user
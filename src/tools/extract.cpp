@@ -41,6 +41,12 @@ return_code parseArguments(int argc, char *argv[], extractor::ExtractorConfig &e
         boost::program_options::value<unsigned int>(&extractor_config.requested_num_threads)
             ->default_value(tbb::task_scheduler_init::default_num_threads()),
         "Number of threads to use")(
+        "memory-budget",
+        boost::program_options::value<unsigned int>(&extractor_config.memory_budget)
+            ->default_value(util::GetPhysicalMemory() / 2 / (1024 * 1024 * 1024)),
+        "GiB of RAM the extracted data may use to be sorted in memory, if it needs more it is "
+        "sorted in stxxl's external memory. Defaults to half of the physical memory, 0 always "
+        "uses external memory.")(
         "small-component-size",
         boost::program_options::value<unsigned int>(&extractor_config.small_component_size)
             ->default_value(1000),
@@ -50,7 +56,13 @@ return_code parseArguments(int argc, char *argv[], extractor::ExtractorConfig &e
         boost::program_options::bool_switch(&extractor_config.use_metadata)
             ->implicit_value(true)
             ->default_value(false),
-        "Use metada during osm parsing (This can affect the extraction performance).");
+        "Use metada during osm parsing (This can affect the extraction performance).")(
+        "parallel-compression",
+        boost::program_options::bool_switch(&extractor_config.use_parallel_compression)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Compress the chains of degree 2 nodes in parallel. Where roads run in parallel or form "
+        "loops the compressed graph can differ slightly from the sequential compression.");
 
     bool dummy;
     // hidden options, will be allowed on command line, but will not be
@@ -67,14 +67,23 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              std::string &ip_address,
                                              int &ip_port,
                                              int &requested_num_threads,
+                                             int &requested_num_compute_threads,
+                                             int &max_queued_requests,
+                                             short &keepalive_timeout,
                                              bool &use_shared_memory,
+                                             bool &use_mmap,
+                                             bool &use_huge_pages,
+                                             bool &use_numa_replicas,
                                              std::string &algorithm,
                                              bool &trial,
                                              int &max_locations_trip,
                                              int &max_locations_viaroute,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
-                                             int &max_results_nearest)
+                                             int &max_results_nearest,
+                                             int &max_table_threads,
+                                             int &max_routes_batch,
+                                             int &max_batch_threads)
 {
     using boost::program_options::value;
     using boost::filesystem::path;
@@ -97,9 +106,31 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("threads,t",
          value<int>(&requested_num_threads)->default_value(8),
          "Number of threads to use") //
+        ("compute-threads",
+         value<int>(&requested_num_compute_threads)->default_value(0),
+         "Number of worker threads computing replies, 0 computes them on the I/O threads") //
+        ("max-queued-requests",
+         value<int>(&max_queued_requests)->default_value(0),
+         "Max. requests waiting for a worker thread before new requests are rejected with "
+         "503, 0 means unlimited") //
+        ("keepalive-timeout,k",
+         value<short>(&keepalive_timeout)->default_value(5),
+         "Default keepalive duration in seconds, 0 disables persistent connections") //
         ("shared-memory,s",
          value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
+        ("mmap",
+         value<bool>(&use_mmap)->implicit_value(true)->default_value(false),
+         "Map the dataset image written by osrm-datastore --image instead of loading the "
+         "files") //
+        ("huge-pages",
+         value<bool>(&use_huge_pages)->implicit_value(true)->default_value(false),
+         "Back the dataset loaded into memory with huge pages, reserved ones if available "
+         "(vm.nr_hugepages) or transparent ones") //
+        ("numa-replicas",
+         value<bool>(&use_numa_replicas)->implicit_value(true)->default_value(false),
+         "Load a copy of the dataset on every NUMA node and pin the server threads to the "
+         "nodes") //
         ("algorithm,a",
          value<std::string>(&algorithm)->default_value("CH"),
          "Algorithm to use for the data. Can be CH, CoreCH, MLD.") //
@@ -117,7 +148,16 @@ inline unsigned generateServerProgramOptions(const int argc,
          "Max. locations supported in map matching query") //
         ("max-nearest-size",
          value<int>(&max_results_nearest)->default_value(100),
-         "Max. results supported in nearest query");
+         "Max. results supported in nearest query") //
+        ("max-table-threads",
+         value<int>(&max_table_threads)->default_value(1),
+         "Max. threads a single distance table query may use") //
+        ("max-batch-size",
+         value<int>(&max_routes_batch)->default_value(1000),
+         "Max. origin/destination pairs supported in batch route query") //
+        ("max-batch-threads",
+         value<int>(&max_batch_threads)->default_value(1),
+         "Max. threads a single batch route query may use");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -190,7 +230,8 @@ int main(int argc, const char *argv[]) try
 
     bool trial_run = false;
     std::string ip_address;
-    int ip_port, requested_thread_num;
+    int ip_port, requested_thread_num, requested_compute_thread_num, max_queued_requests;
+    short keepalive_timeout;
 
     EngineConfig config;
     boost::filesystem::path base_path;
@@ -201,14 +242,23 @@ int main(int argc, const char *argv[]) try
                                                               ip_address,
                                                               ip_port,
                                                               requested_thread_num,
+                                                              requested_compute_thread_num,
+                                                              max_queued_requests,
+                                                              keepalive_timeout,
                                                               config.use_shared_memory,
+                                                              config.use_mmap,
+                                                              config.use_huge_pages,
+                                                              config.use_numa_replicas,
                                                               algorithm,
                                                               trial_run,
                                                               config.max_locations_trip,
                                                               config.max_locations_viaroute,
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
-                                                              config.max_results_nearest);
+                                                              config.max_results_nearest,
+                                                              config.max_table_threads,
+                                                              config.max_routes_batch,
+                                                              config.max_batch_threads);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -223,7 +273,13 @@ int main(int argc, const char *argv[]) try
     }
     if (!config.IsValid())
     {
-        if (base_path.empty() != config.use_shared_memory)
+        if ((config.use_huge_pages || config.use_numa_replicas) &&
+            (config.use_shared_memory || config.use_mmap))
+        {
+            util::Log(logWARNING) << "Huge pages and NUMA replicas require loading the dataset "
+                                     "into memory, they conflict with shared memory and mmap.";
+        }
+        else if (base_path.empty() != config.use_shared_memory)
         {
             util::Log(logWARNING) << "Path settings and shared memory conflicts.";
         }
@@ -290,10 +346,20 @@ int main(int argc, const char *argv[]) try
     {
         util::Log() << "Loading from shared memory";
     }
+    else if (config.use_mmap)
+    {
+        util::Log() << "Mapping dataset image " << config.storage_config.dataset_image_path;
+    }
+    else if (config.use_numa_replicas)
+    {
+        util::Log() << "Replicating the dataset on every NUMA node";
+    }
 
     util::Log() << "Threads: " << requested_thread_num;
+    util::Log() << "Compute threads: " << requested_compute_thread_num;
     util::Log() << "IP address: " << ip_address;
     util::Log() << "IP port: " << ip_port;
+    util::Log() << "Keepalive timeout: " << keepalive_timeout << "s";
 
 #ifndef _WIN32
     int sig = 0;
@@ -303,8 +369,27 @@ int main(int argc, const char *argv[]) try
     pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 #endif
 
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    if (keepalive_timeout < 0)
+    {
+        util::Log(logWARNING) << "Keepalive timeout must be non-negative";
+        return EXIT_FAILURE;
+    }
+    if (requested_compute_thread_num < 0 || max_queued_requests < 0)
+    {
+        util::Log(logWARNING) << "Compute threads and queue size must be non-negative";
+        return EXIT_FAILURE;
+    }
+
+    auto routing_server =
+        server::Server::CreateServer(ip_address,
+                                     ip_port,
+                                     requested_thread_num,
+                                     static_cast<unsigned>(requested_compute_thread_num),
+                                     static_cast<unsigned>(max_queued_requests),
+                                     static_cast<unsigned>(keepalive_timeout),
+                                     config.use_numa_replicas);
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
+    auto reloader = service_handler.get();
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
 
@@ -328,13 +413,23 @@ int main(int argc, const char *argv[]) try
         sigaddset(&wait_mask, SIGINT);
         sigaddset(&wait_mask, SIGQUIT);
         sigaddset(&wait_mask, SIGTERM);
+        sigaddset(&wait_mask, SIGHUP);
         pthread_sigmask(SIG_BLOCK, &wait_mask, nullptr);
         util::Log() << "running and waiting for requests";
         if (std::getenv("SIGNAL_PARENT_WHEN_READY"))
         {
             kill(getppid(), SIGUSR1);
         }
-        sigwait(&wait_mask, &sig);
+        // SIGHUP reloads the dataset while the server keeps answering requests
+        while (sigwait(&wait_mask, &sig) == 0 && sig == SIGHUP)
+        {
+            util::Log() << "reloading dataset";
+            if (!reloader->Reload())
+            {
+                util::Log(logWARNING) << "dataset not reloaded, a reload is still running or "
+                                         "the data is in shared memory";
+            }
+        }
 #else
         // Set console control handler to allow server to be stopped.
         console_ctrl_function = std::bind(&server::Server::Stop, routing_server);
@@ -44,6 +44,8 @@ void springClean()
     {
         deleteRegion(storage::REGION_1);
         deleteRegion(storage::REGION_2);
+        deleteRegion(storage::REGION_3);
+        deleteRegion(storage::REGION_4);
         removeLocks();
     }
 }
@@ -52,7 +54,10 @@ void springClean()
 bool generateDataStoreOptions(const int argc,
                               const char *argv[],
                               boost::filesystem::path &base_path,
-                              int &max_wait)
+                              int &max_wait,
+                              bool &write_image,
+                              bool &only_metric,
+                              bool &use_huge_pages)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -66,7 +71,25 @@ bool generateDataStoreOptions(const int argc,
     config_options.add_options()("max-wait",
                                  boost::program_options::value<int>(&max_wait)->default_value(-1),
                                  "Maximum number of seconds to wait on a running data update "
-                                 "before aquiring the lock by force.");
+                                 "before aquiring the lock by force.")(
+        "image",
+        boost::program_options::value<bool>(&write_image)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Write the data into a <base>.osrm.image file for osrm-routed --mmap instead of "
+        "loading it into shared memory")(
+        "only-metric",
+        boost::program_options::value<bool>(&only_metric)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Only load the weights, durations and graphs changed by a traffic update into shared "
+        "memory, all other data is kept from the dataset that is already loaded")(
+        "huge-pages",
+        boost::program_options::value<bool>(&use_huge_pages)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Back the shared memory region with transparent huge pages, requires shmem_enabled "
+        "to be advise in /sys/kernel/mm/transparent_hugepage");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -158,7 +181,11 @@ int main(const int argc, const char *argv[]) try
 
     boost::filesystem::path base_path;
     int max_wait = -1;
-    if (!generateDataStoreOptions(argc, argv, base_path, max_wait))
+    bool write_image = false;
+    bool only_metric = false;
+    bool use_huge_pages = false;
+    if (!generateDataStoreOptions(
+            argc, argv, base_path, max_wait, write_image, only_metric, use_huge_pages))
     {
         return EXIT_SUCCESS;
     }
@@ -168,9 +195,15 @@ int main(const int argc, const char *argv[]) try
         util::Log(logERROR) << "Config contains invalid file paths. Exiting!";
         return EXIT_FAILURE;
     }
+    const auto image_path = config.dataset_image_path;
     storage::Storage storage(std::move(config));
 
-    return storage.Run(max_wait);
+    if (write_image)
+    {
+        storage.WriteImage(image_path);
+        return EXIT_SUCCESS;
+    }
+    return storage.Run(max_wait, only_metric, use_huge_pages);
 }
 catch (const std::bad_alloc &e)
 {
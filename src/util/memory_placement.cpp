@@ -0,0 +1,230 @@
+#include "util/memory_placement.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/log.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace osrm
+{
+namespace util
+{
+
+namespace
+{
+#ifdef __linux__
+const constexpr std::size_t DEFAULT_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+std::size_t getHugePageSize()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line))
+    {
+        // Hugepagesize:       2048 kB
+        if (boost::starts_with(line, "Hugepagesize:"))
+        {
+            return std::stoul(line.substr(std::strlen("Hugepagesize:"))) * 1024;
+        }
+    }
+    return DEFAULT_HUGE_PAGE_SIZE;
+}
+
+std::size_t roundUp(const std::size_t size, const std::size_t alignment)
+{
+    return std::max<std::size_t>(1, (size + alignment - 1) / alignment) * alignment;
+}
+
+// Parses lists like "0-7,16-23" of the sysfs cpulist and node online files
+std::vector<unsigned> parseList(const std::string &list)
+{
+    std::vector<unsigned> values;
+    std::size_t position = 0;
+    while (position < list.size())
+    {
+        auto end = list.find(',', position);
+        if (end == std::string::npos)
+            end = list.size();
+        const auto range = list.substr(position, end - position);
+        const auto dash = range.find('-');
+        const auto first = std::stoul(range.substr(0, dash));
+        const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+        for (auto value = first; value <= last; ++value)
+            values.push_back(value);
+        position = end + 1;
+    }
+    return values;
+}
+
+// CPUs of every NUMA node that has CPUs. The nodes are numbered consecutively in the order of
+// their kernel ids, which may have gaps.
+std::vector<std::vector<unsigned>> readTopology()
+{
+    std::vector<std::vector<unsigned>> topology;
+
+    std::ifstream online("/sys/devices/system/node/online");
+    std::string node_list;
+    if (!online || !std::getline(online, node_list))
+        return topology;
+
+    for (const auto node : parseList(node_list))
+    {
+        std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) +
+                              "/cpulist");
+        std::string list;
+        // memory only nodes have an empty cpulist, threads can not be bound to them
+        if (!cpulist || !std::getline(cpulist, list) || list.empty())
+            continue;
+        topology.push_back(parseList(list));
+    }
+    return topology;
+}
+
+const std::vector<std::vector<unsigned>> &getTopology()
+{
+    static const auto topology = readTopology();
+    return topology;
+}
+#endif
+}
+
+void PlacedMemoryDeleter::operator()(char *memory) const
+{
+#ifdef __linux__
+    if (mapped_size > 0)
+    {
+        ::munmap(memory, mapped_size);
+        return;
+    }
+#endif
+    delete[] memory;
+}
+
+PlacedMemoryPtr AllocatePlacedMemory(const std::size_t size, const bool use_huge_pages)
+{
+#ifdef __linux__
+    if (use_huge_pages)
+    {
+        const auto huge_page_size = getHugePageSize();
+        const auto mapped_size = roundUp(size, huge_page_size);
+        void *memory = ::mmap(nullptr,
+                              mapped_size,
+                              PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE,
+                              -1,
+                              0);
+        if (memory != MAP_FAILED)
+        {
+            util::Log() << "Allocated " << mapped_size / huge_page_size << " huge pages of "
+                        << huge_page_size / 1024 << " kB";
+            return PlacedMemoryPtr(static_cast<char *>(memory), PlacedMemoryDeleter{mapped_size});
+        }
+
+        util::Log(logWARNING) << "Could not allocate " << mapped_size / huge_page_size
+                              << " huge pages (" << std::strerror(errno)
+                              << "), check vm.nr_hugepages. Using transparent huge pages.";
+    }
+
+    const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto mapped_size = roundUp(size, page_size);
+    void *memory =
+        ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        throw util::exception("Could not allocate " + std::to_string(mapped_size) +
+                              " bytes: " + std::strerror(errno) + SOURCE_REF);
+    }
+    PlacedMemoryPtr placed(static_cast<char *>(memory), PlacedMemoryDeleter{mapped_size});
+
+    if (use_huge_pages && !AdviseHugePages(memory, mapped_size))
+    {
+        util::Log(logWARNING) << "Transparent huge pages are not available: "
+                              << std::strerror(errno);
+    }
+
+    // fault in every page now so they are placed on the node of the calling thread
+    volatile char *pages = placed.get();
+    for (std::size_t offset = 0; offset < mapped_size; offset += page_size)
+        pages[offset] = 0;
+
+    return placed;
+#else
+    (void)use_huge_pages;
+    return PlacedMemoryPtr(new char[size](), PlacedMemoryDeleter{0});
+#endif
+}
+
+bool AdviseHugePages(void *address, const std::size_t size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    return ::madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+    (void)address;
+    (void)size;
+    return false;
+#endif
+}
+
+namespace numa
+{
+
+unsigned GetNumberOfNodes()
+{
+#ifdef __linux__
+    return std::max<unsigned>(1, getTopology().size());
+#else
+    return 1;
+#endif
+}
+
+unsigned GetCurrentNode()
+{
+#ifdef __linux__
+    const auto cpu = ::sched_getcpu();
+    if (cpu < 0)
+        return 0;
+
+    const auto &topology = getTopology();
+    for (unsigned node = 0; node < topology.size(); ++node)
+    {
+        const auto &cpus = topology[node];
+        if (std::find(cpus.begin(), cpus.end(), static_cast<unsigned>(cpu)) != cpus.end())
+            return node;
+    }
+#endif
+    return 0;
+}
+
+bool BindCurrentThreadToNode(const unsigned node)
+{
+#ifdef __linux__
+    const auto &topology = getTopology();
+    if (node >= topology.size())
+        return false;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const auto cpu : topology[node])
+        CPU_SET(cpu, &cpus);
+    return ::sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+}
+}
+}
@@ -25,6 +25,7 @@ auto makeGraph(const MultiLevelPartition &mlp, const std::vector<MockEdge> &mock
     struct EdgeData
     {
         EdgeWeight weight;
+        EdgeWeight duration;
         bool forward;
         bool backward;
     };
@@ -34,8 +35,8 @@ auto makeGraph(const MultiLevelPartition &mlp, const std::vector<MockEdge> &mock
     for (const auto &m : mock_edges)
     {
         max_id = std::max<std::size_t>(max_id, std::max(m.start, m.target));
-        edges.push_back(Edge{m.start, m.target, m.weight, true, false});
-        edges.push_back(Edge{m.target, m.start, m.weight, false, true});
+        edges.push_back(Edge{m.start, m.target, m.weight, 2 * m.weight, true, false});
+        edges.push_back(Edge{m.target, m.start, m.weight, 2 * m.weight, false, true});
     }
     std::sort(edges.begin(), edges.end());
     return partition::MultiLevelGraph<EdgeData, osrm::storage::Ownership::Container>(
@@ -97,6 +98,14 @@ BOOST_AUTO_TEST_CASE(two_level_test)
     // check column destination -> source
     CHECK_EQUAL_RANGE(cell_1_1.GetInWeight(2), 0, 1);
     CHECK_EQUAL_RANGE(cell_1_1.GetInWeight(3), 1, 0);
+
+    // durations are accumulated along the minimal weight paths
+    CHECK_EQUAL_RANGE(cell_1_0.GetOutDuration(0), 2);
+    CHECK_EQUAL_RANGE(cell_1_0.GetInDuration(1), 2);
+    CHECK_EQUAL_RANGE(cell_1_1.GetOutDuration(2), 0, 2);
+    CHECK_EQUAL_RANGE(cell_1_1.GetOutDuration(3), 2, 0);
+    CHECK_EQUAL_RANGE(cell_1_1.GetInDuration(2), 0, 2);
+    CHECK_EQUAL_RANGE(cell_1_1.GetInDuration(3), 2, 0);
 }
 
 BOOST_AUTO_TEST_CASE(four_levels_test)
@@ -252,6 +261,8 @@ BOOST_AUTO_TEST_CASE(four_levels_test)
     CHECK_EQUAL_RANGE(cell_2_1.GetInWeight(8), 3, INVALID_EDGE_WEIGHT);
     CHECK_EQUAL_RANGE(cell_2_1.GetInWeight(9), 0, INVALID_EDGE_WEIGHT);
     CHECK_EQUAL_RANGE(cell_2_1.GetInWeight(12), INVALID_EDGE_WEIGHT, 10);
+    CHECK_EQUAL_RANGE(cell_2_1.GetOutDuration(9), 6, 0, MAXIMAL_EDGE_DURATION);
+    CHECK_EQUAL_RANGE(cell_2_1.GetInDuration(12), MAXIMAL_EDGE_DURATION, 20);
 
     CellStorage storage_rec(mlp, graph);
     customizer.Customize(graph, storage_rec);
@@ -263,4 +274,53 @@ BOOST_AUTO_TEST_CASE(four_levels_test)
     CHECK_EQUAL_COLLECTIONS(cell_2_1.GetInWeight(12), storage_rec.GetCell(2, 1).GetInWeight(12));
 }
 
+BOOST_AUTO_TEST_CASE(incremental_customization_test)
+{
+    // node:                0  1  2  3  4  5  6  7  8  9 10 11 12 13 14 15
+    std::vector<CellID> l1{{0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3}};
+    std::vector<CellID> l2{{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1}};
+    std::vector<CellID> l3{{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
+    MultiLevelPartition mlp{{l1, l2, l3}, {4, 2, 1}};
+
+    std::vector<MockEdge> edges = {{0, 1, 1},   {0, 2, 1},   {3, 1, 1},  {3, 2, 1},  {4, 5, 1},
+                                   {4, 6, 1},   {4, 7, 1},   {5, 4, 1},  {5, 6, 1},  {5, 7, 1},
+                                   {6, 4, 1},   {6, 5, 1},   {6, 7, 1},  {7, 4, 1},  {7, 5, 1},
+                                   {7, 6, 1},   {9, 11, 1},  {10, 8, 1}, {11, 10, 1}, {13, 12, 10},
+                                   {15, 14, 1}, {2, 4, 1},   {5, 12, 1}, {8, 3, 1},  {9, 3, 1},
+                                   {12, 5, 1},  {13, 7, 1},  {14, 9, 1}, {14, 11, 1}};
+
+    auto graph = makeGraph(mlp, edges);
+    CellStorage storage(mlp, graph);
+    CellCustomizer customizer(mlp);
+    customizer.Customize(graph, storage);
+
+    CHECK_EQUAL_RANGE(storage.GetCell(1, 2).GetOutWeight(9), 3, 1);
+
+    // only the edge 9 -> 11 in cells (2, 1, 0) changes
+    edges[16].weight = 5;
+    auto updated_graph = makeGraph(mlp, edges);
+    customizer.Customize(updated_graph, storage, {9, 11});
+
+    CHECK_EQUAL_RANGE(storage.GetCell(1, 2).GetOutWeight(9), 7, 5);
+    CHECK_EQUAL_RANGE(storage.GetCell(1, 2).GetOutDuration(9), 14, 10);
+
+    CellStorage storage_full(mlp, updated_graph);
+    customizer.Customize(updated_graph, storage_full);
+
+    for (LevelID level = 1; level < mlp.GetNumberOfLevels(); ++level)
+    {
+        for (CellID id = 0; id < mlp.GetNumberOfCells(level); ++id)
+        {
+            const auto cell = storage.GetCell(level, id);
+            const auto cell_full = storage_full.GetCell(level, id);
+            for (auto source : cell.GetSourceNodes())
+            {
+                CHECK_EQUAL_COLLECTIONS(cell.GetOutWeight(source), cell_full.GetOutWeight(source));
+                CHECK_EQUAL_COLLECTIONS(cell.GetOutDuration(source),
+                                        cell_full.GetOutDuration(source));
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,51 @@
+#include "extractor/extraction_containers.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+
+BOOST_AUTO_TEST_SUITE(extraction_containers)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+BOOST_AUTO_TEST_CASE(in_memory_within_budget)
+{
+    ExtractionContainers containers(1024 * 1024);
+    BOOST_CHECK(containers.IsInMemory());
+
+    for (std::uint64_t node = 0; node < 1000; ++node)
+        containers.used_node_id_list.push_back(OSMNodeID{node});
+    containers.CheckMemoryBudget();
+
+    BOOST_CHECK(containers.IsInMemory());
+    BOOST_CHECK_EQUAL(containers.used_node_id_list.Internal().size(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(external_memory_over_budget)
+{
+    ExtractionContainers containers(1024);
+
+    for (std::uint64_t node = 0; node < 1000; ++node)
+        containers.used_node_id_list.push_back(OSMNodeID{node});
+    containers.CheckMemoryBudget();
+
+    BOOST_CHECK(!containers.IsInMemory());
+    BOOST_CHECK(containers.name_offsets.IsExternal());
+    BOOST_CHECK_EQUAL(containers.used_node_id_list.size(), 1000);
+    BOOST_CHECK_EQUAL(static_cast<std::uint64_t>(containers.used_node_id_list.External()[999]),
+                      999);
+
+    // the name offsets start with the sentinels of the empty strings
+    BOOST_CHECK_EQUAL(containers.name_offsets.size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(external_memory_without_budget)
+{
+    ExtractionContainers containers;
+    BOOST_CHECK(!containers.IsInMemory());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,5 +1,6 @@
 #include "extractor/graph_compressor.hpp"
 #include "extractor/compressed_edge_container.hpp"
+#include "extractor/restriction.hpp"
 #include "extractor/restriction_map.hpp"
 #include "util/node_based_graph.hpp"
 #include "util/typedefs.hpp"
@@ -213,4 +214,187 @@ BOOST_AUTO_TEST_CASE(direction_changes)
     BOOST_CHECK(graph.FindEdge(1, 2) != SPECIAL_EDGEID);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_long_road_test)
+{
+    //
+    // 0---1---2---3---4
+    //
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights;
+    RestrictionMap map;
+    CompressedEdgeContainer container;
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 2),
+                                    MakeUnitEdge(2, 1),
+                                    MakeUnitEdge(2, 3),
+                                    MakeUnitEdge(3, 2),
+                                    MakeUnitEdge(3, 4),
+                                    MakeUnitEdge(4, 3)};
+    edges[6].data.weight = 2;
+
+    Graph graph(5, edges);
+    compressor.CompressParallel(barrier_nodes, traffic_lights, map, graph, container);
+
+    BOOST_CHECK_EQUAL(graph.FindEdge(0, 1), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.FindEdge(1, 2), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.FindEdge(2, 3), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.FindEdge(3, 4), SPECIAL_EDGEID);
+
+    const auto forward = graph.FindEdge(0, 4);
+    const auto reverse = graph.FindEdge(4, 0);
+    BOOST_REQUIRE(forward != SPECIAL_EDGEID);
+    BOOST_REQUIRE(reverse != SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(forward).weight, 5);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(reverse).weight, 4);
+
+    // same geometry as adding one node after the other
+    const auto &forward_geometry = container.GetBucketReference(forward);
+    BOOST_REQUIRE_EQUAL(forward_geometry.size(), 4);
+    BOOST_CHECK_EQUAL(forward_geometry[0].node_id, 1);
+    BOOST_CHECK_EQUAL(forward_geometry[3].node_id, 4);
+    BOOST_CHECK_EQUAL(forward_geometry[3].weight, 2);
+
+    const auto &reverse_geometry = container.GetBucketReference(reverse);
+    BOOST_REQUIRE_EQUAL(reverse_geometry.size(), 4);
+    BOOST_CHECK_EQUAL(reverse_geometry[0].node_id, 3);
+    BOOST_CHECK_EQUAL(reverse_geometry[3].node_id, 0);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_loop_test)
+{
+    //
+    // 0---1---2
+    // |       |
+    // 5---4---3
+    //
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights;
+    RestrictionMap map;
+    CompressedEdgeContainer container;
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(0, 5),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 2),
+                                    MakeUnitEdge(2, 1),
+                                    MakeUnitEdge(2, 3),
+                                    MakeUnitEdge(3, 2),
+                                    MakeUnitEdge(3, 4),
+                                    MakeUnitEdge(4, 3),
+                                    MakeUnitEdge(4, 5),
+                                    MakeUnitEdge(5, 0),
+                                    MakeUnitEdge(5, 4)};
+
+    Graph graph(6, edges);
+    compressor.CompressParallel(barrier_nodes, traffic_lights, map, graph, container);
+
+    // cut open at node 0, which keeps its neighbours
+    BOOST_CHECK(graph.FindEdge(0, 1) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(0, 5) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(1, 5) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(5, 1) != SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(2), 0);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(3), 0);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(4), 0);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_restriction_test)
+{
+    //
+    // 0---1---2---3---4---5
+    //             |
+    //             6
+    //
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights;
+    CompressedEdgeContainer container;
+
+    // only straight on from 2 over 3 to 4
+    TurnRestriction restriction(NodeID{3});
+    restriction.from.node = 2;
+    restriction.to.node = 4;
+    restriction.flags.is_only = true;
+    RestrictionMap map(std::vector<TurnRestriction>{restriction});
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 2),
+                                    MakeUnitEdge(2, 1),
+                                    MakeUnitEdge(2, 3),
+                                    MakeUnitEdge(3, 2),
+                                    MakeUnitEdge(3, 4),
+                                    MakeUnitEdge(3, 6),
+                                    MakeUnitEdge(4, 3),
+                                    MakeUnitEdge(4, 5),
+                                    MakeUnitEdge(5, 4),
+                                    MakeUnitEdge(6, 3)};
+
+    Graph graph(7, edges);
+    compressor.CompressParallel(barrier_nodes, traffic_lights, map, graph, container);
+
+    BOOST_CHECK(graph.FindEdge(0, 3) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(3, 5) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(3, 6) != SPECIAL_EDGEID);
+
+    // moved to the ends of the compressed edges
+    BOOST_CHECK_EQUAL(map.CheckForEmanatingIsOnlyTurn(2, 3), SPECIAL_NODEID);
+    BOOST_CHECK_EQUAL(map.CheckForEmanatingIsOnlyTurn(0, 3), 5);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_duplicate_chains)
+{
+    //
+    //   1---2
+    //  /     \
+    // 0---5---3
+    //  \     /
+    //   4---6
+    //
+    GraphCompressor compressor;
+
+    std::unordered_set<NodeID> barrier_nodes;
+    std::unordered_set<NodeID> traffic_lights;
+    RestrictionMap map;
+    CompressedEdgeContainer container;
+
+    std::vector<InputEdge> edges = {MakeUnitEdge(0, 1),
+                                    MakeUnitEdge(0, 4),
+                                    MakeUnitEdge(0, 5),
+                                    MakeUnitEdge(1, 0),
+                                    MakeUnitEdge(1, 2),
+                                    MakeUnitEdge(2, 1),
+                                    MakeUnitEdge(2, 3),
+                                    MakeUnitEdge(3, 2),
+                                    MakeUnitEdge(3, 5),
+                                    MakeUnitEdge(3, 6),
+                                    MakeUnitEdge(4, 0),
+                                    MakeUnitEdge(4, 6),
+                                    MakeUnitEdge(5, 0),
+                                    MakeUnitEdge(5, 3),
+                                    MakeUnitEdge(6, 3),
+                                    MakeUnitEdge(6, 4)};
+
+    Graph graph(7, edges);
+    compressor.CompressParallel(barrier_nodes, traffic_lights, map, graph, container);
+
+    // the chain with the smallest first edge becomes 0-3, 0-4-6-3 keeps its last node and
+    // 0-5-3 is too short to be compressed at all
+    BOOST_CHECK(graph.FindEdge(0, 3) != SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(1), 0);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(2), 0);
+    BOOST_CHECK(graph.FindEdge(0, 6) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(6, 3) != SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(4), 0);
+    BOOST_CHECK(graph.FindEdge(0, 5) != SPECIAL_EDGEID);
+    BOOST_CHECK(graph.FindEdge(5, 3) != SPECIAL_EDGEID);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+#include "extractor/parallel_scc.hpp"
+#include "extractor/tarjan_scc.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <tbb/parallel_sort.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(parallel_scc)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+using Graph = util::StaticGraph<void>;
+using Edge = util::static_graph_details::SortableEdgeWithData<void>;
+
+Graph makeGraph(const NodeID number_of_nodes, std::vector<Edge> edges)
+{
+    tbb::parallel_sort(edges.begin(), edges.end());
+    return Graph(number_of_nodes, edges);
+}
+
+Graph makeRandomGraph(const NodeID number_of_nodes, const std::size_t number_of_edges,
+                      const unsigned seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<NodeID> node(0, number_of_nodes - 1);
+
+    std::vector<Edge> edges;
+    for (std::size_t i = 0; i < number_of_edges; ++i)
+    {
+        edges.emplace_back(node(generator), node(generator));
+    }
+    return makeGraph(number_of_nodes, std::move(edges));
+}
+
+// Both must find the same partition with the same component sizes
+void checkSamePartition(const Graph &graph, const std::size_t minimal_split_size)
+{
+    TarjanSCC<Graph> tarjan(graph);
+    tarjan.Run();
+    ParallelSCC<Graph> parallel(graph, minimal_split_size);
+    parallel.Run();
+
+    BOOST_REQUIRE_EQUAL(tarjan.GetNumberOfComponents(), parallel.GetNumberOfComponents());
+    BOOST_CHECK_EQUAL(tarjan.GetSizeOneCount(), parallel.GetSizeOneCount());
+
+    std::unordered_map<unsigned, unsigned> parallel_to_tarjan;
+    unsigned next_id = 0;
+    for (const auto node : util::irange(0u, graph.GetNumberOfNodes()))
+    {
+        const auto parallel_id = parallel.GetComponentID(node);
+        const auto tarjan_id = tarjan.GetComponentID(node);
+        BOOST_REQUIRE_LT(parallel_id, parallel.GetNumberOfComponents());
+
+        // components are numbered by their smallest node
+        if (parallel_to_tarjan.count(parallel_id) == 0)
+        {
+            BOOST_REQUIRE_EQUAL(parallel_id, next_id++);
+            parallel_to_tarjan[parallel_id] = tarjan_id;
+        }
+        BOOST_REQUIRE_EQUAL(parallel_to_tarjan[parallel_id], tarjan_id);
+        BOOST_REQUIRE_EQUAL(parallel.GetComponentSize(parallel_id),
+                            tarjan.GetComponentSize(tarjan_id));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(small_graph)
+{
+    // 0 -> 1 -> 2 -> 0 -> 3 <-> 4, 5 -> 5, 6
+    const auto graph =
+        makeGraph(7, {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {3, 4}, {4, 3}, {5, 5}, {4, 6}});
+
+    for (const std::size_t minimal_split_size : {1, 1024})
+    {
+        ParallelSCC<Graph> scc(graph, minimal_split_size);
+        scc.Run();
+
+        BOOST_CHECK_EQUAL(scc.GetNumberOfComponents(), 4);
+        BOOST_CHECK_EQUAL(scc.GetSizeOneCount(), 2);
+
+        BOOST_CHECK_EQUAL(scc.GetComponentID(0), 0);
+        BOOST_CHECK_EQUAL(scc.GetComponentID(1), 0);
+        BOOST_CHECK_EQUAL(scc.GetComponentID(2), 0);
+        BOOST_CHECK_EQUAL(scc.GetComponentID(3), 1);
+        BOOST_CHECK_EQUAL(scc.GetComponentID(4), 1);
+        BOOST_CHECK_EQUAL(scc.GetComponentID(5), 2);
+        BOOST_CHECK_EQUAL(scc.GetComponentID(6), 3);
+
+        BOOST_CHECK_EQUAL(scc.GetComponentSize(0), 3);
+        BOOST_CHECK_EQUAL(scc.GetComponentSize(1), 2);
+        BOOST_CHECK_EQUAL(scc.GetComponentSize(2), 1);
+        BOOST_CHECK_EQUAL(scc.GetComponentSize(3), 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(random_graphs_match_tarjan)
+{
+    for (const unsigned seed : {1, 2, 3, 4, 5})
+    {
+        // sparse graphs have a giant component and many small ones around it
+        const auto graph = makeRandomGraph(2000, 2400, seed);
+        for (const std::size_t minimal_split_size : {1, 16, 64 * 1024})
+        {
+            checkSamePartition(graph, minimal_split_size);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(large_frontiers_match_tarjan)
+{
+    const auto graph = makeRandomGraph(50000, 100000, 42);
+    checkSamePartition(graph, 1);
+    checkSamePartition(graph, 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,148 @@
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "coordinates.hpp"
+#include "fixture.hpp"
+
+#include "osrm/batch_route_parameters.hpp"
+#include "osrm/route_parameters.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/status.hpp"
+
+#include "util/json_renderer.hpp"
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(batch_route)
+
+BOOST_AUTO_TEST_CASE(test_batch_route_matches_route)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    config.use_shared_memory = false;
+    config.max_batch_threads = 4;
+    OSRM osrm{config};
+
+    const auto big_component = get_locations_in_big_component();
+    const auto small_component = get_locations_in_small_component();
+
+    BatchRouteParameters params;
+    params.coordinates = {big_component.at(0),
+                          big_component.at(1),
+                          big_component.at(2),
+                          big_component.at(0),
+                          small_component.at(0),
+                          big_component.at(1),
+                          get_dummy_location(),
+                          small_component.at(2)};
+
+    json::Object result;
+    const auto rc = osrm.BatchRoute(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+    BOOST_CHECK_EQUAL(result.values.at("code").get<json::String>().value, "Ok");
+    BOOST_CHECK(result.values.find("geometries") == result.values.end());
+
+    const auto &durations = result.values.at("durations").get<json::Array>().values;
+    const auto &distances = result.values.at("distances").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(durations.size(), params.coordinates.size() / 2);
+    BOOST_REQUIRE_EQUAL(distances.size(), params.coordinates.size() / 2);
+
+    for (std::size_t index = 0; index < durations.size(); ++index)
+    {
+        RouteParameters route_params;
+        route_params.overview = RouteParameters::OverviewType::False;
+        route_params.coordinates = {params.coordinates[2 * index],
+                                    params.coordinates[2 * index + 1]};
+
+        json::Object route_result;
+        const auto route_rc = osrm.Route(route_params, route_result);
+        if (route_rc != Status::Ok)
+        {
+            BOOST_CHECK(durations[index].is<json::Null>());
+            BOOST_CHECK(distances[index].is<json::Null>());
+            continue;
+        }
+
+        const auto &route = route_result.values.at("routes")
+                                .get<json::Array>()
+                                .values.at(0)
+                                .get<json::Object>();
+        BOOST_CHECK_EQUAL(durations[index].get<json::Number>().value,
+                          route.values.at("duration").get<json::Number>().value);
+        BOOST_CHECK_EQUAL(distances[index].get<json::Number>().value,
+                          route.values.at("distance").get<json::Number>().value);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_route_geometries)
+{
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    using namespace osrm;
+
+    const auto big_component = get_locations_in_big_component();
+
+    BatchRouteParameters params;
+    params.overview = RouteParameters::OverviewType::Full;
+    params.geometries = RouteParameters::GeometriesType::GeoJSON;
+    params.coordinates = {
+        big_component.at(0), big_component.at(1), big_component.at(1), big_component.at(2)};
+
+    json::Object result;
+    const auto rc = osrm.BatchRoute(params, result);
+    BOOST_CHECK(rc == Status::Ok);
+
+    const auto &geometries = result.values.at("geometries").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(geometries.size(), 2);
+    for (const auto &geometry : geometries)
+    {
+        const auto &coordinates =
+            geometry.get<json::Object>().values.at("coordinates").get<json::Array>().values;
+        BOOST_CHECK(coordinates.size() >= 2);
+    }
+
+    std::vector<char> streamed;
+    BOOST_CHECK(osrm.BatchRouteJSON(params, streamed) == Status::Ok);
+    const std::string streamed_string(streamed.begin(), streamed.end());
+
+    // member order differs between the outputs, so compare the rendered members one by one
+    for (const auto member : {"code", "durations", "distances", "geometries"})
+    {
+        json::Object single_member;
+        single_member.values[member] = result.values.at(member);
+        std::vector<char> rendered;
+        json::render(rendered, single_member);
+        const std::string rendered_member(rendered.begin() + 1, rendered.end() - 1);
+        BOOST_CHECK_MESSAGE(streamed_string.find(rendered_member) != std::string::npos,
+                            rendered_member << " not found in " << streamed_string);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_route_too_big)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    config.use_shared_memory = false;
+    config.max_routes_batch = 1;
+    OSRM osrm{config};
+
+    BatchRouteParameters params;
+    for (int i = 0; i < 4; ++i)
+        params.coordinates.push_back(get_dummy_location());
+
+    json::Object result;
+    const auto rc = osrm.BatchRoute(params, result);
+    BOOST_CHECK(rc == Status::Error);
+    BOOST_CHECK_EQUAL(result.values.at("code").get<json::String>().value, "TooBig");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,16 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/routing_base_ch.hpp"
+#include "engine/search_engine_data.hpp"
+#include "storage/storage_config.hpp"
+
+#include <memory>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(match)
 
 BOOST_AUTO_TEST_CASE(test_match)
@@ -64,4 +74,65 @@ BOOST_AUTO_TEST_CASE(test_match)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_match_batched_transitions)
+{
+    using namespace osrm;
+    using namespace osrm::engine;
+    using Algorithm = routing_algorithms::ch::Algorithm;
+
+    const storage::StorageConfig config(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    const datafacade::ContiguousInternalMemoryDataFacade<Algorithm> facade(
+        std::make_shared<datafacade::ProcessMemoryAllocator>(config));
+    SearchEngineData<Algorithm> engine_working_data;
+
+    const auto get_candidates = [&facade](const Location location) {
+        std::vector<PhantomNode> phantoms;
+        for (const auto &candidate : facade.NearestPhantomNodesInRange(location, 50))
+        {
+            phantoms.push_back(candidate.phantom_node);
+        }
+        return phantoms;
+    };
+
+    // The matchings only stay the same if the transitions computed by one search per candidate
+    // are the same as the ones of the pairwise searches, including the entries that are
+    // unreachable within the upper bound
+    const auto trace = get_locations_in_big_component();
+    for (const EdgeWeight weight_upper_bound : {100, 1000, INVALID_EDGE_WEIGHT})
+    {
+        for (std::size_t index = 0; index + 1 < trace.size(); ++index)
+        {
+            for (const auto &pair : {std::make_pair(trace[index], trace[index + 1]),
+                                     std::make_pair(trace[index + 1], trace[index])})
+            {
+                const auto sources = get_candidates(pair.first);
+                const auto targets = get_candidates(pair.second);
+                BOOST_REQUIRE(!sources.empty());
+                BOOST_REQUIRE(!targets.empty());
+
+                const auto batched = routing_algorithms::ch::getNetworkDistances(
+                    engine_working_data, facade, sources, targets, weight_upper_bound);
+                BOOST_REQUIRE_EQUAL(batched.size(), sources.size() * targets.size());
+
+                engine_working_data.InitializeOrClearFirstThreadLocalStorage(
+                    facade.GetNumberOfNodes());
+                for (std::size_t row = 0; row < sources.size(); ++row)
+                {
+                    for (std::size_t column = 0; column < targets.size(); ++column)
+                    {
+                        const auto pairwise = routing_algorithms::ch::getNetworkDistance(
+                            facade,
+                            *engine_working_data.forward_heap_1,
+                            *engine_working_data.reverse_heap_1,
+                            sources[row],
+                            targets[column],
+                            weight_upper_bound);
+                        BOOST_CHECK_EQUAL(batched[row * targets.size() + column], pairwise);
+                    }
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
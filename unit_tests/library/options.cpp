@@ -6,6 +6,48 @@
 #include "fixture.hpp"
 
 #include "osrm/osrm.hpp"
+#include "osrm/route_parameters.hpp"
+
+#include "engine/datafacade/contiguous_internalmem_datafacade.hpp"
+#include "engine/datafacade/process_memory_allocator.hpp"
+#include "storage/storage.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <memory>
+
+namespace
+{
+// Serves the updatable blocks from a separate memory block, like the shared memory allocator
+// does after osrm-datastore --only-metric
+class MetricUpdateAllocator final : public osrm::engine::datafacade::ContiguousBlockAllocator
+{
+  public:
+    MetricUpdateAllocator(const osrm::storage::StorageConfig &config) : base(config)
+    {
+        using namespace osrm::storage;
+        Storage storage(config);
+        storage.PopulateLayout(updatable_layout);
+        for (auto i = 0; i < DataLayout::NUM_BLOCKS; ++i)
+        {
+            if (!isUpdatableBlock(static_cast<DataLayout::BlockID>(i)))
+                updatable_layout.num_entries[i] = 0;
+        }
+        updatable_memory = std::make_unique<char[]>(updatable_layout.GetSizeOfLayout());
+        storage.PopulateData(updatable_layout, updatable_memory.get(), true);
+    }
+
+    osrm::storage::DataLayout &GetLayout() override { return base.GetLayout(); }
+    char *GetMemory() override { return base.GetMemory(); }
+    osrm::storage::DataLayout &GetUpdatableLayout() override { return updatable_layout; }
+    char *GetUpdatableMemory() override { return updatable_memory.get(); }
+
+  private:
+    osrm::engine::datafacade::ProcessMemoryAllocator base;
+    osrm::storage::DataLayout updatable_layout;
+    std::unique_ptr<char[]> updatable_memory;
+};
+}
 
 BOOST_AUTO_TEST_SUITE(options)
 
@@ -39,4 +81,115 @@ BOOST_AUTO_TEST_CASE(test_mld)
     OSRM osrm{config};
 }
 
+BOOST_AUTO_TEST_CASE(test_mmap)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    config.storage_config.dataset_image_path =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    config.algorithm = EngineConfig::Algorithm::CH;
+
+    storage::Storage(config.storage_config).WriteImage(config.storage_config.dataset_image_path);
+
+    OSRM loaded_osrm{config};
+    config.use_mmap = true;
+    OSRM mapped_osrm{config};
+
+    RouteParameters params;
+    params.coordinates = get_locations_in_big_component();
+
+    json::Object loaded_result;
+    json::Object mapped_result;
+    BOOST_CHECK(loaded_osrm.Route(params, loaded_result) == Status::Ok);
+    BOOST_CHECK(mapped_osrm.Route(params, mapped_result) == Status::Ok);
+    CHECK_EQUAL_JSON(loaded_result, mapped_result);
+
+    boost::filesystem::remove(config.storage_config.dataset_image_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_huge_pages_and_numa_replicas)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    config.algorithm = EngineConfig::Algorithm::CH;
+
+    OSRM regular_osrm{config};
+    // falls back to transparent huge pages if none are reserved
+    config.use_huge_pages = true;
+    config.use_numa_replicas = true;
+    OSRM placed_osrm{config};
+
+    RouteParameters params;
+    params.coordinates = get_locations_in_big_component();
+
+    json::Object regular_result;
+    json::Object placed_result;
+    BOOST_CHECK(regular_osrm.Route(params, regular_result) == Status::Ok);
+    BOOST_CHECK(placed_osrm.Route(params, placed_result) == Status::Ok);
+    CHECK_EQUAL_JSON(regular_result, placed_result);
+
+    // only datasets loaded into process memory can be placed
+    config.use_mmap = true;
+    BOOST_CHECK(!config.IsValid());
+}
+
+BOOST_AUTO_TEST_CASE(test_only_metric)
+{
+    using namespace osrm;
+    using FacadeT =
+        engine::datafacade::ContiguousInternalMemoryDataFacade<engine::datafacade::MLD>;
+    const storage::StorageConfig config(OSRM_TEST_DATA_DIR "/mld/monaco.osrm");
+
+    const FacadeT loaded(std::make_shared<engine::datafacade::ProcessMemoryAllocator>(config));
+    const FacadeT updated(std::make_shared<MetricUpdateAllocator>(config));
+
+    BOOST_CHECK_EQUAL(loaded.GetNumberOfNodes(), updated.GetNumberOfNodes());
+    BOOST_REQUIRE_EQUAL(loaded.GetNumberOfEdges(), updated.GetNumberOfEdges());
+    BOOST_CHECK_EQUAL(loaded.GetCheckSum(), updated.GetCheckSum());
+    for (EdgeID edge = 0; edge < loaded.GetNumberOfEdges(); ++edge)
+    {
+        BOOST_CHECK_EQUAL(loaded.GetTarget(edge), updated.GetTarget(edge));
+        BOOST_CHECK_EQUAL(loaded.GetEdgeData(edge).weight, updated.GetEdgeData(edge).weight);
+    }
+
+    const auto loaded_weights = loaded.GetUncompressedForwardWeights(0);
+    const auto updated_weights = updated.GetUncompressedForwardWeights(0);
+    BOOST_CHECK_EQUAL_COLLECTIONS(loaded_weights.begin(),
+                                  loaded_weights.end(),
+                                  updated_weights.begin(),
+                                  updated_weights.end());
+    BOOST_CHECK_EQUAL(loaded.GetWeightPenaltyForEdgeID(0), updated.GetWeightPenaltyForEdgeID(0));
+}
+
+BOOST_AUTO_TEST_CASE(test_reload)
+{
+    using namespace osrm;
+    EngineConfig config;
+    config.use_shared_memory = false;
+    config.storage_config = storage::StorageConfig(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+    config.algorithm = EngineConfig::Algorithm::CH;
+
+    OSRM osrm{config};
+
+    RouteParameters params;
+    params.coordinates = get_locations_in_big_component();
+
+    json::Object before_result;
+    BOOST_CHECK(osrm.Route(params, before_result) == Status::Ok);
+
+    BOOST_CHECK(osrm.Reload());
+
+    // queries are answered from either dataset while the reload runs
+    for (int i = 0; i < 10; ++i)
+    {
+        json::Object during_result;
+        BOOST_CHECK(osrm.Route(params, during_result) == Status::Ok);
+        CHECK_EQUAL_JSON(before_result, during_result);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
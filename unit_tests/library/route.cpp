@@ -13,6 +13,16 @@
 #include "osrm/route_parameters.hpp"
 #include "osrm/status.hpp"
 
+#include "util/coordinate_calculation.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(route)
 
 BOOST_AUTO_TEST_CASE(test_route_same_coordinates_fixture)
@@ -446,4 +456,190 @@ BOOST_AUTO_TEST_CASE(test_manual_setting_of_annotations_property)
     BOOST_CHECK_EQUAL(annotations.size(), 5);
 }
 
+// The parts of a route the alternative path filters work on
+struct RouteSegments
+{
+    double weight;
+    std::vector<osrm::util::Coordinate> coordinates;
+    std::vector<double> weights;
+    std::vector<std::pair<double, double>> nodes;
+};
+
+RouteSegments getRouteSegments(const osrm::json::Value &route_value)
+{
+    using namespace osrm;
+
+    const auto &route = route_value.get<json::Object>();
+    RouteSegments segments;
+    segments.weight = route.values.at("weight").get<json::Number>().value;
+
+    const auto &geometry = route.values.at("geometry").get<json::Object>();
+    for (const auto &location : geometry.values.at("coordinates").get<json::Array>().values)
+    {
+        const auto &lon_lat = location.get<json::Array>().values;
+        segments.coordinates.emplace_back(
+            util::FloatLongitude{lon_lat[0].get<json::Number>().value},
+            util::FloatLatitude{lon_lat[1].get<json::Number>().value});
+    }
+
+    const auto &legs = route.values.at("legs").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(legs.size(), 1);
+    const auto &annotation =
+        legs[0].get<json::Object>().values.at("annotation").get<json::Object>();
+    for (const auto &weight : annotation.values.at("weight").get<json::Array>().values)
+    {
+        segments.weights.push_back(weight.get<json::Number>().value);
+    }
+    const auto &nodes = annotation.values.at("nodes").get<json::Array>().values;
+    for (std::size_t index = 0; index + 1 < nodes.size(); ++index)
+    {
+        segments.nodes.emplace_back(nodes[index].get<json::Number>().value,
+                                    nodes[index + 1].get<json::Number>().value);
+    }
+
+    BOOST_REQUIRE_EQUAL(segments.weights.size(), segments.nodes.size());
+    BOOST_REQUIRE_EQUAL(segments.coordinates.size(), segments.weights.size() + 1);
+    return segments;
+}
+
+// Weight of the shortest path between the middles of two segments of the given route
+double getShortestPathWeight(osrm::OSRM &osrm,
+                             const RouteSegments &route,
+                             const std::size_t first_segment,
+                             const std::size_t last_segment)
+{
+    using namespace osrm;
+
+    RouteParameters params;
+    for (const auto segment : {first_segment, last_segment})
+    {
+        const auto &from = route.coordinates[segment];
+        const auto &to = route.coordinates[segment + 1];
+        params.coordinates.push_back(
+            util::coordinate_calculation::interpolateLinear(0.5, from, to));
+        // the path has to pass the segment in the same direction as the route
+        const auto bearing = util::coordinate_calculation::bearing(from, to);
+        params.bearings.push_back(
+            engine::Bearing{static_cast<short>(static_cast<int>(std::round(bearing)) % 360), 10});
+    }
+
+    json::Object result;
+    const auto rc = osrm.Route(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+    const auto &routes = result.values.at("routes").get<json::Array>().values;
+    return routes.front().get<json::Object>().values.at("weight").get<json::Number>().value;
+}
+
+// Checks the sharing, stretch and local optimality (T-test) of all alternatives found between
+// the locations. Returns the number of found alternatives.
+std::size_t checkAlternatives(osrm::OSRM &osrm, const Locations &locations)
+{
+    using namespace osrm;
+
+    // epsilon, gamma and alpha of the via path search
+    const double max_length = 1.15;
+    const double max_sharing = 0.75;
+    const double max_stretch = 1.10;
+    // the response weights are rounded to a tenth
+    const double tolerance = 1.;
+
+    std::size_t number_of_alternatives = 0;
+    for (const auto &source : locations)
+    {
+        for (const auto &target : locations)
+        {
+            if (source == target)
+                continue;
+
+            RouteParameters params;
+            params.alternatives = true;
+            params.geometries = RouteParameters::GeometriesType::GeoJSON;
+            params.overview = RouteParameters::OverviewType::Full;
+            params.annotations_type = RouteParameters::AnnotationsType::Weight |
+                                      RouteParameters::AnnotationsType::Nodes;
+            params.coordinates = {source, target};
+
+            json::Object result;
+            const auto rc = osrm.Route(params, result);
+            BOOST_REQUIRE(rc == Status::Ok);
+
+            const auto &routes = result.values.at("routes").get<json::Array>().values;
+            BOOST_REQUIRE_GE(routes.size(), 1);
+            BOOST_REQUIRE_LE(routes.size(), 2);
+            if (routes.size() == 1)
+                continue;
+            ++number_of_alternatives;
+
+            const auto shortest = getRouteSegments(routes[0]);
+            const auto alternative = getRouteSegments(routes[1]);
+            BOOST_REQUIRE_GE(shortest.nodes.size(), 2);
+            BOOST_CHECK_LE(shortest.weight, alternative.weight);
+            BOOST_CHECK_LT(alternative.weight, max_length * shortest.weight + tolerance);
+
+            // the segments at the waypoints are not part of the unpacked paths
+            const std::set<std::pair<double, double>> shortest_nodes(shortest.nodes.begin() + 1,
+                                                                     shortest.nodes.end() - 1);
+            double sharing = 0;
+            for (std::size_t index = 1; index + 1 < alternative.nodes.size(); ++index)
+            {
+                if (shortest_nodes.count(alternative.nodes[index]) > 0)
+                    sharing += alternative.weights[index];
+            }
+            BOOST_CHECK_LE(sharing, max_sharing * shortest.weight + tolerance);
+            BOOST_CHECK_LT(alternative.weight - sharing,
+                           max_stretch * (shortest.weight - sharing) + tolerance);
+
+            // The via path is made of two shortest paths that meet at the via node. The T-test
+            // makes the part of epsilon times the shortest weight around the via node a shortest
+            // path, so every part of at most that weight is one. The window around the middle
+            // only takes half of it, the annotations do not contain all turn penalties.
+            const double middle = alternative.weight / 2;
+            const double half_window = (max_length - 1) * shortest.weight / 4;
+            std::size_t first_segment = alternative.weights.size();
+            std::size_t last_segment = 0;
+            double segment_begin = 0;
+            for (std::size_t index = 0; index < alternative.weights.size(); ++index)
+            {
+                const double segment_end = segment_begin + alternative.weights[index];
+                if (segment_begin >= middle - half_window && first_segment > index)
+                    first_segment = index;
+                if (segment_end <= middle + half_window)
+                    last_segment = index;
+                segment_begin = segment_end;
+            }
+            if (first_segment >= last_segment)
+                continue;
+
+            double window_weight =
+                (alternative.weights[first_segment] + alternative.weights[last_segment]) / 2;
+            for (auto index = first_segment + 1; index < last_segment; ++index)
+                window_weight += alternative.weights[index];
+            BOOST_CHECK_GE(getShortestPathWeight(osrm, alternative, first_segment, last_segment),
+                           window_weight - tolerance);
+        }
+    }
+    return number_of_alternatives;
+}
+
+BOOST_AUTO_TEST_CASE(alternatives_pass_sharing_stretch_and_t_test)
+{
+    using namespace osrm;
+
+    auto locations = get_locations_in_big_component();
+    locations.push_back(get_dummy_location());
+
+    for (const auto algorithm : {EngineConfig::Algorithm::CH, EngineConfig::Algorithm::MLD})
+    {
+        EngineConfig config;
+        config.use_shared_memory = false;
+        config.algorithm = algorithm;
+        config.storage_config = {algorithm == EngineConfig::Algorithm::MLD
+                                     ? OSRM_TEST_DATA_DIR "/mld/monaco.osrm"
+                                     : OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+        OSRM osrm{config};
+
+        BOOST_CHECK_GT(checkAlternatives(osrm, locations), 0);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
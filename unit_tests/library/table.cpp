@@ -5,6 +5,7 @@
 #include "fixture.hpp"
 #include "waypoint_check.hpp"
 
+#include "osrm/route_parameters.hpp"
 #include "osrm/table_parameters.hpp"
 
 #include "osrm/coordinate.hpp"
@@ -13,6 +14,14 @@
 #include "osrm/osrm.hpp"
 #include "osrm/status.hpp"
 
+#include "util/json_renderer.hpp"
+
+#include <protozero/pbf_reader.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(table)
 
 BOOST_AUTO_TEST_CASE(test_table_three_coords_one_source_one_dest_matrix)
@@ -151,4 +160,240 @@ BOOST_AUTO_TEST_CASE(test_table_three_coordinates_matrix)
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_table_parallel_matches_serial)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {OSRM_TEST_DATA_DIR "/ch/monaco.osrm"};
+    config.use_shared_memory = false;
+
+    OSRM serial_osrm{config};
+    config.max_table_threads = 4;
+    OSRM parallel_osrm{config};
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+    for (const auto &location : get_locations_in_small_component())
+        params.coordinates.push_back(location);
+    params.coordinates.push_back(get_dummy_location());
+    params.sources = {0, 2, 3, 6};
+
+    json::Object serial_result;
+    json::Object parallel_result;
+    BOOST_CHECK(serial_osrm.Table(params, serial_result) == Status::Ok);
+    BOOST_CHECK(parallel_osrm.Table(params, parallel_result) == Status::Ok);
+
+    const auto &serial_durations = serial_result.values.at("durations").get<json::Array>().values;
+    const auto &parallel_durations =
+        parallel_result.values.at("durations").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(serial_durations.size(), params.sources.size());
+    BOOST_REQUIRE_EQUAL(parallel_durations.size(), params.sources.size());
+    for (std::size_t row = 0; row < serial_durations.size(); ++row)
+    {
+        const auto &serial_row = serial_durations[row].get<json::Array>().values;
+        const auto &parallel_row = parallel_durations[row].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(serial_row.size(), parallel_row.size());
+        for (std::size_t column = 0; column < serial_row.size(); ++column)
+        {
+            if (serial_row[column].is<json::Null>())
+            {
+                BOOST_CHECK(parallel_row[column].is<json::Null>());
+            }
+            else
+            {
+                BOOST_CHECK_EQUAL(serial_row[column].get<json::Number>().value,
+                                  parallel_row[column].get<json::Number>().value);
+            }
+        }
+    }
+}
+
+void test_table_distances(const std::string &path, const osrm::EngineConfig::Algorithm algorithm)
+{
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {path};
+    config.use_shared_memory = false;
+    config.algorithm = algorithm;
+    OSRM osrm{config};
+
+    TableParameters params;
+    for (const auto &location : get_locations_in_big_component())
+        params.coordinates.push_back(location);
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+    const auto rc = osrm.Table(params, result);
+    BOOST_REQUIRE(rc == Status::Ok);
+    BOOST_CHECK(result.values.find("durations") != result.values.end());
+
+    // every entry has to match the distance of the route between the same coordinates
+    const auto &distances = result.values.at("distances").get<json::Array>().values;
+    BOOST_REQUIRE_EQUAL(distances.size(), params.coordinates.size());
+    for (std::size_t row = 0; row < distances.size(); ++row)
+    {
+        const auto &distances_row = distances[row].get<json::Array>().values;
+        BOOST_REQUIRE_EQUAL(distances_row.size(), params.coordinates.size());
+        BOOST_CHECK_EQUAL(distances_row[row].get<json::Number>().value, 0);
+        for (std::size_t column = 0; column < distances_row.size(); ++column)
+        {
+            if (row == column)
+                continue;
+
+            RouteParameters route_params;
+            route_params.coordinates = {params.coordinates[row], params.coordinates[column]};
+            json::Object route_result;
+            BOOST_REQUIRE(osrm.Route(route_params, route_result) == Status::Ok);
+            const auto &route = route_result.values.at("routes")
+                                    .get<json::Array>()
+                                    .values.at(0)
+                                    .get<json::Object>();
+            BOOST_CHECK_CLOSE(distances_row[column].get<json::Number>().value,
+                              route.values.at("distance").get<json::Number>().value,
+                              1);
+        }
+    }
+
+    // only distances are returned if only distances are requested
+    params.annotations = TableParameters::AnnotationsType::Distance;
+    json::Object distance_result;
+    BOOST_REQUIRE(osrm.Table(params, distance_result) == Status::Ok);
+    BOOST_CHECK(distance_result.values.find("durations") == distance_result.values.end());
+    BOOST_CHECK(distance_result.values.find("distances") != distance_result.values.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_table_distances_ch)
+{
+    test_table_distances(OSRM_TEST_DATA_DIR "/ch/monaco.osrm", osrm::EngineConfig::Algorithm::CH);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_distances_mld)
+{
+    test_table_distances(OSRM_TEST_DATA_DIR "/mld/monaco.osrm", osrm::EngineConfig::Algorithm::MLD);
+}
+
+BOOST_AUTO_TEST_CASE(test_table_streamed_matches_object)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+    BOOST_CHECK(osrm.Table(params, result) == Status::Ok);
+
+    std::vector<char> streamed;
+    BOOST_CHECK(osrm.TableJSON(params, streamed) == Status::Ok);
+    const std::string streamed_string(streamed.begin(), streamed.end());
+
+    // member order differs between the outputs, so compare the rendered tables one by one
+    for (const auto member : {"code", "durations", "distances"})
+    {
+        json::Object single_member;
+        single_member.values[member] = result.values.at(member);
+        std::vector<char> rendered;
+        json::render(rendered, single_member);
+        const std::string rendered_member(rendered.begin() + 1, rendered.end() - 1);
+        BOOST_CHECK_MESSAGE(streamed_string.find(rendered_member) != std::string::npos,
+                            rendered_member << " not found in " << streamed_string);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_table_protobuf_matches_object)
+{
+    using namespace osrm;
+
+    auto osrm = getOSRM(OSRM_TEST_DATA_DIR "/ch/monaco.osrm");
+
+    TableParameters params;
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.coordinates.push_back(get_dummy_location());
+    params.sources.push_back(0);
+    params.annotations = TableParameters::AnnotationsType::All;
+
+    json::Object result;
+    BOOST_CHECK(osrm.Table(params, result) == Status::Ok);
+    const auto &json_durations = result.values.at("durations").get<json::Array>().values;
+    const auto &json_row = json_durations.at(0).get<json::Array>().values;
+
+    std::string buffer;
+    BOOST_CHECK(osrm.TableProtobuf(params, buffer) == Status::Ok);
+
+    std::string code;
+    std::size_t number_of_sources = 0, number_of_destinations = 0;
+    std::vector<std::int32_t> durations;
+    std::vector<float> distances;
+
+    protozero::pbf_reader response(buffer);
+    while (response.next())
+    {
+        switch (response.tag())
+        {
+        case 1:
+            code = response.get_string();
+            break;
+        case 5:
+            ++number_of_sources;
+            response.skip();
+            break;
+        case 6:
+            ++number_of_destinations;
+            response.skip();
+            break;
+        case 7:
+        {
+            protozero::pbf_reader table = response.get_message();
+            while (table.next())
+            {
+                switch (table.tag())
+                {
+                case 1:
+                    BOOST_CHECK_EQUAL(table.get_uint32(), 1);
+                    break;
+                case 2:
+                    BOOST_CHECK_EQUAL(table.get_uint32(), 3);
+                    break;
+                case 3:
+                {
+                    const auto range = table.get_packed_sfixed32();
+                    durations.assign(range.begin(), range.end());
+                    break;
+                }
+                case 4:
+                {
+                    const auto range = table.get_packed_float();
+                    distances.assign(range.begin(), range.end());
+                    break;
+                }
+                default:
+                    BOOST_CHECK(false);
+                }
+            }
+            break;
+        }
+        default:
+            BOOST_CHECK(false);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(code, "Ok");
+    BOOST_CHECK_EQUAL(number_of_sources, 1);
+    BOOST_CHECK_EQUAL(number_of_destinations, 3);
+    BOOST_CHECK_EQUAL(distances.size(), 3);
+    BOOST_REQUIRE_EQUAL(durations.size(), json_row.size());
+    for (std::size_t column = 0; column < durations.size(); ++column)
+    {
+        BOOST_CHECK_EQUAL(durations[column] / 10., json_row[column].get<json::Number>().value);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
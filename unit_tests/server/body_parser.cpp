@@ -0,0 +1,54 @@
+#include "server/api/body_parser.hpp"
+
+#include "engine/polyline_compressor.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(api_body_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+BOOST_AUTO_TEST_CASE(parse_packed_coordinates)
+{
+    // 7.416351,43.731205 and -0.5,-1 as little endian int32 in 1e-6 degrees
+    const std::string body("\x1F\x2A\x71\x00\x05\x49\x9B\x02"
+                           "\xE0\x5E\xF8\xFF\xC0\xBD\xF0\xFF",
+                           16);
+
+    const auto coordinates = api::parseCoordinates("application/octet-stream", body);
+    BOOST_REQUIRE(coordinates);
+    BOOST_REQUIRE_EQUAL(coordinates->size(), 2);
+    BOOST_CHECK_EQUAL(coordinates->at(0).lon, util::FixedLongitude{7416351});
+    BOOST_CHECK_EQUAL(coordinates->at(0).lat, util::FixedLatitude{43731205});
+    BOOST_CHECK_EQUAL(coordinates->at(1).lon, util::FixedLongitude{-500000});
+    BOOST_CHECK_EQUAL(coordinates->at(1).lat, util::FixedLatitude{-1000000});
+
+    BOOST_CHECK(!api::parseCoordinates("application/octet-stream", body.substr(0, 12)));
+    BOOST_CHECK(api::parseCoordinates("application/octet-stream", "")->empty());
+}
+
+BOOST_AUTO_TEST_CASE(parse_polyline_coordinates)
+{
+    const auto reference = engine::decodePolyline("_ibE?_seK_seK_seK_seK");
+
+    const auto coordinates = api::parseCoordinates("application/x-polyline; charset=utf-8",
+                                                   "_ibE?_seK_seK_seK_seK");
+    BOOST_REQUIRE(coordinates);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        coordinates->begin(), coordinates->end(), reference.begin(), reference.end());
+
+    BOOST_CHECK(!api::parseCoordinates("application/x-polyline", "_ibE 1,2"));
+}
+
+BOOST_AUTO_TEST_CASE(unsupported_content_type)
+{
+    BOOST_CHECK(!api::parseCoordinates("", "_ibE?"));
+    BOOST_CHECK(!api::parseCoordinates("application/json", "[[1,2]]"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
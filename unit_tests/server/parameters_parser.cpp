@@ -3,6 +3,7 @@
 #include "parameters_io.hpp"
 
 #include "engine/api/base_parameters.hpp"
+#include "engine/api/batch_route_parameters.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
@@ -82,6 +83,8 @@ BOOST_AUTO_TEST_CASE(invalid_table_urls)
         testInvalidOptions<TableParameters>("1,2;3,4?sources=1&destinations=1&bla=foo"), 32UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=foo"), 16UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?destinations=foo"), 21UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?annotations=foo"), 20UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?annotations=true"), 20UL);
 }
 
 BOOST_AUTO_TEST_CASE(valid_route_hint)
@@ -430,6 +433,16 @@ BOOST_AUTO_TEST_CASE(valid_table_urls)
     CHECK_EQUAL_RANGE(reference_1.bearings, result_3->bearings);
     CHECK_EQUAL_RANGE(reference_1.radiuses, result_3->radiuses);
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_3->coordinates);
+
+    BOOST_CHECK(result_1->annotations == TableParameters::AnnotationsType::Duration);
+
+    auto result_4 = parseParameters<TableParameters>("1,2;3,4?annotations=distance");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->annotations == TableParameters::AnnotationsType::Distance);
+
+    auto result_5 = parseParameters<TableParameters>("1,2;3,4?annotations=duration,distance");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->annotations == TableParameters::AnnotationsType::All);
 }
 
 BOOST_AUTO_TEST_CASE(valid_match_urls)
@@ -551,4 +564,133 @@ BOOST_AUTO_TEST_CASE(valid_trip_urls)
     BOOST_CHECK_EQUAL(param_fail_2, 33UL);
 }
 
+BOOST_AUTO_TEST_CASE(valid_format_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                                              {util::FloatLongitude{3}, util::FloatLatitude{4}}};
+
+    auto result_1 = parseParameters<RouteParameters>("1,2;3,4");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->format == BaseParameters::OutputFormatType::JSON);
+
+    auto result_2 = parseParameters<RouteParameters>("1,2;3,4.json?steps=true");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->format == BaseParameters::OutputFormatType::JSON);
+    BOOST_CHECK_EQUAL(result_2->steps, true);
+    CHECK_EQUAL_RANGE(coords_1, result_2->coordinates);
+
+    auto result_3 = parseParameters<RouteParameters>("1,2;3,4.pbf?overview=full");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(result_3->format == BaseParameters::OutputFormatType::PROTOBUF);
+    BOOST_CHECK(result_3->overview == RouteParameters::OverviewType::Full);
+    CHECK_EQUAL_RANGE(coords_1, result_3->coordinates);
+
+    auto result_4 = parseParameters<RouteParameters>("1.0,2.0;3.0,4.0.pbf");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->format == BaseParameters::OutputFormatType::PROTOBUF);
+    CHECK_EQUAL_RANGE(coords_1, result_4->coordinates);
+
+    auto result_5 = parseParameters<TableParameters>("1,2;3,4.pbf?annotations=distance");
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->format == BaseParameters::OutputFormatType::PROTOBUF);
+
+    auto result_6 = parseParameters<MatchParameters>("1,2;3,4.pbf");
+    BOOST_CHECK(result_6);
+    BOOST_CHECK(result_6->format == BaseParameters::OutputFormatType::PROTOBUF);
+
+    auto result_7 = parseParameters<NearestParameters>("1,2.pbf?number=3");
+    BOOST_CHECK(result_7);
+    BOOST_CHECK(result_7->format == BaseParameters::OutputFormatType::PROTOBUF);
+    BOOST_CHECK_EQUAL(result_7->number_of_results, 3);
+
+    auto result_8 = parseParameters<TripParameters>("1,2;3,4.pbf");
+    BOOST_CHECK(result_8);
+    BOOST_CHECK(result_8->format == BaseParameters::OutputFormatType::PROTOBUF);
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.xml"), 8);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.pbf.json"), 11);
+}
+
+BOOST_AUTO_TEST_CASE(valid_body_parameters)
+{
+    const std::vector<util::Coordinate> coords_1 = {
+        {util::FloatLongitude{1}, util::FloatLatitude{2}},
+        {util::FloatLongitude{3}, util::FloatLatitude{4}}};
+
+    const auto parse = [](std::string options, std::vector<util::Coordinate> coordinates) {
+        auto iter = options.begin();
+        auto result = parseParameters<TableParameters>(iter, options.end(), coordinates);
+        BOOST_CHECK(iter == options.end() || !result);
+        return result;
+    };
+
+    auto result_1 = parse("", coords_1);
+    BOOST_CHECK(result_1);
+    CHECK_EQUAL_RANGE(coords_1, result_1->coordinates);
+
+    auto result_2 = parse(".pbf?sources=0&annotations=distance", coords_1);
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->format == BaseParameters::OutputFormatType::PROTOBUF);
+    BOOST_CHECK(result_2->annotations == TableParameters::AnnotationsType::Distance);
+    const std::vector<std::size_t> sources_2 = {0};
+    CHECK_EQUAL_RANGE(sources_2, result_2->sources);
+    CHECK_EQUAL_RANGE(coords_1, result_2->coordinates);
+
+    std::string options_3 = "?timestamps=5;6&radiuses=1;2";
+    auto iter_3 = options_3.begin();
+    auto result_3 = parseParameters<MatchParameters>(iter_3, options_3.end(), coords_1);
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(result_3->IsValid());
+    const std::vector<unsigned> timestamps_3 = {5, 6};
+    CHECK_EQUAL_RANGE(timestamps_3, result_3->timestamps);
+    CHECK_EQUAL_RANGE(coords_1, result_3->coordinates);
+
+    // coordinates in the query are not allowed when they are sent in the body
+    BOOST_CHECK(!parse("1,2;3,4", coords_1));
+    BOOST_CHECK(!parse("?sources=foo", coords_1));
+}
+
+BOOST_AUTO_TEST_CASE(valid_batch_route_urls)
+{
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                                              {util::FloatLongitude{3}, util::FloatLatitude{4}},
+                                              {util::FloatLongitude{5}, util::FloatLatitude{6}},
+                                              {util::FloatLongitude{7}, util::FloatLatitude{8}}};
+
+    auto result_1 = parseParameters<BatchRouteParameters>("1,2;3,4;5,6;7,8");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->IsValid());
+    BOOST_CHECK(result_1->overview == RouteParameters::OverviewType::False);
+    CHECK_EQUAL_RANGE(coords_1, result_1->coordinates);
+
+    auto result_2 = parseParameters<BatchRouteParameters>(
+        "1,2;3,4;5,6;7,8.json?overview=full&geometries=geojson&radiuses=1;2;3;4");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->IsValid());
+    BOOST_CHECK(result_2->overview == RouteParameters::OverviewType::Full);
+    BOOST_CHECK(result_2->geometries == RouteParameters::GeometriesType::GeoJSON);
+    BOOST_CHECK_EQUAL(result_2->radiuses.size(), 4);
+
+    // an origin without a destination
+    auto result_3 = parseParameters<BatchRouteParameters>("1,2;3,4;5,6");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(!result_3->IsValid());
+
+    auto result_4 = parseParameters<BatchRouteParameters>("1,2;3,4?steps=true");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(!result_4->IsValid());
+
+    std::string options_5 = "?overview=simplified";
+    auto iter_5 = options_5.begin();
+    auto result_5 = parseParameters<BatchRouteParameters>(iter_5, options_5.end(), coords_1);
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->IsValid());
+    BOOST_CHECK(result_5->overview == RouteParameters::OverviewType::Simplified);
+    CHECK_EQUAL_RANGE(coords_1, result_5->coordinates);
+
+    // the summaries are only available as JSON, route specific options are rejected
+    BOOST_CHECK_EQUAL(testInvalidOptions<BatchRouteParameters>("1,2;3,4.pbf"), 7);
+    BOOST_CHECK_EQUAL(testInvalidOptions<BatchRouteParameters>("1,2;3,4?alternatives=true"), 8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,197 @@
+#include "server/request_parser.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <iterator>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+BOOST_AUTO_TEST_CASE(parse_version_and_connection)
+{
+    std::string data = "GET /route/v1/driving/1,2;3,4 HTTP/1.1\r\n"
+                       "Connection: keep-alive\r\n"
+                       "Accept-Encoding: gzip\r\n"
+                       "\r\n";
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+    std::tie(status, compression, parsed_end) =
+        parser.parse(request, &data[0], &data[0] + data.size());
+
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(compression, http::gzip_rfc1952);
+    BOOST_CHECK_EQUAL(std::distance(&data[0], parsed_end), data.size());
+    BOOST_CHECK_EQUAL(request.uri, "/route/v1/driving/1,2;3,4");
+    BOOST_CHECK_EQUAL(request.http_version_major, 1);
+    BOOST_CHECK_EQUAL(request.http_version_minor, 1);
+    BOOST_CHECK_EQUAL(request.connection, "keep-alive");
+}
+
+BOOST_AUTO_TEST_CASE(parse_pipelined_requests)
+{
+    const std::string first = "GET /nearest/v1/driving/1,2 HTTP/1.1\r\n\r\n";
+    const std::string second = "GET /nearest/v1/driving/3,4 HTTP/1.0\r\n"
+                               "Connection: close\r\n"
+                               "\r\n";
+    std::string data = first + second;
+    char *begin = &data[0];
+    char *end = &data[0] + data.size();
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+    std::tie(status, compression, parsed_end) = parser.parse(request, begin, end);
+
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(compression, http::no_compression);
+    BOOST_CHECK_EQUAL(std::distance(begin, parsed_end), first.size());
+    BOOST_CHECK_EQUAL(request.uri, "/nearest/v1/driving/1,2");
+    BOOST_CHECK(request.connection.empty());
+
+    parser.reset();
+    request = http::request();
+    std::tie(status, compression, parsed_end) = parser.parse(request, parsed_end, end);
+
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(std::distance(begin, parsed_end), data.size());
+    BOOST_CHECK_EQUAL(request.uri, "/nearest/v1/driving/3,4");
+    BOOST_CHECK_EQUAL(request.http_version_major, 1);
+    BOOST_CHECK_EQUAL(request.http_version_minor, 0);
+    BOOST_CHECK_EQUAL(request.connection, "close");
+}
+
+BOOST_AUTO_TEST_CASE(parse_incomplete_request)
+{
+    std::string data = "GET /nearest/v1/driving/1,2 HTTP/1.1\r\nHost: loc";
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+    std::tie(status, compression, parsed_end) =
+        parser.parse(request, &data[0], &data[0] + data.size());
+
+    BOOST_CHECK(status == RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK_EQUAL(std::distance(&data[0], parsed_end), data.size());
+}
+
+BOOST_AUTO_TEST_CASE(parse_post_body)
+{
+    const std::string body("\x01\x00\x00\x00\x02\x00\x00\x00", 8);
+    const std::string first = "POST /table/v1/driving/?sources=0 HTTP/1.1\r\n"
+                              "Content-Type: application/octet-stream\r\n"
+                              "Content-Length: 8\r\n"
+                              "\r\n" +
+                              body;
+    const std::string second = "GET /nearest/v1/driving/1,2 HTTP/1.1\r\n\r\n";
+    std::string data = first + second;
+    char *begin = &data[0];
+    char *end = &data[0] + data.size();
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+
+    // the body arrives in two reads
+    std::tie(status, compression, parsed_end) =
+        parser.parse(request, begin, begin + first.size() - 3);
+    BOOST_CHECK(status == RequestParser::RequestStatus::indeterminate);
+    std::tie(status, compression, parsed_end) = parser.parse(request, parsed_end, end);
+
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(std::distance(begin, parsed_end), first.size());
+    BOOST_CHECK_EQUAL(request.method, "POST");
+    BOOST_CHECK_EQUAL(request.uri, "/table/v1/driving/?sources=0");
+    BOOST_CHECK_EQUAL(request.content_type, "application/octet-stream");
+    BOOST_CHECK(request.body == body);
+
+    parser.reset();
+    request = http::request();
+    std::tie(status, compression, parsed_end) = parser.parse(request, parsed_end, end);
+
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(std::distance(begin, parsed_end), data.size());
+    BOOST_CHECK_EQUAL(request.method, "GET");
+    BOOST_CHECK(request.body.empty());
+}
+
+BOOST_AUTO_TEST_CASE(parse_expect_continue)
+{
+    const std::string body("\x01\x00\x00\x00\x02\x00\x00\x00", 8);
+    const std::string headers = "POST /table/v1/driving/ HTTP/1.1\r\n"
+                                "Content-Type: application/octet-stream\r\n"
+                                "Content-Length: 8\r\n"
+                                "Expect: 100-continue\r\n"
+                                "\r\n";
+    std::string data = headers + body;
+    char *begin = &data[0];
+    char *end = &data[0] + data.size();
+
+    RequestParser parser;
+    http::request request;
+    RequestParser::RequestStatus status;
+    http::compression_type compression;
+    char *parsed_end;
+
+    // parsing stops after the headers even if parts of the body arrived with them
+    std::tie(status, compression, parsed_end) =
+        parser.parse(request, begin, begin + headers.size() + 3);
+    BOOST_CHECK(status == RequestParser::RequestStatus::expect_continue);
+    BOOST_CHECK_EQUAL(std::distance(begin, parsed_end), headers.size());
+
+    std::tie(status, compression, parsed_end) = parser.parse(request, parsed_end, end);
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(std::distance(begin, parsed_end), data.size());
+    BOOST_CHECK(request.body == body);
+
+    // requests without a body and HTTP/1.0 requests don't wait for the interim response
+    for (std::string other : {std::string("GET /nearest/v1/driving/1,2 HTTP/1.1\r\n"
+                                          "Expect: 100-continue\r\n\r\n"),
+                              "POST /table/v1/driving/ HTTP/1.0\r\n"
+                              "Content-Length: 8\r\n"
+                              "Expect: 100-continue\r\n\r\n" +
+                                  body})
+    {
+        parser.reset();
+        request = http::request();
+        std::tie(status, compression, parsed_end) =
+            parser.parse(request, &other[0], &other[0] + other.size());
+        BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+        BOOST_CHECK_EQUAL(std::distance(&other[0], parsed_end), other.size());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(parse_invalid_post_body)
+{
+    const std::string request_line = "POST /table/v1/driving/ HTTP/1.1\r\n";
+    for (std::string data : {request_line + "Content-Length: abc\r\n\r\n",
+                             request_line + "Content-Length: 99999999999\r\n\r\n",
+                             request_line + "Transfer-Encoding: chunked\r\n\r\n"})
+    {
+        RequestParser parser;
+        http::request request;
+        RequestParser::RequestStatus status;
+        http::compression_type compression;
+        char *parsed_end;
+        std::tie(status, compression, parsed_end) =
+            parser.parse(request, &data[0], &data[0] + data.size());
+
+        BOOST_CHECK(status == RequestParser::RequestStatus::invalid);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
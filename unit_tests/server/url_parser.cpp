@@ -116,4 +116,24 @@ BOOST_AUTO_TEST_CASE(valid_urls)
     BOOST_CHECK_EQUAL(reference_7.prefix_length, result_7->prefix_length);
 }
 
+BOOST_AUTO_TEST_CASE(valid_body_urls)
+{
+    auto result_1 = api::parseURL("/table/v1/profile/", true);
+    BOOST_CHECK(result_1);
+    BOOST_CHECK_EQUAL(result_1->service, "table");
+    BOOST_CHECK_EQUAL(result_1->profile, "profile");
+    BOOST_CHECK(result_1->query.empty());
+    BOOST_CHECK_EQUAL(result_1->prefix_length, 18UL);
+
+    auto result_2 = api::parseURL("/match/v1/profile/.pbf?timestamps=1;2", true);
+    BOOST_CHECK(result_2);
+    BOOST_CHECK_EQUAL(result_2->service, "match");
+    BOOST_CHECK_EQUAL(result_2->query, ".pbf?timestamps=1;2");
+
+    auto url = std::string("/table/v1/profile");
+    auto iter = url.begin();
+    BOOST_CHECK(!api::parseURL(iter, url.end(), true));
+    BOOST_CHECK_EQUAL(std::distance(url.begin(), iter), 17);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,76 @@
+#include "server/http/reply.hpp"
+#include "server/worker_pool.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(worker_pool)
+
+using namespace osrm;
+using namespace osrm::server;
+
+BOOST_AUTO_TEST_CASE(inline_without_threads)
+{
+    WorkerPool pool(0, 1);
+    int calls = 0;
+    BOOST_CHECK(pool.Post([&] { ++calls; }));
+    BOOST_CHECK(pool.Post([&] { ++calls; }));
+    BOOST_CHECK_EQUAL(calls, 2);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_tasks_over_queue_size)
+{
+    WorkerPool pool(1, 1);
+    pool.Start();
+
+    std::promise<void> started, release, queued_done;
+    auto release_future = release.get_future().share();
+
+    // occupies the only worker until released
+    BOOST_CHECK(pool.Post([&started, release_future] {
+        started.set_value();
+        release_future.wait();
+    }));
+    started.get_future().wait();
+
+    // fills the queue
+    BOOST_CHECK(pool.Post([&queued_done] { queued_done.set_value(); }));
+    // overflows the queue, the connection answers this one with 503
+    std::atomic<bool> rejected_ran{false};
+    BOOST_CHECK(!pool.Post([&rejected_ran] { rejected_ran = true; }));
+
+    release.set_value();
+    queued_done.get_future().wait();
+
+    // the queue is drained again
+    std::promise<void> accepted_done;
+    BOOST_CHECK(pool.Post([&accepted_done] { accepted_done.set_value(); }));
+    accepted_done.get_future().wait();
+
+    pool.Stop();
+    pool.Join();
+    BOOST_CHECK(!rejected_ran);
+}
+
+BOOST_AUTO_TEST_CASE(service_unavailable_reply)
+{
+    auto reply = http::reply::stock_reply(http::reply::service_unavailable);
+    BOOST_CHECK_EQUAL(reply.status, http::reply::service_unavailable);
+
+    reply.set_uncompressed_size();
+    const auto buffers = reply.to_buffers();
+    BOOST_REQUIRE(!buffers.empty());
+    const std::string status_line(boost::asio::buffer_cast<const char *>(buffers.front()),
+                                  boost::asio::buffer_size(buffers.front()));
+    BOOST_CHECK_EQUAL(status_line, "HTTP/1.1 503 Service Unavailable\r\n");
+
+    const std::string content(reply.content.begin(), reply.content.end());
+    BOOST_CHECK(content.find("ServiceUnavailable") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
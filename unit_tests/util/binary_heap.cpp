@@ -25,7 +25,8 @@ typedef int TestKey;
 typedef int TestWeight;
 typedef boost::mpl::list<ArrayStorage<TestNodeID, TestKey>,
                          MapStorage<TestNodeID, TestKey>,
-                         UnorderedMapStorage<TestNodeID, TestKey>>
+                         UnorderedMapStorage<TestNodeID, TestKey>,
+                         GenerationArrayStorage<TestNodeID, TestKey>>
     storage_types;
 
 template <unsigned NUM_ELEM> struct RandomDataFixture
@@ -157,4 +158,27 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(decrease_key_test, T, storage_types, RandomData
     }
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(clear_test, T, storage_types, RandomDataFixture<NUM_NODES>)
+{
+    BinaryHeap<TestNodeID, TestKey, TestWeight, TestData, T> heap(NUM_NODES);
+
+    for (unsigned idx : order)
+    {
+        heap.Insert(ids[idx], weights[idx], data[idx]);
+    }
+
+    heap.Clear();
+    BOOST_CHECK(heap.Empty());
+
+    for (auto id : ids)
+    {
+        BOOST_CHECK(!heap.WasInserted(id));
+    }
+
+    heap.Insert(ids[order[0]], weights[order[0]], data[order[0]]);
+    BOOST_CHECK(heap.WasInserted(ids[order[0]]));
+    BOOST_CHECK_EQUAL(heap.GetKey(ids[order[0]]), weights[order[0]]);
+    BOOST_CHECK_EQUAL(heap.Min(), ids[order[0]]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
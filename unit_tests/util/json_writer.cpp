@@ -0,0 +1,157 @@
+#include "util/cast.hpp"
+#include "util/json_renderer.hpp"
+#include "util/json_writer.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(json_writer)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(number_formatting_matches_renderer)
+{
+    const std::vector<double> values = {0.,
+                                        1.,
+                                        -1.,
+                                        0.1,
+                                        -0.25,
+                                        12.3,
+                                        1234.5,
+                                        7.4187,
+                                        43.731724,
+                                        1e-7,
+                                        123456789.123,
+                                        2147483647.,
+                                        9876543210.,
+                                        1e16,
+                                        3.5e12};
+
+    for (const auto value : values)
+    {
+        std::vector<char> buffer;
+        json::detail::appendNumber(buffer, value);
+        BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                          cast::to_string_with_precision(value));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(number_formatting_edge_cases)
+{
+    const auto format = [](const double value) {
+        std::vector<char> buffer;
+        json::detail::appendNumber(buffer, value);
+        return std::string(buffer.begin(), buffer.end());
+    };
+
+    // exact ties in binary round to even like printf, 1/128 is 0.0078125
+    BOOST_CHECK_EQUAL(format(0.0078125), "0.007812");
+    BOOST_CHECK_EQUAL(format(0.0234375), "0.023438");
+    BOOST_CHECK_EQUAL(format(-1.0078125), "-1.007812");
+    // 2.5e-6 is stored slightly above its decimal value and 0.1234565 slightly below
+    BOOST_CHECK_EQUAL(format(2.5e-6), "0.000003");
+    BOOST_CHECK_EQUAL(format(0.0000035), "0.000003");
+    BOOST_CHECK_EQUAL(format(0.1234565), "0.123456");
+    BOOST_CHECK_EQUAL(format(0.9999995), "1");
+
+    // negative values print their sign even if they round to zero
+    BOOST_CHECK_EQUAL(format(-0.), "-0");
+    BOOST_CHECK_EQUAL(format(-4e-7), "-0");
+    BOOST_CHECK_EQUAL(format(-6e-7), "-0.000001");
+
+    BOOST_CHECK_EQUAL(format(999999999.9999995), "1000000000");
+    BOOST_CHECK_EQUAL(format(1e9), "1000000000");
+    BOOST_CHECK_EQUAL(format(-123456789012.25), "-123456789012.25");
+    BOOST_CHECK_EQUAL(format(1e15), "1000000000000000");
+    BOOST_CHECK_EQUAL(format(1e20), "100000000000000000000");
+
+    for (const auto value : {0.0078125, 0.1234565, 0.9999995, -0., -4e-7, 999999999.9999995, 1e20})
+    {
+        BOOST_CHECK_EQUAL(format(value), cast::to_string_with_precision(value));
+    }
+
+    // ties, values next to ties and all scales against the old renderer
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> unit(0., 1.);
+    for (int i = 0; i < 100000; ++i)
+    {
+        const double tie = std::floor(unit(generator) * 1e6) / 128.;
+        const double scale = std::pow(10., unit(generator) * 20. - 10.);
+        for (const auto value : {tie, std::nextafter(tie, 0.), (unit(generator) - 0.5) * scale})
+        {
+            BOOST_CHECK_EQUAL(format(value), cast::to_string_with_precision(value));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(write_nested_structures)
+{
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    writer.StartObject();
+    writer.Key("code");
+    writer.WriteString("Ok");
+    writer.Key("matrix");
+    writer.StartArray();
+    writer.StartArray();
+    writer.WriteNumber(0);
+    writer.WriteNumber(1.5);
+    writer.EndArray();
+    writer.StartArray();
+    writer.WriteNull();
+    writer.WriteBool(true);
+    writer.EndArray();
+    writer.EndArray();
+    writer.Key("empty");
+    writer.StartObject();
+    writer.EndObject();
+    writer.EndObject();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                      "{\"code\":\"Ok\",\"matrix\":[[0,1.5],[null,true]],\"empty\":{}}");
+}
+
+BOOST_AUTO_TEST_CASE(write_escaped_strings)
+{
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+
+    writer.StartArray();
+    writer.WriteString("Aleja \"Solidarnosci\"");
+    writer.WriteString("a/b\\c\n");
+    writer.EndArray();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                      "[\"Aleja \\\"Solidarnosci\\\"\",\"a\\/b\\\\c\\n\"]");
+}
+
+BOOST_AUTO_TEST_CASE(splice_dom_values)
+{
+    json::Array coordinates;
+    coordinates.values.push_back(7.41);
+    coordinates.values.push_back(43.73);
+    json::Object waypoint;
+    waypoint.values["location"] = coordinates;
+
+    std::vector<char> rendered;
+    json::render(rendered, waypoint);
+
+    std::vector<char> buffer;
+    json::Writer writer(buffer);
+    writer.StartArray();
+    writer.WriteValue(waypoint);
+    writer.WriteValue(json::Null());
+    writer.EndArray();
+
+    BOOST_CHECK_EQUAL(std::string(buffer.begin(), buffer.end()),
+                      "[" + std::string(rendered.begin(), rendered.end()) + ",null]");
+}
+
+BOOST_AUTO_TEST_SUITE_END()